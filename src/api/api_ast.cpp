@@ -19,6 +19,7 @@ Revision History:
 #include "api/api_log_macros.h"
 #include "api/api_context.h"
 #include "api/api_util.h"
+#include "api/api_stats.h"
 #include "ast/well_sorted.h"
 #include "ast/arith_decl_plugin.h"
 #include "ast/bv_decl_plugin.h"
@@ -38,6 +39,7 @@ Revision History:
 #include "util/cancel_eh.h"
 #include "util/scoped_timer.h"
 #include "ast/pp_params.hpp"
+#include "ast/rewriter/rewriter_params.hpp"
 
 extern bool is_numeral_sort(Z3_context c, Z3_sort ty);
 
@@ -676,7 +678,11 @@ extern "C" {
         params_ref p = to_param_ref(_p);
         unsigned timeout     = p.get_uint("timeout", mk_c(c)->get_timeout());
         bool     use_ctrl_c  = p.get_bool("ctrl_c", false);
-        th_rewriter m_rw(m, p);
+        rewriter_params rp(p);
+        scoped_ptr<th_rewriter> local_rw;
+        if (!rp.persistent_cache())
+            local_rw = alloc(th_rewriter, m, p);
+        th_rewriter & m_rw = local_rw.get() != 0 ? *local_rw : mk_c(c)->simplifier(p);
         expr_ref    result(m);
         cancel_eh<reslimit> eh(m.limit());
         api::context::set_interruptable si(*(mk_c(c)), eh);
@@ -687,10 +693,14 @@ extern "C" {
                 m_rw(a, result);
             }
             catch (z3_exception & ex) {
+                if (local_rw.get() == 0)
+                    mk_c(c)->flush_simplifier(rp.persistent_cache_max_size(), true);
                 mk_c(c)->handle_exception(ex);
                 return 0;
             }
         }
+        if (local_rw.get() == 0)
+            mk_c(c)->flush_simplifier(rp.persistent_cache_max_size(), false);
         mk_c(c)->save_ast_trail(result);
         return of_ast(result.get());
         Z3_CATCH_RETURN(0);
@@ -706,6 +716,18 @@ extern "C" {
         RETURN_Z3(simplify(c, _a, p));
     }
 
+    Z3_stats Z3_API Z3_simplify_get_statistics(Z3_context c) {
+        Z3_TRY;
+        LOG_Z3_simplify_get_statistics(c);
+        RESET_ERROR_CODE();
+        Z3_stats_ref * st = alloc(Z3_stats_ref, *mk_c(c));
+        mk_c(c)->collect_simplifier_statistics(st->m_stats);
+        mk_c(c)->save_object(st);
+        Z3_stats r = of_stats(st);
+        RETURN_Z3(r);
+        Z3_CATCH_RETURN(0);
+    }
+
     Z3_string Z3_API Z3_simplify_get_help(Z3_context c) {
         Z3_TRY;
         LOG_Z3_simplify_get_help(c);
@@ -19,6 +19,7 @@ Revision History:
 #define API_AST_VECTOR_H_
 
 #include "api/api_util.h"
+#include "model/model_eval_program.h"
 
 namespace api {
     class context;
@@ -26,6 +27,8 @@ namespace api {
 
 struct Z3_ast_vector_ref : public api::object {
     ast_ref_vector  m_ast_vector;
+    // program compiled by Z3_model_eval_vector for the contents of m_ast_vector.
+    scoped_ptr<model_eval_program> m_eval_program;
     Z3_ast_vector_ref(api::context& c, ast_manager & m): api::object(c), m_ast_vector(m) {}
     virtual ~Z3_ast_vector_ref() {}
 };
@@ -83,7 +83,10 @@ namespace api {
         m_sutil(m()),
         m_last_result(m()),
         m_ast_trail(m()),
-        m_pmanager(m_limit) {
+        m_pmanager(m_limit),
+        m_simplifier_hits(0),
+        m_simplifier_misses(0),
+        m_simplifier_flushes(0) {
 
         m_error_code = Z3_OK;
         m_print_mode = Z3_PRINT_SMTLIB_FULL;
@@ -348,6 +351,41 @@ namespace api {
         return *(m_rcf_manager.get());
     }
 
+    th_rewriter & context::simplifier(params_ref const & p) {
+        std::ostringstream strm;
+        p.display(strm);
+        if (m_simplifier.get() == 0 || m_simplifier_params != strm.str()) {
+            if (m_simplifier.get() != 0) {
+                m_simplifier_hits   += m_simplifier->get_num_cache_hits();
+                m_simplifier_misses += m_simplifier->get_num_cache_misses();
+                m_simplifier_flushes++;
+            }
+            m_simplifier = alloc(th_rewriter, m(), p);
+            m_simplifier_params = strm.str();
+        }
+        return *(m_simplifier.get());
+    }
+
+    void context::flush_simplifier(unsigned max_size, bool failed) {
+        if (m_simplifier.get() != 0 && (failed || m_simplifier->get_cache_size() > max_size)) {
+            m_simplifier->reset();
+            m_simplifier_flushes++;
+        }
+    }
+
+    void context::collect_simplifier_statistics(statistics & st) const {
+        unsigned hits   = m_simplifier_hits;
+        unsigned misses = m_simplifier_misses;
+        if (m_simplifier.get() != 0) {
+            hits   += m_simplifier->get_num_cache_hits();
+            misses += m_simplifier->get_num_cache_misses();
+            st.update("simplify cache size", m_simplifier->get_cache_size());
+        }
+        st.update("simplify cache hits", hits);
+        st.update("simplify cache misses", misses);
+        st.update("simplify cache flushes", m_simplifier_flushes);
+    }
+
 };
 
 
@@ -32,6 +32,7 @@ Revision History:
 #include "smt/smt_kernel.h"
 #include "smt/params/smt_params.h"
 #include "util/event_handler.h"
+#include "ast/rewriter/th_rewriter.h"
 #include "cmd_context/tactic_manager.h"
 #include "cmd_context/context_params.h"
 #include "api/api_polynomial.h"
@@ -211,6 +212,24 @@ namespace api {
     public:
         realclosure::manager & rcfm();
 
+        // ------------------------
+        //
+        // Persistent simplifier
+        //
+        // -----------------------
+    private:
+        scoped_ptr<th_rewriter>          m_simplifier;
+        std::string                      m_simplifier_params; // parameters m_simplifier was created with
+        unsigned                         m_simplifier_hits;   // cache hits of discarded simplifiers
+        unsigned                         m_simplifier_misses;
+        unsigned                         m_simplifier_flushes;
+    public:
+        // Return a simplifier for p whose cache is kept between calls with the same parameters.
+        th_rewriter & simplifier(params_ref const & p);
+        // Flush the cache of the simplifier if it exceeds max_size entries, or if the last call failed.
+        void flush_simplifier(unsigned max_size, bool failed);
+        void collect_simplifier_statistics(statistics & st) const;
+
         // ------------------------
         //
         // Solver interface for backward compatibility 
@@ -173,6 +173,46 @@ extern "C" {
         Z3_CATCH_RETURN(0);
     }
 
+    Z3_ast_vector Z3_API Z3_model_eval_vector(Z3_context c, Z3_model m, Z3_ast_vector es, Z3_bool model_completion) {
+        Z3_TRY;
+        LOG_Z3_model_eval_vector(c, m, es, model_completion);
+        RESET_ERROR_CODE();
+        CHECK_NON_NULL(m, 0);
+        CHECK_NON_NULL(es, 0);
+        Z3_ast_vector_ref * v = to_ast_vector(es);
+        ast_ref_vector const & asts = v->m_ast_vector;
+        unsigned sz = asts.size();
+        model_eval_program * p = v->m_eval_program.get();
+        // the program holds references to its expressions, so pointer equality
+        // tells whether it was compiled for the current contents of es.
+        bool compiled = p != 0 && p->size() == sz;
+        for (unsigned i = 0; compiled && i < sz; ++i) {
+            compiled = p->get_expr(i) == asts.get(i);
+        }
+        if (!compiled) {
+            ptr_buffer<expr> fmls;
+            for (unsigned i = 0; i < sz; ++i) {
+                if (!is_expr(asts.get(i))) {
+                    SET_ERROR_CODE(Z3_INVALID_ARG);
+                    RETURN_Z3(0);
+                }
+                fmls.push_back(to_expr(asts.get(i)));
+            }
+            v->m_eval_program = alloc(model_eval_program, mk_c(c)->m(), sz, fmls.c_ptr());
+            p = v->m_eval_program.get();
+        }
+        p->set_model_completion(model_completion == Z3_TRUE);
+        expr_ref_vector vals(mk_c(c)->m());
+        (*p)(*to_model_ref(m), vals);
+        Z3_ast_vector_ref * r = alloc(Z3_ast_vector_ref, *mk_c(c), mk_c(c)->m());
+        mk_c(c)->save_object(r);
+        for (expr * e : vals) {
+            r->m_ast_vector.push_back(e);
+        }
+        RETURN_Z3(of_ast_vector(r));
+        Z3_CATCH_RETURN(0);
+    }
+
     unsigned Z3_API Z3_model_get_num_sorts(Z3_context c, Z3_model m) {
         Z3_TRY;
         LOG_Z3_model_get_num_sorts(c, m);
@@ -25,6 +25,7 @@ Revision History:
 #include "api/api_model.h"
 #include "api/api_stats.h"
 #include "api/api_ast_vector.h"
+#include "ast/ast_util.h"
 #include "solver/tactic2solver.h"
 #include "util/scoped_ctrl_c.h"
 #include "util/cancel_eh.h"
@@ -485,4 +486,39 @@ extern "C" {
         Z3_CATCH_RETURN(Z3_L_UNDEF);        
     }
 
+    Z3_ast_vector Z3_API Z3_solver_cube(Z3_context c, Z3_solver s, unsigned depth) {
+        Z3_TRY;
+        LOG_Z3_solver_cube(c, s, depth);
+        ast_manager& m = mk_c(c)->m();
+        RESET_ERROR_CODE();
+        CHECK_SEARCHING(c);
+        init_solver(c, s);
+        vector<expr_ref_vector> cubes;
+        unsigned timeout     = to_solver(s)->m_params.get_uint("timeout", mk_c(c)->get_timeout());
+        unsigned rlimit      = to_solver(s)->m_params.get_uint("rlimit", mk_c(c)->get_rlimit());
+        bool     use_ctrl_c  = to_solver(s)->m_params.get_bool("ctrl_c", false);
+        cancel_eh<reslimit> eh(mk_c(c)->m().limit());
+        api::context::set_interruptable si(*(mk_c(c)), eh);
+        {
+            scoped_ctrl_c ctrlc(eh, false, use_ctrl_c);
+            scoped_timer timer(timeout, &eh);
+            scoped_rlimit _rlimit(mk_c(c)->m().limit(), rlimit);
+            try {
+                to_solver_ref(s)->cube(depth, cubes);
+            }
+            catch (z3_exception & ex) {
+                to_solver_ref(s)->set_reason_unknown(eh);
+                mk_c(c)->handle_exception(ex);
+                RETURN_Z3(0);
+            }
+        }
+        Z3_ast_vector_ref * v = alloc(Z3_ast_vector_ref, *mk_c(c), m);
+        mk_c(c)->save_object(v);
+        for (unsigned i = 0; i < cubes.size(); ++i) {
+            v->m_ast_vector.push_back(mk_and(cubes[i]));
+        }
+        RETURN_Z3(of_ast_vector(v));
+        Z3_CATCH_RETURN(0);
+    }
+
 };
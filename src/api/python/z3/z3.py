@@ -6278,7 +6278,19 @@ class Solver(Z3PPObject):
         sz = len(consequences)
         consequences = [ consequences[i] for i in range(sz) ]
         return CheckSatResult(r), consequences
-    
+
+    def cube(self, depth=4):
+        """Split the search space into at most 2^depth cubes. Every model of the assertions
+        satisfies one of the cubes. An empty result means the assertions are unsatisfiable.
+
+        >>> s = Solver()
+        >>> p, q = Bools('p q')
+        >>> s.add(Or(p, q), Not(p), Not(q))
+        >>> s.cube()
+        []
+        """
+        return [ c for c in AstVector(Z3_solver_cube(self.ctx.ref(), self.solver, depth), self.ctx) ]
+
     def proof(self):
         """Return a proof for the last `check()`. Proof construction must be enabled."""
         return _to_expr_ref(Z3_solver_get_proof(self.ctx.ref(), self.solver), self.ctx)
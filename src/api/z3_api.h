@@ -4617,6 +4617,18 @@ extern "C" {
     */
     Z3_ast Z3_API Z3_simplify_ex(Z3_context c, Z3_ast a, Z3_params p);
 
+    /**
+       \brief Return statistics of the persistent simplifier cache.
+
+       When the parameter \c rewriter.persistent_cache is set, #Z3_simplify and
+       #Z3_simplify_ex keep their cache between calls with the same parameters.
+       The statistics report the cache hits and misses, the size of the cache,
+       and how often it was flushed.
+
+       def_API('Z3_simplify_get_statistics', STATS, (_in(CONTEXT),))
+    */
+    Z3_stats Z3_API Z3_simplify_get_statistics(Z3_context c);
+
     /**
        \brief Return a string describing all available parameters.
 
@@ -4727,6 +4739,21 @@ extern "C" {
     */
     Z3_bool_opt Z3_API Z3_model_eval(Z3_context c, Z3_model m, Z3_ast t, Z3_bool model_completion, Z3_ast * v);
 
+    /**
+       \brief Evaluate the expressions in \c es in the given model and return their values.
+
+       The values coincide with the ones returned by #Z3_model_eval with the same
+       \c model_completion flag. The expressions are compiled into an evaluation program
+       the first time \c es is evaluated, and the program is kept with \c es until its
+       contents change. Evaluating the same vector in many models therefore avoids a
+       traversal of the expressions by the simplifier for each model.
+
+       \sa Z3_model_eval
+
+       def_API('Z3_model_eval_vector', AST_VECTOR, (_in(CONTEXT), _in(MODEL), _in(AST_VECTOR), _in(BOOL)))
+    */
+    Z3_ast_vector Z3_API Z3_model_eval_vector(Z3_context c, Z3_model m, Z3_ast_vector es, Z3_bool model_completion);
+
     /**
        \brief Return the interpretation (i.e., assignment) of constant \c a in the model \c m.
        Return \c NULL, if the model does not assign an interpretation for \c a.
@@ -6147,6 +6174,22 @@ extern "C" {
                                                Z3_ast_vector assumptions,
                                                Z3_ast_vector variables,
                                                Z3_ast_vector consequences);
+
+    /**
+       \brief Split the search space of the assertions in \c s into at most 2^depth cubes by lookahead.
+
+       Each cube is a conjunction of literals over atoms of the assertions, and every model of the
+       assertions satisfies one of the cubes. The assertions are unsatisfiable if and only if they
+       are unsatisfiable together with each of the cubes, so the cubes can be solved independently,
+       for instance by other processes that assert the same formulas, where a cube is asserted in a
+       new scope or tracked by a Boolean constant that is passed to #Z3_solver_check_assumptions.
+       An empty result means that the assertions were found unsatisfiable. Solvers that do not support
+       lookahead return the single cube \c true.
+
+       def_API('Z3_solver_cube', AST_VECTOR, (_in(CONTEXT), _in(SOLVER), _in(UINT)))
+    */
+    Z3_ast_vector Z3_API Z3_solver_cube(Z3_context c, Z3_solver s, unsigned depth);
+
     /**
        \brief Retrieve the model for the last #Z3_solver_check or #Z3_solver_check_assumptions
 
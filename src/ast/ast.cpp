@@ -26,6 +26,7 @@ Revision History:
 #include "util/string_buffer.h"
 #include "ast/ast_util.h"
 #include "ast/ast_smt2_pp.h"
+#include "ast/ast_translation.h"
 
 // -----------------------------------
 //
@@ -1409,6 +1410,7 @@ static void mark_array_ref(ast_mark& mark, unsigned sz, parameter const * a) {
 ast_manager::~ast_manager() {
     SASSERT(is_format_manager() || !m_family_manager.has_family(symbol("format")));
 
+    decl_translation_cache::finalize(*this);
     dec_ref(m_bool_sort);
     dec_ref(m_proof_sort);
     dec_ref(m_true);
@@ -1383,8 +1383,11 @@ enum proof_gen_mode {
 //
 // -----------------------------------
 
+class decl_translation_cache;
+
 class ast_manager {
     friend class basic_decl_plugin;
+    friend class decl_translation_cache;
 protected:
     struct config {
         typedef ast_manager              value_manager;
@@ -1460,6 +1463,7 @@ protected:
 #endif
     ast_manager *             m_format_manager; // hack for isolating format objects in a different manager.
     symbol                    m_rec_fun;
+    ptr_vector<decl_translation_cache> m_decl_translation_caches; // declaration caches shared with other managers, see ast_translation.h
 
     void init();
 
@@ -1572,6 +1576,9 @@ public:
 
     unsigned get_num_asts() const { return m_ast_table.size(); }
 
+    // Make room for num new AST nodes in the hash-consing table.
+    void reserve_asts(unsigned num) { m_ast_table.reserve(m_ast_table.size() + num); }
+
     void debug_ref_count() { m_debug_ref_count = true; }
 
     void inc_ref(ast * n) {
@@ -23,6 +23,62 @@ Revision History:
 #include "ast/format.h"
 #include "ast/ast_translation.h"
 #include "ast/ast_ll_pp.h"
+#include<algorithm>
+
+decl_translation_cache::~decl_translation_cache() {
+    obj_map<ast, ast*>::iterator it  = m_map.begin();
+    obj_map<ast, ast*>::iterator end = m_map.end();
+    for (; it != end; ++it) {
+        m_from.dec_ref(it->m_key);
+        m_to.dec_ref(it->m_value);
+    }
+}
+
+void decl_translation_cache::insert(ast * s, ast * t) {
+    SASSERT(is_decl(s) && !m_map.contains(s));
+    m_map.insert(s, t);
+    m_from.inc_ref(s);
+    m_to.inc_ref(t);
+}
+
+decl_translation_cache * decl_translation_cache::get(ast_manager & from, ast_manager & to) {
+    SASSERT(&from != &to);
+    decl_translation_cache * r = 0;
+    #pragma omp critical (decl_translation_cache)
+    {
+        ptr_vector<decl_translation_cache> const & caches = from.m_decl_translation_caches;
+        for (unsigned i = 0; r == 0 && i < caches.size(); ++i) {
+            if (&caches[i]->m_from == &from && &caches[i]->m_to == &to)
+                r = caches[i];
+        }
+        if (r == 0) {
+            r = alloc(decl_translation_cache, from, to);
+            from.m_decl_translation_caches.push_back(r);
+            to.m_decl_translation_caches.push_back(r);
+        }
+    }
+    return r;
+}
+
+/**
+   \brief Release the caches shared by m with other managers.
+   It is invoked by the destructor of m.
+*/
+void decl_translation_cache::finalize(ast_manager & m) {
+    ptr_vector<decl_translation_cache> caches;
+    #pragma omp critical (decl_translation_cache)
+    {
+        caches.swap(m.m_decl_translation_caches);
+        for (unsigned i = 0; i < caches.size(); ++i) {
+            decl_translation_cache * c = caches[i];
+            ast_manager & other = &c->m_from == &m ? c->m_to : c->m_from;
+            other.m_decl_translation_caches.erase(c);
+        }
+    }
+    for (unsigned i = 0; i < caches.size(); ++i) {
+        dealloc(caches[i]);
+    }
+}
 
 ast_translation::~ast_translation() {
     reset_cache();
@@ -34,6 +90,12 @@ void ast_translation::cleanup() {
     m_result_stack.finalize();
     m_frame_stack.finalize();
     m_extra_children_stack.finalize();
+    bulk_reset();
+    m_bulk_result.finalize();
+    m_bulk_nodes.finalize();
+    m_bulk_apps.finalize();
+    m_bulk_todo.finalize();
+    m_bulk_visited.reset();
 }
 
 void ast_translation::reset_cache() {
@@ -47,6 +109,10 @@ void ast_translation::reset_cache() {
 }
 
 void ast_translation::cache(ast * s, ast * t) {
+    if (m_decl_cache && is_decl(s)) {
+        m_decl_cache->insert(s, t);
+        return;
+    }
     SASSERT(!m_cache.contains(s));
     if (s->get_ref_count() > 1) {
         m_cache.insert(s, t);
@@ -55,6 +121,12 @@ void ast_translation::cache(ast * s, ast * t) {
     }
 }
 
+bool ast_translation::find_cached(ast * n, ast * & r) const {
+    if (m_decl_cache && is_decl(n))
+        return m_decl_cache->find(n, r);
+    return n->get_ref_count() > 1 && m_cache.find(n, r);
+}
+
 void ast_translation::collect_decl_extra_children(decl * d) {
     unsigned num_params = d->get_num_parameters();
     for (unsigned i = 0; i < num_params; i++) {
@@ -78,7 +150,7 @@ void ast_translation::push_frame(ast * n) {
 
 bool ast_translation::visit(ast * n) {        
     ast * r;
-    if (n->get_ref_count() > 1 && m_cache.find(n, r)) {
+    if (find_cached(n, r)) {
         m_result_stack.push_back(r);
         return true;
     }
@@ -196,7 +268,7 @@ ast * ast_translation::process(ast const * _n) {
             ast * n = fr.m_n;
             ast * r;         
             TRACE("ast_translation", tout << mk_ll_pp(n, m_from_manager, false) << "\n";);
-            if (fr.m_idx == 0 && n->get_ref_count() > 1 && m_cache.find(n, r)) {
+            if (fr.m_idx == 0 && find_cached(n, r)) {
                 SASSERT(m_result_stack.size() == fr.m_rpos);
                 m_result_stack.push_back(r);
                 m_extra_children_stack.shrink(fr.m_cpos);
@@ -321,6 +393,108 @@ ast * ast_translation::process(ast const * _n) {
     return r;
 }
 
+/**
+   \brief Add the subterms of e that are not translated yet to m_bulk_nodes.
+   Applications are left for bulk_mk_app; variables, quantifiers and
+   cached terms are translated right away.
+   id_ordered is set to false if an argument has a larger id than its parent.
+*/
+void ast_translation::bulk_collect(expr * e, bool & id_ordered) {
+    m_bulk_todo.push_back(e);
+    while (!m_bulk_todo.empty()) {
+        expr * n = m_bulk_todo.back();
+        m_bulk_todo.pop_back();
+        if (m_bulk_visited.is_marked(n))
+            continue;
+        m_bulk_visited.mark(n, true);
+        m_bulk_nodes.push_back(n);
+        m_bulk_result.reserve(n->get_id() + 1, 0);
+        ast * r;
+        if (is_app(n) && !find_cached(n, r)) {
+            m_bulk_apps.push_back(to_app(n));
+            unsigned num = to_app(n)->get_num_args();
+            for (unsigned i = 0; i < num; i++) {
+                expr * arg = to_app(n)->get_arg(i);
+                if (arg->get_id() > n->get_id())
+                    id_ordered = false;
+                m_bulk_todo.push_back(arg);
+            }
+        }
+        else {
+            m_bulk_result[n->get_id()] = process(n);
+        }
+    }
+}
+
+void ast_translation::bulk_mk_app(app * n) {
+    SASSERT(m_bulk_result[n->get_id()] == 0);
+    func_decl * new_f = to_func_decl(process(n->get_decl()));
+    unsigned num = n->get_num_args();
+    ptr_buffer<expr, 16> new_args;
+    for (unsigned i = 0; i < num; i++) {
+        SASSERT(bulk_get(n->get_arg(i)) != 0);
+        new_args.push_back(bulk_get(n->get_arg(i)));
+    }
+    app * new_app = m_to_manager.mk_app(new_f, num, new_args.c_ptr());
+    m_bulk_result[n->get_id()] = new_app;
+    cache(n, new_app);
+}
+
+void ast_translation::bulk_reset() {
+    for (unsigned i = 0; i < m_bulk_nodes.size(); i++) {
+        m_bulk_result[m_bulk_nodes[i]->get_id()] = 0;
+    }
+    m_bulk_nodes.reset();
+    m_bulk_apps.reset();
+    m_bulk_todo.reset();
+    m_bulk_visited.reset();
+}
+
+void ast_translation::operator()(unsigned num, expr * const * src, expr_ref_vector & dst) {
+    SASSERT(&dst.get_manager() == &m_to_manager);
+    bulk_reset();
+    bool id_ordered = true;
+    for (unsigned i = 0; i < num; i++) {
+        bulk_collect(src[i], id_ordered);
+    }
+    m_to_manager.reserve_asts(m_bulk_apps.size());
+    if (id_ordered) {
+        // the arguments of every application precede it.
+        std::sort(m_bulk_apps.begin(), m_bulk_apps.end(), ast_lt_proc());
+        for (unsigned i = 0; i < m_bulk_apps.size(); i++) {
+            bulk_mk_app(m_bulk_apps[i]);
+        }
+    }
+    else {
+        // ids of deleted nodes are recycled, so a parent may have a smaller id
+        // than one of its arguments. Build the applications in post-order instead.
+        for (unsigned i = 0; i < m_bulk_apps.size(); i++) {
+            m_bulk_todo.push_back(m_bulk_apps[i]);
+            while (!m_bulk_todo.empty()) {
+                app * n = to_app(m_bulk_todo.back());
+                if (bulk_get(n) != 0) {
+                    m_bulk_todo.pop_back();
+                    continue;
+                }
+                unsigned sz = m_bulk_todo.size();
+                unsigned num_args = n->get_num_args();
+                for (unsigned j = 0; j < num_args; j++) {
+                    if (bulk_get(n->get_arg(j)) == 0)
+                        m_bulk_todo.push_back(n->get_arg(j));
+                }
+                if (sz == m_bulk_todo.size()) {
+                    bulk_mk_app(n);
+                    m_bulk_todo.pop_back();
+                }
+            }
+        }
+    }
+    for (unsigned i = 0; i < num; i++) {
+        dst.push_back(bulk_get(src[i]));
+    }
+    bulk_reset();
+}
+
 expr_dependency * expr_dependency_translation::operator()(expr_dependency * d) {
     if (d == 0)
         return d;
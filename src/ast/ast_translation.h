@@ -23,6 +23,30 @@ Revision History:
 
 #include "ast/ast.h"
 
+/**
+   \brief Translated sorts and function declarations between a pair of managers.
+
+   The cache is shared by all translations from one manager to another, so
+   repeated translations between the same managers do not rebuild the
+   declarations. It is registered in both managers and released when the
+   first of them is destroyed.
+*/
+class decl_translation_cache {
+    ast_manager &      m_from;
+    ast_manager &      m_to;
+    obj_map<ast, ast*> m_map;
+
+    decl_translation_cache(ast_manager & from, ast_manager & to):m_from(from), m_to(to) {}
+public:
+    ~decl_translation_cache();
+    static decl_translation_cache * get(ast_manager & from, ast_manager & to);
+    static void finalize(ast_manager & m);
+
+    bool find(ast * s, ast * & t) const { return m_map.find(s, t); }
+    void insert(ast * s, ast * t);
+    unsigned size() const { return m_map.size(); }
+};
+
 class ast_translation {
     struct frame {
         ast *    m_n;
@@ -37,8 +61,15 @@ class ast_translation {
     ptr_vector<ast>     m_extra_children_stack; // for sort and func_decl, since they have nested AST in their parameters
     ptr_vector<ast>     m_result_stack; 
     obj_map<ast, ast*>  m_cache;
+    decl_translation_cache * m_decl_cache;
+    ptr_vector<ast>     m_bulk_result;  // translations indexed by source id, used by the bulk translation.
+    ptr_vector<expr>    m_bulk_nodes;
+    ptr_vector<app>     m_bulk_apps;
+    ptr_vector<expr>    m_bulk_todo;
+    expr_mark           m_bulk_visited;
 
     void cache(ast * s, ast * t);
+    bool find_cached(ast * n, ast * & r) const;
     void collect_decl_extra_children(decl * d);
     void push_frame(ast * n);
     bool visit(ast * n);
@@ -48,10 +79,17 @@ class ast_translation {
     
     ast * process(ast const * n);
 
+    void bulk_collect(expr * e, bool & id_ordered);
+    void bulk_mk_app(app * n);
+    expr * bulk_get(expr * n) const { return static_cast<expr*>(m_bulk_result[n->get_id()]); }
+    void bulk_reset();
+
 public:
-    ast_translation(ast_manager & from, ast_manager & to, bool copy_plugins = true) : m_from_manager(from), m_to_manager(to) {
+    ast_translation(ast_manager & from, ast_manager & to, bool copy_plugins = true) : m_from_manager(from), m_to_manager(to), m_decl_cache(0) {
         if (copy_plugins)
             m_to_manager.copy_families_plugins(m_from_manager);
+        if (&from != &to)
+            m_decl_cache = decl_translation_cache::get(from, to);
     }
 
     ~ast_translation();
@@ -64,6 +102,14 @@ public:
         return static_cast<T*>(r);
     }
 
+    /**
+       \brief Translate the expressions src[0], ..., src[num-1] and append the results to dst.
+
+       The shared subterms are translated once, bottom up in the order of their ids,
+       after reserving room for them in the target manager.
+    */
+    void operator()(unsigned num, expr * const * src, expr_ref_vector & dst);
+
     ast_manager & from() const { return m_from_manager; }
     ast_manager & to() const { return m_to_manager; }
 
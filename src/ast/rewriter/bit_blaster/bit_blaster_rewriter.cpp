@@ -133,6 +133,10 @@ struct blaster_rewriter_cfg : public default_rewriter_cfg {
         m_blast_full     = p.get_bool("blast_full", false);
         m_blast_quant    = p.get_bool("blast_quant", false);
         m_blaster.set_max_memory(m_max_memory);
+        symbol mul_encoding = p.get_sym("blast_mul_encoding", symbol("array"));
+        m_blaster.set_use_wtm(mul_encoding == symbol("wallace"));
+        m_blaster.set_use_dtm(mul_encoding == symbol("dadda"));
+        m_blaster.set_use_bcm(p.get_bool("blast_mul_const", false));
     }
 
     bool rewrite_patterns() const { return true; }
@@ -37,6 +37,7 @@ protected:
 
     unsigned long long m_max_memory;
     bool               m_use_wtm; /* Wallace Tree Multiplier */
+    bool               m_use_dtm; /* Dadda Tree Multiplier */
     bool               m_use_bcm; /* Booth Multiplier for constants */
     void checkpoint();
 
@@ -45,6 +46,7 @@ public:
         Cfg(cfg),
         m_max_memory(max_memory),
         m_use_wtm(use_wtm),
+        m_use_dtm(false),
         m_use_bcm(use_bcm) {
     }
 
@@ -52,6 +54,10 @@ public:
         m_max_memory = max_memory;
     }
 
+    void set_use_wtm(bool f) { m_use_wtm = f; }
+    void set_use_dtm(bool f) { m_use_dtm = f; }
+    void set_use_bcm(bool f) { m_use_bcm = f; }
+
     
     // Cfg required API
     ast_manager & m() const { return Cfg::m(); }
@@ -121,6 +127,7 @@ public:
     void mk_comp(unsigned sz, expr * const * a_bits, expr * const * b_bits, expr_ref_vector & out_bits);
 
     void mk_carry_save_adder(unsigned sz, expr * const * a_bits, expr * const * b_bits, expr * const * c_bits, expr_ref_vector & sum_bits, expr_ref_vector & carry_bits);
+    void mk_column_adder(unsigned sz, vector<expr_ref_vector> & columns, expr_ref_vector & out_bits);
     bool mk_const_multiplier(unsigned sz, expr * const * a_bits, expr * const * b_bits, expr_ref_vector & out_bits);
     bool mk_const_case_multiplier(unsigned sz, expr * const * a_bits, expr * const * b_bits, expr_ref_vector & out_bits);
     void mk_const_case_multiplier(bool is_a, unsigned i, unsigned sz, ptr_buffer<expr, 128>& a_bits, ptr_buffer<expr, 128>& b_bits, expr_ref_vector & out_bits);
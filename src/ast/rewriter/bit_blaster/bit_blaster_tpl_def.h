@@ -184,7 +184,23 @@ void bit_blaster_tpl<Cfg>::mk_multiplier(unsigned sz, expr * const * a_bits, exp
         return;
     }
     out_bits.reset();
-    if (!m_use_wtm) {
+    if (m_use_dtm) {
+        // DADDA TREE MULTIPLIER
+        // The partial products a[j]&b[i] are placed in the column of weight i+j.
+        vector<expr_ref_vector> columns;
+        columns.resize(sz, m());
+        expr_ref t(m());
+        for (unsigned i = 0; i < sz; i++) {
+            checkpoint();
+            for (unsigned j = 0; i + j < sz; j++) {
+                mk_and(a_bits[j], b_bits[i], t);
+                if (!m().is_false(t))
+                    columns[i + j].push_back(t);
+            }
+        }
+        mk_column_adder(sz, columns, out_bits);
+    }
+    else if (!m_use_wtm) {
 #if 0
     static unsigned counter = 0;
     counter++;
@@ -1177,6 +1193,77 @@ void bit_blaster_tpl<Cfg>::mk_carry_save_adder(unsigned sz, expr * const * a_bit
     }
 }
 
+/**
+   \brief Sum the bits of \c columns, where columns[i] contains bits of weight 2^i, modulo 2^sz.
+   The columns are reduced with full and half adders following Dadda's scheme: in every stage
+   no column is left with more bits than the next height of the sequence 2, 3, 4, 6, 9, ...
+   The remaining two rows are added with a ripple carry adder.
+*/
+template<typename Cfg>
+void bit_blaster_tpl<Cfg>::mk_column_adder(unsigned sz, vector<expr_ref_vector> & columns, expr_ref_vector & out_bits) {
+    SASSERT(columns.size() == sz);
+    unsigned max_height = 0;
+    for (unsigned i = 0; i < sz; i++)
+        max_height = std::max(max_height, columns[i].size());
+    unsigned_vector heights;
+    for (unsigned d = 2; d < max_height; d = (3 * d) / 2)
+        heights.push_back(d);
+
+    expr_ref s(m()), c(m());
+    while (!heights.empty()) {
+        checkpoint();
+        unsigned d = heights.back();
+        heights.pop_back();
+        // the carries of column i are added to column i+1 before it is reduced.
+        for (unsigned i = 0; i < sz; i++) {
+            expr_ref_vector & col = columns[i];
+            unsigned start = 0;
+            expr_ref_vector rest(m());
+            unsigned height = col.size();
+            while (height > d) {
+                if (i + 1 == sz) {
+                    // carries out of the most significant column are dropped.
+                    if (height == d + 1) {
+                        mk_xor(col.get(start), col.get(start + 1), s);
+                        start += 2;
+                        height -= 1;
+                    }
+                    else {
+                        mk_xor3(col.get(start), col.get(start + 1), col.get(start + 2), s);
+                        start += 3;
+                        height -= 2;
+                    }
+                    rest.push_back(s);
+                    continue;
+                }
+                if (height == d + 1) {
+                    mk_half_adder(col.get(start), col.get(start + 1), s, c);
+                    start += 2;
+                    height -= 1;
+                }
+                else {
+                    mk_full_adder(col.get(start), col.get(start + 1), col.get(start + 2), s, c);
+                    start += 3;
+                    height -= 2;
+                }
+                rest.push_back(s);
+                columns[i + 1].push_back(c);
+            }
+            for (unsigned j = start; j < col.size(); j++)
+                rest.push_back(col.get(j));
+            col.swap(rest);
+        }
+    }
+
+    expr_ref_vector row1(m()), row2(m());
+    for (unsigned i = 0; i < sz; i++) {
+        SASSERT(columns[i].size() <= 2);
+        row1.push_back(columns[i].empty() ? m().mk_false() : columns[i].get(0));
+        row2.push_back(columns[i].size() < 2 ? m().mk_false() : columns[i].get(1));
+    }
+    mk_adder(sz, row1.c_ptr(), row2.c_ptr(), out_bits);
+}
+
 template<typename Cfg>
 bool bit_blaster_tpl<Cfg>::mk_const_case_multiplier(unsigned sz, expr * const * a_bits, expr * const * b_bits, expr_ref_vector & out_bits) {
     unsigned case_size = 1;
@@ -1248,32 +1335,43 @@ bool bit_blaster_tpl<Cfg>::mk_const_multiplier(unsigned sz, expr * const * a_bit
     if (!m_use_bcm) {
         return false;
     }
+#if 1
+    // Canonical signed digit recoding: a = sum d_i*2^i with d_i in {-1, 0, 1} and no two
+    // adjacent non-zero digits. A digit d_i = 1 contributes b << i, and d_i = -1 contributes
+    // (~b << i) + (1 << i). The shifted operands and the accumulated constant are summed
+    // column-wise (see mk_column_adder), instead of with one ripple carry adder per digit.
+    expr_ref_vector not_b_bits(m()), tmp(m());
+    mk_not(sz, b_bits, not_b_bits);
+    vector<expr_ref_vector> columns;
+    columns.resize(sz, m());
+    numeral n = n_a, correction(0), two(2), four(4);
+    for (unsigned i = 0; i < sz && n.is_pos(); i++) {
+        if (!n.is_even()) {
+            bool neg = mod(n, four) == numeral(3);
+            for (unsigned j = 0; i + j < sz; j++)
+                columns[i + j].push_back(neg ? not_b_bits.get(j) : b_bits[j]);
+            if (neg) {
+                correction += power(i);
+                n += numeral(1);
+            }
+            else {
+                n -= numeral(1);
+            }
+        }
+        n = div(n, two);
+    }
+    num2bits(mod(correction, power(sz)), sz, tmp);
+    for (unsigned i = 0; i < sz; i++) {
+        if (m().is_true(tmp.get(i)))
+            columns[i].push_back(tmp.get(i));
+    }
+    mk_column_adder(sz, columns, out_bits);
+#else
     expr_ref_vector minus_b_bits(m()), tmp(m());
     mk_neg(sz, b_bits, minus_b_bits);
         
     out_bits.resize(sz, m().mk_false());
     
-#if 1
-    bool last = false, now;
-    for (unsigned i = 0; i < sz; i++) {
-        now = m().is_true(a_bits[i]);
-        SASSERT(now || m().is_false(a_bits[i]));
-        tmp.reset();
-
-        if (now && !last) {            
-            mk_adder(sz - i, out_bits.c_ptr() + i, minus_b_bits.c_ptr(), tmp);
-            for (unsigned j = 0; j < (sz - i); j++)
-                out_bits.set(i+j, tmp.get(j)); // do not use [], it does not work on Linux.
-        }
-        else if (!now && last) {
-            mk_adder(sz - i, out_bits.c_ptr() + i, b_bits, tmp);
-            for (unsigned j = 0; j < (sz - i); j++)
-                out_bits.set(i+j, tmp.get(j)); // do not use [], it does not work on Linux.
-        }
-        
-        last = now; 
-    }
-#else
     // Radix 4 Booth encoder
     // B = b_bits, -B = minus_b_bits
     // 2B = b2_bits, -2B = minus_b2_bits
@@ -176,7 +176,9 @@ rewriter_core::rewriter_core(ast_manager & m, bool proof_gen):
     m_cancel_check(true),
     m_result_stack(m),
     m_result_pr_stack(m),
-    m_num_qvars(0) {
+    m_num_qvars(0),
+    m_num_cache_hits(0),
+    m_num_cache_misses(0) {
     init_cache_stack();
 }
 
@@ -69,6 +69,8 @@ protected:
         scope(expr * r, unsigned n):m_old_root(r), m_old_num_qvars(n) {}
     };
     svector<scope>             m_scopes;
+    unsigned                   m_num_cache_hits;   // cache lookups of shared expressions that succeeded.
+    unsigned                   m_num_cache_misses; // cache lookups of shared expressions that failed.
 
     // Return true if the rewriting result of the given expression must be cached.
     bool must_cache(expr * t) const {
@@ -120,6 +122,8 @@ public:
     void display_stack(std::ostream & out, unsigned pp_depth);
 #endif
     unsigned get_cache_size() const;
+    unsigned get_num_cache_hits() const { return m_num_cache_hits; }
+    unsigned get_num_cache_misses() const { return m_num_cache_misses; }
 };
 
 class var_shifter_core : public rewriter_core {
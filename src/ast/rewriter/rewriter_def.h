@@ -132,6 +132,7 @@ bool rewriter_tpl<Config>::visit(expr * t, unsigned max_depth) {
 #endif
         expr * r = get_cached(t);
         if (r) {
+            m_num_cache_hits++;
             SASSERT(m().get_sort(r) == m().get_sort(t));
             result_stack().push_back(r);
             set_new_child_flag(t, r);
@@ -141,6 +142,7 @@ bool rewriter_tpl<Config>::visit(expr * t, unsigned max_depth) {
             }
             return true;
         }
+        m_num_cache_misses++;
     }
     if (!pre_visit(t)) {
         result_stack().push_back(t);
@@ -756,6 +756,14 @@ unsigned th_rewriter::get_num_steps() const {
     return m_imp->get_num_steps();
 }
 
+unsigned th_rewriter::get_num_cache_hits() const {
+    return m_imp->get_num_cache_hits();
+}
+
+unsigned th_rewriter::get_num_cache_misses() const {
+    return m_imp->get_num_cache_misses();
+}
+
 
 void th_rewriter::cleanup() {
     ast_manager & m = m_imp->m();
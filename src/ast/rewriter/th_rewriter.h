@@ -41,6 +41,8 @@ public:
     static void get_param_descrs(param_descrs & r);
     unsigned get_cache_size() const;
     unsigned get_num_steps() const;
+    unsigned get_num_cache_hits() const;
+    unsigned get_num_cache_misses() const;
 
     void operator()(expr_ref& term);
     void operator()(expr * t, expr_ref & result);
@@ -29,7 +29,8 @@ grobner::grobner(ast_manager & m, v_dependency_manager & d):
     m_var_lt(m_var2weight),
     m_monomial_lt(m_var_lt),
     m_changed_leading_term(false),
-    m_unsat(0) {
+    m_unsat(0),
+    m_f4(false) {
 }
 
 grobner::~grobner() {
@@ -937,6 +938,8 @@ void grobner::compute_basis_init() {
 }
 
 bool grobner::compute_basis_step() {
+    if (m_f4)
+        return compute_basis_f4_step();
     equation * eq = pick_next();
     if (!eq)
         return true;
@@ -969,6 +972,295 @@ bool grobner::compute_basis(unsigned threshold) {
     return false;
 }
 
+unsigned grobner::f4_col_hash::operator()(int c) const {
+    monomial const * m = m_cols[c];
+    unsigned h = m->get_degree();
+    for (unsigned i = 0; i < m->get_degree(); i++)
+        h = combine_hash(h, m->get_var(i)->get_id());
+    return h;
+}
+
+/**
+   \brief Return the column of the monomial m * rest. The coefficient of m is ignored.
+*/
+unsigned grobner::f4_mk_col(f4_matrix & M, monomial const * m, ptr_vector<expr> const & rest) {
+    monomial * c = alloc(monomial);
+    c->m_coeff   = rational::one();
+    for (unsigned i = 0; i < m->m_vars.size(); i++)
+        add_var(c, m->m_vars[i]);
+    for (unsigned i = 0; i < rest.size(); i++)
+        add_var(c, rest[i]);
+    std::stable_sort(c->m_vars.begin(), c->m_vars.end(), m_var_lt);
+    int id = M.m_cols.size();
+    M.m_cols.push_back(c);
+    int r = M.m_col_table.insert_if_not_there(id);
+    if (r != id) {
+        M.m_cols.pop_back();
+        del_monomial(c);
+    }
+    return r;
+}
+
+/**
+   \brief Add the row rest * eq to M. New columns are stored in todo.
+*/
+void grobner::f4_add_row(f4_matrix & M, equation const * eq, ptr_vector<expr> const & rest, unsigned_vector & todo) {
+    M.m_rows.push_back(f4_row());
+    f4_row & r  = M.m_rows.back();
+    r.m_dep     = eq->m_dep;
+    unsigned sz = eq->get_num_monomials();
+    for (unsigned i = 0; i < sz; i++) {
+        monomial const * m = eq->get_monomial(i);
+        unsigned old_sz    = M.m_cols.size();
+        unsigned c         = f4_mk_col(M, m, rest);
+        if (c >= old_sz)
+            todo.push_back(c);
+        r.m_cols.push_back(c);
+        r.m_coeffs.push_back(m->m_coeff);
+    }
+    m_stats.m_f4_rows++;
+}
+
+/**
+   \brief Renumber the columns of M such that column 0 contains the largest monomial,
+   and sort the entries of every row by column.
+*/
+void grobner::f4_sort_cols(f4_matrix & M) {
+    unsigned num_cols = M.m_cols.size();
+    unsigned_vector order;
+    for (unsigned i = 0; i < num_cols; i++)
+        order.push_back(i);
+    std::stable_sort(order.begin(), order.end(), f4_col_lt(m_monomial_lt, M.m_cols));
+    unsigned_vector pos;
+    pos.resize(num_cols, 0);
+    ptr_vector<monomial> cols;
+    for (unsigned i = 0; i < num_cols; i++) {
+        pos[order[i]] = i;
+        cols.push_back(M.m_cols[order[i]]);
+    }
+    M.m_col_table.reset();
+    M.m_cols.swap(cols);
+    svector<std::pair<unsigned, unsigned> > entries;
+    unsigned_vector new_cols;
+    vector<rational> new_coeffs;
+    for (unsigned i = 0; i < M.m_rows.size(); i++) {
+        f4_row & r = M.m_rows[i];
+        entries.reset();
+        for (unsigned j = 0; j < r.m_cols.size(); j++)
+            entries.push_back(std::make_pair(pos[r.m_cols[j]], j));
+        std::sort(entries.begin(), entries.end());
+        new_cols.reset();
+        new_coeffs.reset();
+        for (unsigned j = 0; j < entries.size(); j++) {
+            new_cols.push_back(entries[j].first);
+            new_coeffs.push_back(r.m_coeffs[entries[j].second]);
+        }
+        r.m_cols.swap(new_cols);
+        r.m_coeffs.swap(new_coeffs);
+    }
+}
+
+/**
+   \brief r <- r - c * p
+*/
+void grobner::f4_sub(f4_row & r, rational const & c, f4_row const & p) {
+    unsigned_vector  cols;
+    vector<rational> coeffs;
+    unsigned i   = 0;
+    unsigned j   = 0;
+    unsigned sz1 = r.m_cols.size();
+    unsigned sz2 = p.m_cols.size();
+    rational v;
+    while (i < sz1 || j < sz2) {
+        if (j == sz2 || (i < sz1 && r.m_cols[i] < p.m_cols[j])) {
+            cols.push_back(r.m_cols[i]);
+            coeffs.push_back(r.m_coeffs[i]);
+            i++;
+        }
+        else if (i == sz1 || p.m_cols[j] < r.m_cols[i]) {
+            cols.push_back(p.m_cols[j]);
+            coeffs.push_back(-c * p.m_coeffs[j]);
+            j++;
+        }
+        else {
+            v = r.m_coeffs[i] - c * p.m_coeffs[j];
+            if (!v.is_zero()) {
+                cols.push_back(r.m_cols[i]);
+                coeffs.push_back(v);
+            }
+            i++;
+            j++;
+        }
+    }
+    r.m_cols.swap(cols);
+    r.m_coeffs.swap(coeffs);
+    r.m_dep = m_dep_manager.mk_join(r.m_dep, p.m_dep);
+}
+
+/**
+   \brief Bring M into row echelon form: the leading columns of the non-zero rows are distinct.
+*/
+void grobner::f4_reduce(f4_matrix & M) {
+    unsigned_vector pivots;
+    pivots.resize(M.m_cols.size(), UINT_MAX);
+    rational c;
+    for (unsigned i = 0; i < M.m_rows.size() && !m_manager.canceled(); i++) {
+        f4_row & r = M.m_rows[i];
+        while (!r.m_cols.empty() && pivots[r.m_cols[0]] != UINT_MAX) {
+            f4_row const & p = M.m_rows[pivots[r.m_cols[0]]];
+            c  = r.m_coeffs[0];
+            c /= p.m_coeffs[0];
+            f4_sub(r, c, p);
+            m_stats.m_f4_reductions++;
+        }
+        if (!r.m_cols.empty())
+            pivots[r.m_cols[0]] = i;
+    }
+}
+
+void grobner::f4_del_matrix(f4_matrix & M) {
+    del_monomials(M.m_cols);
+    M.m_col_table.reset();
+    M.m_rows.reset();
+}
+
+/**
+   \brief Compute the S-polynomials of the equations in new_eqs with the equations in m_processed,
+   and reduce them using the equations in m_processed with a single sparse row reduction.
+   The reduced S-polynomials whose leading monomials are not leading monomials of
+   any row before the reduction are added to m_to_process.
+*/
+void grobner::f4_superpose(ptr_vector<equation> const & new_eqs) {
+    f4_matrix M;
+    unsigned_vector todo;
+    svector<char> covered;
+    equation_set is_new;
+    for (unsigned i = 0; i < new_eqs.size(); i++)
+        is_new.insert(new_eqs[i]);
+    ptr_vector<expr> & rest1 = m_tmp_vars1;
+    ptr_vector<expr> & rest2 = m_tmp_vars2;
+    for (unsigned i = 0; i < new_eqs.size(); i++) {
+        equation * eq1 = new_eqs[i];
+        if (eq1->m_monomials.empty())
+            continue;
+        equation_set::iterator it  = m_processed.begin();
+        equation_set::iterator end = m_processed.end();
+        for (; it != end; ++it) {
+            equation * eq2 = *it;
+            if (eq2->m_monomials.empty() || eq1 == eq2)
+                continue;
+            // each pair of new equations is considered once.
+            if (is_new.contains(eq2) && eq2->m_bidx < eq1->m_bidx)
+                continue;
+            rest1.reset();
+            rest2.reset();
+            if (unify(eq1->m_monomials[0], eq2->m_monomials[0], rest1, rest2)) {
+                m_stats.m_superpose++;
+                f4_add_row(M, eq1, rest2, todo);
+                f4_add_row(M, eq2, rest1, todo);
+                covered.setx(M.m_rows.back().m_cols[0], true, false);
+            }
+        }
+    }
+    if (M.m_rows.empty())
+        return;
+    // symbolic preprocessing: add a reducer for every monomial that is divisible by a leading monomial.
+    ptr_vector<expr> rest;
+    while (!todo.empty() && !m_manager.canceled()) {
+        unsigned c = todo.back();
+        todo.pop_back();
+        if (covered.get(c, false))
+            continue;
+        covered.setx(c, true, false);
+        equation_set::iterator it  = m_processed.begin();
+        equation_set::iterator end = m_processed.end();
+        for (; it != end; ++it) {
+            equation * eq = *it;
+            rest.reset();
+            if (!eq->m_monomials.empty() && is_subset(eq->m_monomials[0], M.m_cols[c], rest)) {
+                f4_add_row(M, eq, rest, todo);
+                break;
+            }
+        }
+    }
+    if (m_manager.canceled()) {
+        f4_del_matrix(M);
+        return;
+    }
+    f4_sort_cols(M);
+    svector<char> is_lead;
+    is_lead.resize(M.m_cols.size(), false);
+    for (unsigned i = 0; i < M.m_rows.size(); i++)
+        is_lead[M.m_rows[i].m_cols[0]] = true;
+    f4_reduce(M);
+    for (unsigned i = 0; i < M.m_rows.size() && !m_manager.canceled(); i++) {
+        f4_row const & r = M.m_rows[i];
+        if (r.m_cols.empty() || is_lead[r.m_cols[0]])
+            continue;
+        equation * new_eq = alloc(equation);
+        for (unsigned j = 0; j < r.m_cols.size(); j++) {
+            monomial * m = copy_monomial(M.m_cols[r.m_cols[j]]);
+            m->m_coeff   = r.m_coeffs[j];
+            new_eq->m_monomials.push_back(m);
+        }
+        simplify(new_eq->m_monomials);
+        TRACE("grobner", tout << "f4 equation: "; display_monomials(tout, new_eq->m_monomials.size(), new_eq->m_monomials.c_ptr()); tout << "\n";);
+        m_num_new_equations++;
+        init_equation(new_eq, r.m_dep);
+        new_eq->m_lc = false;
+        m_to_process.insert(new_eq);
+    }
+    f4_del_matrix(M);
+}
+
+/**
+   \brief Process all pending equations of minimal degree, and superpose them
+   with the processed equations using F4-style reduction.
+*/
+bool grobner::compute_basis_f4_step() {
+    equation * eq = pick_next();
+    if (!eq)
+        return true;
+    ptr_vector<equation> batch;
+    unsigned deg = eq->m_monomials.empty() ? 0 : eq->m_monomials[0]->get_degree();
+    batch.push_back(eq);
+    while ((eq = pick_next()) != 0) {
+        if (!eq->m_monomials.empty() && eq->m_monomials[0]->get_degree() > deg) {
+            m_to_process.insert(eq);
+            break;
+        }
+        batch.push_back(eq);
+    }
+    unsigned bidx = m_equations_to_delete.size();
+    equation_set in_batch;
+    for (unsigned i = 0; i < batch.size(); i++) {
+        eq = batch[i];
+        m_stats.m_num_processed++;
+        equation * new_eq = simplify_using_processed(eq);
+        if (new_eq != 0 && eq != new_eq) {
+            // equation was updated using non destructive updates
+            m_equations_to_unfreeze.push_back(eq);
+            eq = new_eq;
+        }
+        if (m_manager.canceled()) return false;
+        if (!simplify_processed(eq)) return false;
+        m_processed.insert(eq);
+        simplify_to_process(eq);
+        in_batch.insert(eq);
+    }
+    // the equations of the batch may have been replaced by simplified copies.
+    ptr_vector<equation> new_eqs;
+    equation_set::iterator it  = m_processed.begin();
+    equation_set::iterator end = m_processed.end();
+    for (; it != end; ++it) {
+        if (in_batch.contains(*it) || (*it)->m_bidx >= bidx)
+            new_eqs.push_back(*it);
+    }
+    f4_superpose(new_eqs);
+    TRACE("grobner", tout << "end of f4 iteration:\n"; display(tout););
+    return false;
+}
+
 void grobner::copy_to(equation_set const & s, ptr_vector<equation> & result) const {
     equation_set::iterator it  = s.begin();
     equation_set::iterator end = s.end();
@@ -25,10 +25,12 @@ Revision History:
 #include "util/obj_hashtable.h"
 #include "util/region.h"
 #include "util/dependency.h"
+#include "util/hashtable.h"
 
 
 struct grobner_stats {
     long m_simplify; long m_superpose; long m_compute_basis; long m_num_processed;
+    long m_f4_rows; long m_f4_reductions;
     void reset() { memset(this, 0, sizeof(grobner_stats)); }
     grobner_stats() { reset(); }
 };
@@ -109,6 +111,7 @@ protected:
         unsigned m_equations_to_delete_lim;
     };
     svector<scope>          m_scopes;
+    bool                    m_f4;
     ptr_vector<monomial>    m_tmp_monomials;
     ptr_vector<monomial>    m_del_monomials;
     ptr_vector<expr>        m_tmp_vars1;
@@ -187,6 +190,61 @@ protected:
 
     void copy_to(equation_set const & s, ptr_vector<equation> & result) const;
 
+    // F4-style reduction:
+    // the S-polynomials of a batch of equations are reduced simultaneously by
+    // row-reducing a sparse matrix whose columns are the monomials occurring in
+    // the S-polynomials and in the multiples of processed equations used to reduce them.
+    struct f4_row {
+        unsigned_vector  m_cols;    //!< increasing column positions, column 0 is the largest monomial
+        vector<rational> m_coeffs;
+        v_dependency *   m_dep;
+        f4_row():m_dep(0) {}
+    };
+
+    struct f4_col_hash {
+        ptr_vector<monomial> const & m_cols;
+        f4_col_hash(ptr_vector<monomial> const & cols):m_cols(cols) {}
+        unsigned operator()(int c) const;
+    };
+
+    struct f4_col_eq {
+        ptr_vector<monomial> const & m_cols;
+        f4_col_eq(ptr_vector<monomial> const & cols):m_cols(cols) {}
+        bool operator()(int c1, int c2) const { return is_eq_monomial_body(m_cols[c1], m_cols[c2]); }
+    };
+
+    typedef int_hashtable<f4_col_hash, f4_col_eq> f4_col_table;
+
+    struct f4_col_lt {
+        monomial_lt &                m_lt;
+        ptr_vector<monomial> const & m_cols;
+        f4_col_lt(monomial_lt & lt, ptr_vector<monomial> const & cols):m_lt(lt), m_cols(cols) {}
+        bool operator()(unsigned c1, unsigned c2) const { return m_lt(m_cols[c1], m_cols[c2]); }
+    };
+
+    struct f4_matrix {
+        ptr_vector<monomial> m_cols;     //!< monomial of each column (coefficient is ignored)
+        f4_col_table         m_col_table;
+        vector<f4_row>       m_rows;
+        f4_matrix():m_col_table(DEFAULT_HASHTABLE_INITIAL_CAPACITY, f4_col_hash(m_cols), f4_col_eq(m_cols)) {}
+    };
+
+    unsigned f4_mk_col(f4_matrix & M, monomial const * m, ptr_vector<expr> const & rest);
+
+    void f4_add_row(f4_matrix & M, equation const * eq, ptr_vector<expr> const & rest, unsigned_vector & todo);
+
+    void f4_sort_cols(f4_matrix & M);
+
+    void f4_sub(f4_row & r, rational const & c, f4_row const & p);
+
+    void f4_reduce(f4_matrix & M);
+
+    void f4_del_matrix(f4_matrix & M);
+
+    void f4_superpose(ptr_vector<equation> const & new_eqs);
+
+    bool compute_basis_f4_step();
+
 public:
     grobner(ast_manager & m, v_dependency_manager & dep_m);
 
@@ -194,6 +252,12 @@ public:
 
     unsigned get_scope_level() const { return m_scopes.size(); }
 
+    /**
+       \brief Use F4-style reduction: compute_basis_step processes all pending equations
+       of minimal degree at once and reduces their S-polynomials by sparse row reduction.
+    */
+    void set_f4(bool f) { m_f4 = f; }
+
     /**
        \brief Set the weight of a term that is viewed as a variable by this module.
        The weight is used to order monomials. If the weight is not set for a term t, then the
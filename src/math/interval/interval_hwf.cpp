@@ -0,0 +1,18 @@
+/*++
+Copyright (c) 2017 Microsoft Corporation
+
+Module Name:
+
+    interval_hwf.cpp
+
+Abstract:
+
+    Instantiate template for hardware floats.
+
+Revision History:
+
+--*/
+#include "math/interval/interval_def.h"
+#include "math/interval/interval_hwf.h"
+
+template class interval_manager<im_hwf_config>;
@@ -0,0 +1,69 @@
+/*++
+Copyright (c) 2017 Microsoft Corporation
+
+Module Name:
+
+    interval_hwf.h
+
+Abstract:
+
+    Interval manager configuration for hardware floats.
+
+    Bounds are rounded outwards, so an interval computed by
+    interval_manager<im_hwf_config> contains the exact result.
+    Operations that overflow raise f2n<hwf_manager>::exception,
+    and clients are expected to fall back to precise arithmetic.
+
+Revision History:
+
+--*/
+#ifndef INTERVAL_HWF_H_
+#define INTERVAL_HWF_H_
+
+#include "math/interval/interval.h"
+#include "util/f2n.h"
+#include "util/hwf.h"
+
+class im_hwf_config {
+    f2n<hwf_manager> & m_manager;
+public:
+    typedef f2n<hwf_manager>            numeral_manager;
+    typedef hwf                         numeral;
+    typedef f2n<hwf_manager>::exception exception;
+
+    struct interval {
+        numeral m_lower;
+        numeral m_upper;
+    };
+
+    void round_to_minus_inf() { m_manager.round_to_minus_inf(); }
+    void round_to_plus_inf() { m_manager.round_to_plus_inf(); }
+    void set_rounding(bool to_plus_inf) { m_manager.set_rounding(to_plus_inf); }
+
+    // Getters
+    numeral const & lower(interval const & a) const { return a.m_lower; }
+    numeral const & upper(interval const & a) const { return a.m_upper; }
+    numeral & lower(interval & a) { return a.m_lower; }
+    numeral & upper(interval & a) { return a.m_upper; }
+    bool lower_is_inf(interval const & a) const { return m_manager.m().is_ninf(a.m_lower); }
+    bool upper_is_inf(interval const & a) const { return m_manager.m().is_pinf(a.m_upper); }
+    bool lower_is_open(interval const & a) const { return lower_is_inf(a); }
+    bool upper_is_open(interval const & a) const { return upper_is_inf(a); }
+
+    // Setters
+    void set_lower(interval & a, numeral const & n) { m_manager.set(a.m_lower, n); }
+    void set_upper(interval & a, numeral const & n) { m_manager.set(a.m_upper, n); }
+    void set_lower_is_open(interval & a, bool v) {}
+    void set_upper_is_open(interval & a, bool v) {}
+    void set_lower_is_inf(interval & a, bool v) { if (v) m_manager.m().mk_ninf(a.m_lower); }
+    void set_upper_is_inf(interval & a, bool v) { if (v) m_manager.m().mk_pinf(a.m_upper); }
+
+    // Reference to numeral manager
+    numeral_manager & m() const { return m_manager; }
+
+    im_hwf_config(f2n<hwf_manager> & m):m_manager(m) {}
+};
+
+typedef interval_manager<im_hwf_config> hwf_interval_manager;
+
+#endif
@@ -27,6 +27,8 @@ Notes:
 #include "util/timeit.h"
 #include "math/polynomial/algebraic_params.hpp"
 #include "util/common_msgs.h"
+#include "util/hashtable.h"
+#include "math/interval/interval_hwf.h"
 
 namespace algebraic_numbers {
 
@@ -63,6 +65,40 @@ namespace algebraic_numbers {
     }
 
     struct manager::imp {
+        /**
+           \brief Isolated roots of a univariate polynomial.
+           Cached entries own a copy of the coefficients of the polynomial.
+        */
+        struct root_entry {
+            unsigned       m_hash;
+            unsigned       m_size;
+            mpz const *    m_coeffs;
+            upoly          m_poly;
+            numeral_vector m_roots;
+        };
+
+        struct root_entry_hash_proc {
+            unsigned operator()(root_entry const * e) const { return e->m_hash; }
+        };
+
+        struct root_entry_eq_proc {
+            upolynomial::numeral_manager * m_manager;
+            root_entry_eq_proc(upolynomial::numeral_manager * m = 0): m_manager(m) {}
+            bool operator()(root_entry const * e1, root_entry const * e2) const {
+                if (e1->m_hash != e2->m_hash || e1->m_size != e2->m_size)
+                    return false;
+                for (unsigned i = 0; i < e1->m_size; i++) {
+                    if (!m_manager->eq(e1->m_coeffs[i], e2->m_coeffs[i]))
+                        return false;
+                }
+                return true;
+            }
+        };
+
+        typedef ptr_hashtable<root_entry, root_entry_hash_proc, root_entry_eq_proc> root_cache;
+
+        typedef im_hwf_config::interval hwf_interval;
+
         reslimit&                m_limit;
         manager &                m_wrapper;
         small_object_allocator & m_allocator;
@@ -84,18 +120,30 @@ namespace algebraic_numbers {
         scoped_upoly             m_add_tmp;
         polynomial::var          m_x;
         polynomial::var          m_y;
+        root_cache               m_root_cache;
+        root_entry               m_root_key;
+        hwf_manager              m_hwf_manager;
+        f2n<hwf_manager>         m_f2n;
+        hwf_interval_manager     m_hwf_im;
+        scoped_mpq               m_hwf_tmp;
 
         // configuration
         int                        m_min_magnitude;
         bool                       m_factor;
         polynomial::factor_params  m_factor_params;
         int                        m_zero_accuracy;
+        unsigned                   m_root_cache_size;
+        bool                       m_hwf_eval;
 
         // statistics
         unsigned                 m_compare_cheap;
         unsigned                 m_compare_sturm;
         unsigned                 m_compare_refine;
         unsigned                 m_compare_poly_eq;
+        unsigned                 m_root_cache_hits;
+        unsigned                 m_root_cache_misses;
+        unsigned                 m_hwf_eval_hits;
+        unsigned                 m_hwf_eval_misses;
 
         imp(reslimit& lim, manager & w, unsynch_mpq_manager & m, params_ref const & p, small_object_allocator & a):
             m_limit(lim),
@@ -115,7 +163,11 @@ namespace algebraic_numbers {
             m_isolate_roots(bqm()),
             m_isolate_lowers(bqm()),
             m_isolate_uppers(bqm()),
-            m_add_tmp(upm()) {
+            m_add_tmp(upm()),
+            m_root_cache(DEFAULT_HASHTABLE_INITIAL_CAPACITY, root_entry_hash_proc(), root_entry_eq_proc(&upm().m())),
+            m_f2n(m_hwf_manager),
+            m_hwf_im(lim, im_hwf_config(m_f2n)),
+            m_hwf_tmp(m) {
             updt_params(p);
             reset_statistics();
             m_x = pm().mk_var();
@@ -123,6 +175,7 @@ namespace algebraic_numbers {
         }
 
         ~imp() {
+            reset_root_cache();
         }
 
         void checkpoint() {
@@ -136,6 +189,10 @@ namespace algebraic_numbers {
             m_compare_sturm   = 0;
             m_compare_refine  = 0;
             m_compare_poly_eq = 0;
+            m_root_cache_hits   = 0;
+            m_root_cache_misses = 0;
+            m_hwf_eval_hits     = 0;
+            m_hwf_eval_misses   = 0;
         }
 
         void collect_statistics(statistics & st) {
@@ -145,6 +202,10 @@ namespace algebraic_numbers {
             st.update("algebraic compare refine", m_compare_refine);
             st.update("algebraic compare poly", m_compare_poly_eq);
 #endif
+            st.update("algebraic root cache hits", m_root_cache_hits);
+            st.update("algebraic root cache misses", m_root_cache_misses);
+            st.update("algebraic hwf eval hits", m_hwf_eval_hits);
+            st.update("algebraic hwf eval misses", m_hwf_eval_misses);
         }
 
         void updt_params(params_ref const & _p) {
@@ -155,6 +216,10 @@ namespace algebraic_numbers {
             m_factor_params.m_p_trials = p.factor_num_primes();
             m_factor_params.m_max_search_size = p.factor_search_size();
             m_zero_accuracy            = -static_cast<int>(p.zero_accuracy());
+            m_root_cache_size          = p.root_cache();
+            m_hwf_eval                 = p.hwf_eval();
+            if (m_root_cache_size == 0)
+                reset_root_cache();
         }
 
         unsynch_mpq_manager & qm() {
@@ -564,7 +629,74 @@ namespace algebraic_numbers {
             std::sort(r.begin(), r.end(), lt_proc(m_wrapper));
         }
 
+        void reset_root_cache() {
+            root_cache::iterator it  = m_root_cache.begin();
+            root_cache::iterator end = m_root_cache.end();
+            for (; it != end; ++it) {
+                root_entry * e = *it;
+                upm().reset(e->m_poly);
+                for (unsigned i = 0; i < e->m_roots.size(); i++)
+                    del(e->m_roots[i]);
+                dealloc(e);
+            }
+            m_root_cache.reset();
+        }
+
+        unsigned hash_upoly(scoped_upoly const & up) {
+            unsigned h = up.size();
+            for (unsigned i = 0; i < up.size(); i++)
+                h = combine_hash(h, unsynch_mpz_manager::hash(up[i]));
+            return h;
+        }
+
+        void append_roots(numeral_vector const & src, numeral_vector & roots) {
+            for (unsigned i = 0; i < src.size(); i++) {
+                roots.push_back(numeral());
+                set(roots.back(), src[i]);
+            }
+        }
+
+        /**
+           \brief Isolate the roots of up, reusing the roots isolated the last time up was seen.
+           nlsat isolates the roots of the same polynomials under the same (partial)
+           assignments over and over; the multivariate procedures reduce to this one after
+           substituting the assignment, so the univariate polynomial is the cache key.
+           Cached roots keep the refinement intervals they had when they were isolated.
+        */
         void isolate_roots(scoped_upoly const & up, numeral_vector & roots) {
+            if (up.empty())
+                return; // ignore the zero polynomial
+            if (m_root_cache_size == 0) {
+                isolate_roots_core(up, roots);
+                return;
+            }
+            m_root_key.m_hash   = hash_upoly(up);
+            m_root_key.m_size   = up.size();
+            m_root_key.m_coeffs = up.c_ptr();
+            root_entry * e = 0;
+            if (m_root_cache.find(&m_root_key, e)) {
+                m_root_cache_hits++;
+                append_roots(e->m_roots, roots);
+                sort_roots(roots);
+                return;
+            }
+            m_root_cache_misses++;
+            scoped_numeral_vector new_roots(m_wrapper);
+            isolate_roots_core(up, new_roots);
+            if (m_root_cache.size() >= m_root_cache_size)
+                reset_root_cache();
+            e = alloc(root_entry);
+            e->m_hash = m_root_key.m_hash;
+            upm().set(up.size(), up.c_ptr(), e->m_poly);
+            e->m_size   = e->m_poly.size();
+            e->m_coeffs = e->m_poly.c_ptr();
+            append_roots(new_roots, e->m_roots);
+            m_root_cache.insert(e);
+            append_roots(new_roots, roots);
+            sort_roots(roots);
+        }
+
+        void isolate_roots_core(scoped_upoly const & up, numeral_vector & roots) {
             TRACE("algebraic", upm().display(tout, up); tout << "\n";);
             if (up.empty())
                 return; // ignore the zero polynomial
@@ -1975,10 +2107,120 @@ namespace algebraic_numbers {
             }
         };
 
+        /**
+           \brief Store in r a floating point interval containing the rational q.
+           Return false if the numerator or denominator of q is not a small integer.
+        */
+        bool to_hwf_interval(mpq const & q, hwf_interval & r) {
+            if (!qm().is_small(q.numerator()) || !qm().is_small(q.denominator()))
+                return false;
+            m_f2n.round_to_minus_inf();
+            m_f2n.set(r.m_lower, q);
+            m_f2n.round_to_plus_inf();
+            m_f2n.set(r.m_upper, q);
+            return true;
+        }
+
+        bool to_hwf_interval(anum const & v, hwf_interval & r) {
+            if (v.is_basic())
+                return to_hwf_interval(basic_value(v), r);
+            algebraic_cell * c = v.to_algebraic();
+            hwf_interval u;
+            ::to_mpq(qm(), lower(c), m_hwf_tmp);
+            if (!to_hwf_interval(m_hwf_tmp, r))
+                return false;
+            ::to_mpq(qm(), upper(c), m_hwf_tmp);
+            if (!to_hwf_interval(m_hwf_tmp, u))
+                return false;
+            m_f2n.set(r.m_upper, u.m_upper);
+            return true;
+        }
+
+        /**
+           \brief Try to determine the sign of p at x2v using interval arithmetic over
+           hardware floats. The bounds are rounded outwards, so the sign is correct whenever
+           the resultant interval does not contain zero (or is the point zero).
+           Return false if the result is inconclusive or the numbers do not fit.
+        */
+        bool hwf_eval_sign_at(polynomial_ref const & p, polynomial::var2anum const & x2v, int & sign) {
+            bool r = hwf_eval_sign_core(p, x2v, sign);
+            // restore the default rounding mode of the hardware; the value is irrelevant.
+            hwf tmp;
+            m_hwf_manager.set(tmp, MPF_ROUND_NEAREST_TEVEN, 0, 1);
+            return r;
+        }
+
+        bool hwf_eval_sign_core(polynomial_ref const & p, polynomial::var2anum const & x2v, int & sign) {
+            polynomial::manager & ext_pm = p.m();
+            hwf_interval_manager & im = m_hwf_im;
+            hwf_interval r, m, v, t, tmp;
+            try {
+                m_f2n.set(r.m_lower, 0);
+                m_f2n.set(r.m_upper, 0);
+                unsigned sz = ext_pm.size(p);
+                for (unsigned i = 0; i < sz; i++) {
+                    mpz const & a = ext_pm.coeff(p, i);
+                    if (!qm().is_small(a))
+                        return false;
+                    int n = static_cast<int>(qm().get_int64(a));
+                    m_f2n.set(m.m_lower, n);
+                    m_f2n.set(m.m_upper, n);
+                    polynomial::monomial * mon = ext_pm.get_monomial(p, i);
+                    unsigned msz = ext_pm.size(mon);
+                    for (unsigned j = 0; j < msz; j++) {
+                        if (!to_hwf_interval(x2v(ext_pm.get_var(mon, j)), v))
+                            return false;
+                        im.power(v, ext_pm.degree(mon, j), t);
+                        im.mul(m, t, tmp);
+                        im.set(m, tmp);
+                    }
+                    im.add(r, m, tmp);
+                    im.set(r, tmp);
+                }
+            }
+            catch (im_hwf_config::exception) {
+                return false;
+            }
+            if (im.is_P1(r))
+                sign = 1;
+            else if (im.is_N1(r))
+                sign = -1;
+            else if (im.is_zero(r))
+                sign = 0;
+            else
+                return false;
+            return true;
+        }
+
+        bool has_algebraic_value(polynomial_ref const & p, polynomial::var2anum const & x2v) {
+            polynomial::manager & ext_pm = p.m();
+            unsigned sz = ext_pm.size(p);
+            for (unsigned i = 0; i < sz; i++) {
+                polynomial::monomial * mon = ext_pm.get_monomial(p, i);
+                unsigned msz = ext_pm.size(mon);
+                for (unsigned j = 0; j < msz; j++) {
+                    if (!x2v(ext_pm.get_var(mon, j)).is_basic())
+                        return true;
+                }
+            }
+            return false;
+        }
+
         polynomial::var_vector m_eval_sign_vars;
         int eval_sign_at(polynomial_ref const & p, polynomial::var2anum const & x2v) {
             polynomial::manager & ext_pm = p.m();
             TRACE("anum_eval_sign", tout << "evaluating sign of: " << p << "\n";);
+            // Precise evaluation is cheap when all values are rational.
+            // Otherwise, maybe floating point intervals already determine the sign.
+            if (m_hwf_eval && has_algebraic_value(p, x2v)) {
+                int sign;
+                if (hwf_eval_sign_at(p, x2v, sign)) {
+                    m_hwf_eval_hits++;
+                    TRACE("anum_eval_sign", tout << "sign using floating point intervals: " << sign << "\n";);
+                    return sign;
+                }
+                m_hwf_eval_misses++;
+            }
             while (true) {
                 bool restart = false;
                 // Optimistic: maybe x2v contains only rational values
@@ -1993,6 +2235,7 @@ namespace algebraic_numbers {
                     // continue
                 }
 
+
                 // Eliminate rational values from p
                 polynomial_ref p_prime(ext_pm);
                 var2basic x2v_basic(*this, x2v);
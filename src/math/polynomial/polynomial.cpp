@@ -1848,6 +1848,7 @@ namespace polynomial {
         unsigned_vector          m_degree2pos;
         bool                     m_use_sparse_gcd;
         bool                     m_use_prs_gcd;
+        bool                     m_use_modular_psc;
 
         // Debugging method: check if the coefficients of p are in the numeral_manager.
         bool consistent_coeffs(polynomial const * p) {
@@ -2323,6 +2324,7 @@ namespace polynomial {
             inc_ref(m_unit_poly);
             m_use_sparse_gcd = true;
             m_use_prs_gcd = false;
+            m_use_modular_psc = false;
         }
 
         imp(reslimit& lim, manager & w, unsynch_mpz_manager & m, monomial_manager * mm):
@@ -5406,6 +5408,25 @@ namespace polynomial {
             TRACE("resultant", tout << "resultant(A, B, x) after normalization\nA: " << A << "\nB: " << B << "\nx: " << x << "\n";
                   tout << "t: " << t << "\n";);
 
+            polynomial_ref_vector R(pm());
+            if (m_use_modular_psc && !m().modular() && degree(A, x) > 0 && degree(B, x) > 0 &&
+                modular_psc_images(A, B, x, false, R)) {
+                result = mul(t, R.get(0));
+                return;
+            }
+            prs_resultant(A, B, x, result);
+            result = mul(t, result);
+        }
+
+        /**
+           \brief Resultant of A and B computed using the subresultant PRS,
+           where A and B are not constant.
+        */
+        void prs_resultant(polynomial const * _A, polynomial const * _B, var x, polynomial_ref & result) {
+            polynomial_ref A(pm());
+            polynomial_ref B(pm());
+            A = const_cast<polynomial*>(_A);
+            B = const_cast<polynomial*>(_B);
             int s = 1;
             unsigned degA = degree(A, x);
             unsigned degB = degree(B, x);
@@ -5459,8 +5480,8 @@ namespace polynomial {
                             new_h = exact_div(new_h, h);
                     }
                     h = new_h;
-                    // result <- s*t*h
-                    result = mul(t, h);
+                    // result <- s*h
+                    result = h;
                     if (s < 0)
                         result = neg(result);
                     return;
@@ -5752,7 +5773,11 @@ namespace polynomial {
                 S_e_1 = neg(S_e_1);
         }
 
-        void psc_chain_optimized_core(polynomial const * P, polynomial const * Q, var x, polynomial_ref_vector & S) {
+        /**
+           \brief Store in S the nonzero principal subresultant coefficients of P and Q, from
+           the highest to the lowest index. If idx is not null, store their indices in idx.
+        */
+        void psc_chain_optimized_core(polynomial const * P, polynomial const * Q, var x, polynomial_ref_vector & S, unsigned_vector * idx = 0) {
             TRACE("psc_chain_classic", tout << "P: "; P->display(tout, m_manager); tout << "\nQ: "; Q->display(tout, m_manager); tout << "\n";);
             unsigned degP = degree(P, x);
             unsigned degQ = degree(Q, x);
@@ -5776,8 +5801,10 @@ namespace polynomial {
                 TRACE("psc_chain_classic", tout << "A: " << A << "\nB: " << B << "\ns: " << s << "\nd: " << d << ", e: " << e << "\n";);
                 // B is S_{d-1}
                 ps = coeff(B, x, d-1);
-                if (!is_zero(ps))
+                if (!is_zero(ps)) {
                     S.push_back(ps);
+                    if (idx) idx->push_back(d-1);
+                }
                 unsigned delta = d - e;
                 if (delta > 1) {
                     // C <- S_e
@@ -5787,8 +5814,10 @@ namespace polynomial {
 
                     // C is S_e
                     ps = coeff(C, x, e);
-                    if (!is_zero(ps))
+                    if (!is_zero(ps)) {
                         S.push_back(ps);
+                        if (idx) idx->push_back(e);
+                    }
                 }
                 else {
                     SASSERT(delta == 0 || delta == 1);
@@ -5809,6 +5838,19 @@ namespace polynomial {
             SASSERT(degree(P, x) > 0);
             SASSERT(degree(Q, x) > 0);
             S.reset();
+            if (m_use_modular_psc && !m().modular()) {
+                polynomial_ref_vector C(pm());
+                if (modular_psc_images(P, Q, x, true, C)) {
+                    // C[j] is the j-th principal subresultant coefficient
+                    for (unsigned j = 0; j < C.size(); j++) {
+                        if (!is_zero(C.get(j)))
+                            S.push_back(C.get(j));
+                    }
+                    if (S.empty())
+                        S.push_back(mk_zero());
+                    return;
+                }
+            }
             if (degree(P, x) >= degree(Q, x))
                 psc_chain_optimized_core(P, Q, x, S);
             else
@@ -5898,6 +5940,117 @@ namespace polynomial {
             std::reverse(S.c_ptr(), S.c_ptr() + S.size());
         }
 
+        void l1_norm(polynomial const * p, scoped_numeral & r) {
+            scoped_numeral a(m_manager);
+            m_manager.set(r, 0);
+            unsigned sz = p->size();
+            for (unsigned i = 0; i < sz; i++) {
+                m_manager.set(a, p->a(i));
+                m_manager.abs(a);
+                m_manager.add(r, a, r);
+            }
+        }
+
+        /**
+           \brief Return the image of p modulo the current prime.
+           In contrast to normalize, the coefficients are not divided by their gcd.
+        */
+        polynomial * zp_image(polynomial const * p) {
+            SASSERT(m().modular());
+            SASSERT(m_cheap_som_buffer.empty());
+            scoped_numeral a(m_manager);
+            unsigned sz = p->size();
+            for (unsigned i = 0; i < sz; i++) {
+                m_manager.set(a, p->a(i));
+                m_cheap_som_buffer.add_reset(a, p->m(i));
+            }
+            return m_cheap_som_buffer.mk();
+        }
+
+        /**
+           \brief Combine the images of the resultant (psc == false) or of the principal
+           subresultant coefficients (psc == true) of P and Q modulo several primes using
+           the Chinese remainder theorem. In the psc case, C[j] is the j-th coefficient
+           for j < min(deg(P, x), deg(Q, x)); otherwise C[0] is the resultant.
+
+           Every principal subresultant coefficient, and the resultant, is a minor of the
+           Sylvester matrix of P and Q, where deg(Q, x) rows contain the coefficients of P
+           and deg(P, x) rows contain the coefficients of Q. Expanding the determinant along
+           the rows, the sum of the absolute values of its coefficients is bounded by
+               |P|_1^deg(Q, x) * |Q|_1^deg(P, x)
+           so the combination stops as soon as the product of the primes exceeds twice this
+           bound. Primes that reduce the degree of P or Q in x are skipped; for all other
+           primes the images of the minors are the minors of the images.
+
+           Return false if the bound exceeds the product of the available primes.
+        */
+        bool modular_psc_images(polynomial const * P, polynomial const * Q, var x, bool psc, polynomial_ref_vector & C) {
+            SASSERT(!m().modular());
+            unsigned degP = degree(P, x);
+            unsigned degQ = degree(Q, x);
+            SASSERT(degP > 0 && degQ > 0);
+            if (psc && degP < degQ) {
+                std::swap(P, Q);
+                std::swap(degP, degQ);
+            }
+            scoped_numeral bound(m_manager), tmp(m_manager);
+            l1_norm(P, bound);
+            m_manager.power(bound, degQ, bound);
+            l1_norm(Q, tmp);
+            m_manager.power(tmp, degP, tmp);
+            m_manager.mul(bound, tmp, bound);
+            m_manager.add(bound, bound, bound);
+
+            unsigned num_images = psc ? std::min(degP, degQ) : 1;
+            polynomial_ref_vector images(pm());
+            polynomial_ref_vector S(pm());
+            unsigned_vector idx;
+            polynomial_ref P_Zp(pm()), Q_Zp(pm()), r(pm());
+            scoped_numeral p(m_manager), modulus(m_manager), new_modulus(m_manager);
+            m_manager.set(modulus, 1);
+            C.reset();
+            for (unsigned i = 0; i < NUM_BIG_PRIMES && m_manager.le(modulus, bound); i++) {
+                checkpoint();
+                m_manager.set(p, g_big_primes[i]);
+                images.reset();
+                {
+                    scoped_set_zp setZp(m_wrapper, p);
+                    P_Zp = zp_image(P);
+                    Q_Zp = zp_image(Q);
+                    if (degree(P_Zp, x) < degP || degree(Q_Zp, x) < degQ) {
+                        TRACE("mpsc", tout << "bad prime " << p << ", leading coefficient vanished\n";);
+                        continue;
+                    }
+                    if (psc) {
+                        S.reset();
+                        idx.reset();
+                        psc_chain_optimized_core(P_Zp, Q_Zp, x, S, &idx);
+                        for (unsigned j = 0; j < num_images; j++)
+                            images.push_back(mk_zero());
+                        for (unsigned k = 0; k < S.size(); k++)
+                            images.set(idx[k], S.get(k));
+                    }
+                    else {
+                        prs_resultant(P_Zp, Q_Zp, x, r);
+                        images.push_back(r);
+                    }
+                }
+                if (C.empty()) {
+                    C.append(images);
+                    m_manager.set(modulus, p);
+                    continue;
+                }
+                for (unsigned j = 0; j < num_images; j++) {
+                    m_manager.set(new_modulus, modulus);
+                    CRA_combine_images(images.get(j), p, C.get(j), new_modulus, r);
+                    C.set(j, r);
+                }
+                m_manager.set(modulus, new_modulus);
+            }
+            TRACE("mpsc", tout << "modulus: " << modulus << "\nbound: " << bound << "\n";);
+            return !C.empty() && m_manager.gt(modulus, bound);
+        }
+
         void psc_chain(polynomial const * A, polynomial const * B, var x, polynomial_ref_vector & S) {
             // psc_chain1(A, B, x, S);
             // psc_chain2(A, B, x, S);
@@ -6919,6 +7072,14 @@ namespace polynomial {
         return m_imp->m().set_zp(p);
     }
 
+    void manager::set_modular_psc(bool f) {
+        m_imp->m_use_modular_psc = f;
+    }
+
+    bool manager::use_modular_psc() const {
+        return m_imp->m_use_modular_psc;
+    }
+
     small_object_allocator & manager::allocator() const {
         return m_imp->mm().allocator();
     }
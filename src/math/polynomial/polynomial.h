@@ -219,6 +219,13 @@ namespace polynomial {
         void set_zp(numeral const & p);
         void set_zp(uint64 p);
 
+        /**
+           \brief Compute resultants and principal subresultant coefficients over Z
+           by combining their images modulo several primes.
+        */
+        void set_modular_psc(bool f);
+        bool use_modular_psc() const;
+
         /**
            \brief Abstract event handler.
         */
@@ -393,17 +393,22 @@ namespace simplex {
         SASSERT(well_formed_row(row(r_i)));
 
         col_iterator it = M.col_begin(x_j), end = M.col_end(x_j);
-        scoped_numeral a_kj(m), g(m);
+        scoped_numeral a_kj(m), g(m), h(m), a_ij_h(m);
         for (; it != end; ++it) {
             row r_k = it.get_row();
             if (r_k.id() != r_i) {
                 a_kj = it.get_row_entry().m_coeff;
                 a_kj.neg();
-                M.mul(r_k, a_ij);
+                // scale by a_ij/h and a_kj/h for h = gcd(a_ij, a_kj) 
+                // to keep the coefficients of r_k small.
+                m.gcd(a_ij, a_kj, h);
+                m.div(a_ij, h, a_ij_h);
+                m.div(a_kj, h, a_kj);
+                M.mul(r_k, a_ij_h);
                 M.add(r_k, a_kj, row(r_i));
                 var_t s = m_row2base[r_k.id()];
                 numeral& coeff = m_vars[s].m_base_coeff;
-                m.mul(coeff, a_ij, coeff);
+                m.mul(coeff, a_ij_h, coeff);
                 M.gcd_normalize(r_k, g);
                 if (!m.is_one(g)) {
                     m.div(coeff, g, coeff);
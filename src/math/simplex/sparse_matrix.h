@@ -42,6 +42,7 @@ namespace simplex {
         
         struct stats {
             unsigned m_add_rows;
+            unsigned m_deferred_compress;
             stats() { reset(); }
             void reset() {
                 memset(this, 0, sizeof(*this));
@@ -110,14 +111,17 @@ namespace simplex {
            \brief A column stores in which rows a variable occurs.
            The column may have free/dead entries. The field m_first_free_idx
            is a reference to the first free/dead entry.
+           Columns are not compressed while they are traversed,
+           m_compress_pending records that compression was deferred.
         */
         struct column {
             svector<col_entry> m_entries;
             unsigned           m_size; 
             int                m_first_free_idx;
             mutable unsigned   m_refs;
+            bool               m_compress_pending;
             
-            column():m_size(0), m_first_free_idx(-1), m_refs(0) {}
+            column():m_size(0), m_first_free_idx(-1), m_refs(0), m_compress_pending(false) {}
             unsigned size() const { return m_size; }
             unsigned num_entries() const { return m_entries.size(); }
             void reset();
@@ -135,11 +139,13 @@ namespace simplex {
         vector<column>          m_columns;          // per var
         svector<int>            m_var_pos;          // temporary map from variables to positions in row
         unsigned_vector         m_var_pos_idx;      // indices in m_var_pos
+        unsigned_vector         m_pending_compress; // columns whose compression was deferred
         stats                   m_stats;
 
         bool well_formed_row(unsigned row_id) const;
         bool well_formed_column(unsigned column_id) const;
         void del_row_entry(_row& r, unsigned pos);
+        void compress_pending();
 
     public:
 
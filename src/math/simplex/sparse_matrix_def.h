@@ -167,8 +167,9 @@ namespace simplex {
     template<typename Ext>
     void sparse_matrix<Ext>::column::reset() {
         m_entries.reset();
-        m_size           = 0;
-        m_first_free_idx = -1;
+        m_size             = 0;
+        m_first_free_idx   = -1;
+        m_compress_pending = false;
     }
     
     /**
@@ -287,7 +288,7 @@ namespace simplex {
         m_columns.reset();
         m_var_pos.reset();
         m_var_pos_idx.reset();
-
+        m_pending_compress.reset();
     }
 
     template<typename Ext>
@@ -334,6 +335,9 @@ namespace simplex {
     template<typename Ext>
     void sparse_matrix<Ext>::add(row row1, numeral const& n, row row2) {
         m_stats.m_add_rows++;
+        if (!m_pending_compress.empty()) {
+            compress_pending();
+        }
         _row & r1 = m_rows[row1.id()];
         
         r1.save_var_pos(m_var_pos, m_var_pos_idx);
@@ -384,10 +388,8 @@ namespace simplex {
                     m.sub(r_entry.m_coeff, it->m_coeff, r_entry.m_coeff));
         }
         else {
-            scoped_numeral tmp(m);
             ADD_ROW(m.mul(r_entry.m_coeff, n, r_entry.m_coeff), 
-                    m.mul(it->m_coeff, n, tmp);
-                    m.add(r_entry.m_coeff, tmp, r_entry.m_coeff));
+                    m.addmul(r_entry.m_coeff, n, it->m_coeff, r_entry.m_coeff));
         }
         
         // reset m_var_pos:
@@ -408,6 +410,32 @@ namespace simplex {
         column & c  = m_columns[v];                   
         c.del_col_entry(col_idx);                           
         c.compress_if_needed(m_rows);                       
+        if (c.m_refs > 0 && !c.m_compress_pending && c.size() * 2 < c.num_entries()) {
+            // the column is being traversed, e.g., by a pivot step.
+            c.m_compress_pending = true;
+            m_pending_compress.push_back(v);
+            m_stats.m_deferred_compress++;
+        }
+    }
+
+    /**
+       \brief Compress columns whose compression was deferred 
+       because they were traversed when entries were deleted.
+    */
+    template<typename Ext>
+    void sparse_matrix<Ext>::compress_pending() {
+        unsigned j = 0;
+        for (unsigned i = 0; i < m_pending_compress.size(); ++i) {
+            var_t v = m_pending_compress[i];
+            column & c = m_columns[v];
+            if (c.m_refs > 0) {
+                m_pending_compress[j++] = v;
+                continue;
+            }
+            c.m_compress_pending = false;
+            c.compress_if_needed(m_rows);
+        }
+        m_pending_compress.shrink(j);
     }
 
     /**
@@ -448,6 +476,9 @@ namespace simplex {
     */    
     template<typename Ext>
     void sparse_matrix<Ext>::del(row r) {
+        if (!m_pending_compress.empty()) {
+            compress_pending();
+        }
         _row& rw = m_rows[r.id()];
         for (unsigned i = 0; i < rw.m_entries.size(); ++i) {
             _row_entry& e = rw.m_entries[i];
@@ -565,6 +596,7 @@ namespace simplex {
     template<typename Ext>
     void sparse_matrix<Ext>::collect_statistics(::statistics & st) const {
         st.update("simplex add rows", m_stats.m_add_rows);
+        st.update("simplex deferred compress", m_stats.m_deferred_compress);
     }
 
 
@@ -0,0 +1,790 @@
+/*++
+Copyright (c) 2017 Microsoft Corporation
+
+Module Name:
+
+    model_eval_program.cpp
+
+Abstract:
+
+    Evaluate a fixed set of expressions in many models.
+
+--*/
+#include "model/model_eval_program.h"
+#include "model/model_core.h"
+#include "model/model_evaluator.h"
+#include "model/model_evaluator_params.hpp"
+#include "ast/arith_decl_plugin.h"
+#include "ast/bv_decl_plugin.h"
+#include "util/obj_hashtable.h"
+#include "util/map.h"
+
+struct model_eval_program::imp {
+
+    enum opcode {
+        EP_BOOL,     // Boolean constant, m_p1 is its value
+        EP_NUM,      // numeral, m_p1 indexes m_numerals
+        EP_CONST,    // uninterpreted constant, its value is taken from the model
+        EP_EVAL,     // delegated to the model_evaluator
+        EP_NOT, EP_AND, EP_OR, EP_XOR, EP_IMPLIES, EP_ITE, EP_EQ, EP_DISTINCT,
+        EP_ADD, EP_SUB, EP_MUL, EP_UMINUS, EP_DIV, EP_IDIV, EP_MOD, EP_ABS,
+        EP_TO_REAL, EP_TO_INT, EP_IS_INT, EP_LE, EP_GE, EP_LT, EP_GT,
+        EP_BADD, EP_BSUB, EP_BMUL, EP_BNEG, EP_BAND, EP_BOR, EP_BXOR, EP_BNOT,
+        EP_UDIV, EP_UREM, EP_SHL, EP_LSHR, EP_ASHR,
+        EP_CONCAT, EP_EXTRACT, EP_ZERO_EXT, EP_SIGN_EXT, EP_BV2INT, EP_INT2BV,
+        EP_ULE, EP_UGE, EP_ULT, EP_UGT, EP_SLE, EP_SGE, EP_SLT, EP_SGT
+    };
+
+    enum sort_kind { S_BOOL, S_INT, S_REAL, S_BV, S_OTHER };
+
+    // kinds of values computed for an instruction
+    enum value_kind { V_BOOL, V_NUM, V_EXPR };
+
+    struct instr {
+        opcode        m_op;
+        sort_kind     m_sort;
+        expr *        m_expr;
+        unsigned      m_args;     // first argument in m_args
+        unsigned      m_num_args;
+        unsigned      m_p1;
+        unsigned      m_sz;       // size of bit-vector sorts
+        unsigned      m_mod;      // index of 2^m_sz in m_numerals
+        unsigned      m_half;     // index of 2^(m_sz-1) in m_numerals
+        instr(): m_op(EP_EVAL), m_sort(S_OTHER), m_expr(0), m_args(0), m_num_args(0), m_p1(0), m_sz(0), m_mod(0), m_half(0) {}
+    };
+
+    ast_manager &               m;
+    arith_util                  m_arith;
+    bv_util                     m_bv;
+    params_ref                  m_params;
+    bool                        m_model_completion;
+    expr_ref_vector             m_exprs;
+    expr_ref_vector             m_pinned;
+    svector<instr>              m_code;
+    unsigned_vector             m_args;
+    unsigned_vector             m_roots;
+    vector<rational>            m_numerals;
+    u_map<unsigned>             m_pow2;
+
+    // values of the current model, one per instruction
+    svector<unsigned char>      m_kind;
+    svector<bool>               m_bool;
+    vector<rational>            m_num;
+    expr_ref_vector             m_val;
+    scoped_ptr<model_evaluator> m_eval;
+    ptr_buffer<expr>            m_eval_args;
+
+    unsigned                    m_num_models;
+    unsigned                    m_num_native;
+    unsigned                    m_num_evals;
+
+    imp(ast_manager & m, unsigned num_exprs, expr * const * exprs, params_ref const & p):
+        m(m),
+        m_arith(m),
+        m_bv(m),
+        m_exprs(m),
+        m_pinned(m),
+        m_val(m),
+        m_num_models(0),
+        m_num_native(0),
+        m_num_evals(0) {
+        updt_params(p);
+        compile(num_exprs, exprs);
+    }
+
+    void updt_params(params_ref const & p) {
+        m_params = p;
+        m_model_completion = model_evaluator_params(p).completion();
+    }
+
+    // -----------------------------------
+    //
+    // Compilation
+    //
+    // -----------------------------------
+
+    unsigned mk_numeral(rational const & r) {
+        m_numerals.push_back(r);
+        return m_numerals.size() - 1;
+    }
+
+    unsigned mk_pow2(unsigned k) {
+        unsigned idx;
+        if (!m_pow2.find(k, idx)) {
+            idx = mk_numeral(rational::power_of_two(k));
+            m_pow2.insert(k, idx);
+        }
+        return idx;
+    }
+
+    void compile(unsigned num_exprs, expr * const * exprs) {
+        obj_map<expr, unsigned> slots;
+        ptr_buffer<expr> todo;
+        for (unsigned i = 0; i < num_exprs; ++i) {
+            m_exprs.push_back(exprs[i]);
+            todo.push_back(exprs[i]);
+            while (!todo.empty()) {
+                expr * e = todo.back();
+                if (slots.contains(e)) {
+                    todo.pop_back();
+                    continue;
+                }
+                bool visited = true;
+                if (is_app(e)) {
+                    for (expr * arg : *to_app(e)) {
+                        if (!slots.contains(arg)) {
+                            todo.push_back(arg);
+                            visited = false;
+                        }
+                    }
+                }
+                if (!visited) {
+                    continue;
+                }
+                todo.pop_back();
+                slots.insert(e, m_code.size());
+                mk_instr(e, slots);
+            }
+            m_roots.push_back(slots[exprs[i]]);
+        }
+        unsigned sz = m_code.size();
+        m_kind.resize(sz, V_EXPR);
+        m_bool.resize(sz, false);
+        m_num.resize(sz);
+        m_val.resize(sz);
+    }
+
+    void mk_instr(expr * e, obj_map<expr, unsigned> const & slots) {
+        instr c;
+        c.m_expr = e;
+        c.m_args = m_args.size();
+        sort * s = m.get_sort(e);
+        if (m.is_bool(s)) {
+            c.m_sort = S_BOOL;
+        }
+        else if (m_arith.is_int(s)) {
+            c.m_sort = S_INT;
+        }
+        else if (m_arith.is_real(s)) {
+            c.m_sort = S_REAL;
+        }
+        else if (m_bv.is_bv_sort(s)) {
+            c.m_sort = S_BV;
+            c.m_sz   = m_bv.get_bv_size(s);
+            c.m_mod  = mk_pow2(c.m_sz);
+            c.m_half = mk_pow2(c.m_sz - 1);
+        }
+        // quantifiers and variables are evaluated as a whole.
+        if (is_app(e)) {
+            for (expr * arg : *to_app(e)) {
+                m_args.push_back(slots.find(arg));
+            }
+            c.m_num_args = to_app(e)->get_num_args();
+            c.m_op = get_opcode(to_app(e), c);
+        }
+        m_pinned.push_back(e);
+        m_code.push_back(c);
+    }
+
+    opcode get_opcode(app * a, instr & c) {
+        func_decl * f = a->get_decl();
+        family_id fid = f->get_family_id();
+        decl_kind k   = f->get_decl_kind();
+        unsigned n    = a->get_num_args();
+        if (n == 0 && (fid == null_family_id || m.get_plugin(fid)->is_considered_uninterpreted(f))) {
+            return EP_CONST;
+        }
+        rational r;
+        if (fid == m.get_basic_family_id()) {
+            switch (k) {
+            case OP_TRUE:     c.m_p1 = 1; return EP_BOOL;
+            case OP_FALSE:    c.m_p1 = 0; return EP_BOOL;
+            case OP_NOT:      return EP_NOT;
+            case OP_AND:      return EP_AND;
+            case OP_OR:       return EP_OR;
+            case OP_XOR:      return n == 2 ? EP_XOR : EP_EVAL;
+            case OP_IMPLIES:  return n == 2 ? EP_IMPLIES : EP_EVAL;
+            case OP_ITE:      return EP_ITE;
+            case OP_EQ:
+            case OP_IFF:      return EP_EQ;
+            case OP_DISTINCT: return EP_DISTINCT;
+            default:          return EP_EVAL;
+            }
+        }
+        if (fid == m_arith.get_family_id()) {
+            switch (k) {
+            case OP_NUM:
+                if (!m_arith.is_numeral(a, r)) return EP_EVAL;
+                c.m_p1 = mk_numeral(r);
+                return EP_NUM;
+            case OP_ADD:     return EP_ADD;
+            case OP_SUB:     return EP_SUB;
+            case OP_MUL:     return EP_MUL;
+            case OP_UMINUS:  return EP_UMINUS;
+            case OP_DIV:     return EP_DIV;
+            case OP_IDIV:    return EP_IDIV;
+            case OP_MOD:     return EP_MOD;
+            case OP_ABS:     return EP_ABS;
+            case OP_TO_REAL: return EP_TO_REAL;
+            case OP_TO_INT:  return EP_TO_INT;
+            case OP_IS_INT:  return EP_IS_INT;
+            case OP_LE:      return EP_LE;
+            case OP_GE:      return EP_GE;
+            case OP_LT:      return EP_LT;
+            case OP_GT:      return EP_GT;
+            default:         return EP_EVAL;
+            }
+        }
+        if (fid == m_bv.get_family_id()) {
+            switch (k) {
+            case OP_BV_NUM: {
+                unsigned sz;
+                if (!m_bv.is_numeral(a, r, sz)) return EP_EVAL;
+                c.m_p1 = mk_numeral(r);
+                return EP_NUM;
+            }
+            case OP_BADD:     return EP_BADD;
+            case OP_BSUB:     return EP_BSUB;
+            case OP_BMUL:     return EP_BMUL;
+            case OP_BNEG:     return EP_BNEG;
+            case OP_BAND:     return EP_BAND;
+            case OP_BOR:      return EP_BOR;
+            case OP_BXOR:     return EP_BXOR;
+            case OP_BNOT:     return EP_BNOT;
+            case OP_BUDIV:
+            case OP_BUDIV_I:  return EP_UDIV;
+            case OP_BUREM:
+            case OP_BUREM_I:  return EP_UREM;
+            case OP_BSHL:     return EP_SHL;
+            case OP_BLSHR:    return EP_LSHR;
+            case OP_BASHR:    return EP_ASHR;
+            case OP_CONCAT:   return EP_CONCAT;
+            case OP_EXTRACT:
+                c.m_p1 = mk_pow2(m_bv.get_extract_low(f));
+                return EP_EXTRACT;
+            case OP_ZERO_EXT: return EP_ZERO_EXT;
+            case OP_SIGN_EXT: return EP_SIGN_EXT;
+            case OP_BV2INT:   return EP_BV2INT;
+            case OP_INT2BV:   return EP_INT2BV;
+            case OP_ULEQ:     return EP_ULE;
+            case OP_UGEQ:     return EP_UGE;
+            case OP_ULT:      return EP_ULT;
+            case OP_UGT:      return EP_UGT;
+            case OP_SLEQ:     return EP_SLE;
+            case OP_SGEQ:     return EP_SGE;
+            case OP_SLT:      return EP_SLT;
+            case OP_SGT:      return EP_SGT;
+            default:          return EP_EVAL;
+            }
+        }
+        return EP_EVAL;
+    }
+
+    // -----------------------------------
+    //
+    // Evaluation
+    //
+    // -----------------------------------
+
+    unsigned arg(instr const & c, unsigned i) const { return m_args[c.m_args + i]; }
+
+    bool args_are(instr const & c, value_kind k) const {
+        for (unsigned i = 0; i < c.m_num_args; ++i) {
+            if (m_kind[arg(c, i)] != k) return false;
+        }
+        return true;
+    }
+
+    rational const & num(instr const & c, unsigned i) const { return m_num[arg(c, i)]; }
+    bool bval(instr const & c, unsigned i) const { return m_bool[arg(c, i)]; }
+
+    void set_bool(unsigned i, bool b) {
+        m_kind[i] = V_BOOL;
+        m_bool[i] = b;
+        m_val.set(i, 0);
+    }
+
+    // m_num[i] has been assigned
+    void set_num(unsigned i) {
+        m_kind[i] = V_NUM;
+        m_val.set(i, 0);
+    }
+
+    void norm_bv(rational & r, instr const & c) const {
+        if (r.is_neg() || r >= m_numerals[c.m_mod]) {
+            r = mod(r, m_numerals[c.m_mod]);
+        }
+    }
+
+    void set_bv(unsigned i, instr const & c) {
+        norm_bv(m_num[i], c);
+        set_num(i);
+    }
+
+    void set_expr(unsigned i, expr * e) {
+        instr const & c = m_code[i];
+        m_val.set(i, e);
+        if (m.is_true(e)) {
+            m_kind[i] = V_BOOL;
+            m_bool[i] = true;
+        }
+        else if (m.is_false(e)) {
+            m_kind[i] = V_BOOL;
+            m_bool[i] = false;
+        }
+        else if (c.m_sort == S_BV) {
+            unsigned sz;
+            m_kind[i] = m_bv.is_numeral(e, m_num[i], sz) ? V_NUM : V_EXPR;
+        }
+        else if (c.m_sort == S_INT || c.m_sort == S_REAL) {
+            m_kind[i] = m_arith.is_numeral(e, m_num[i]) ? V_NUM : V_EXPR;
+        }
+        else {
+            m_kind[i] = V_EXPR;
+        }
+    }
+
+    void copy(unsigned i, unsigned j) {
+        m_kind[i] = m_kind[j];
+        m_bool[i] = m_bool[j];
+        if (m_kind[j] == V_NUM) {
+            m_num[i] = m_num[j];
+        }
+        m_val.set(i, m_val.get(j));
+    }
+
+    expr * value(unsigned i) {
+        expr * v = m_val.get(i);
+        if (v == 0) {
+            instr const & c = m_code[i];
+            if (m_kind[i] == V_BOOL) {
+                v = m_bool[i] ? m.mk_true() : m.mk_false();
+            }
+            else if (c.m_sort == S_BV) {
+                v = m_bv.mk_numeral(m_num[i], c.m_sz);
+            }
+            else {
+                v = m_arith.mk_numeral(m_num[i], c.m_sort == S_INT);
+            }
+            m_val.set(i, v);
+        }
+        return v;
+    }
+
+    rational to_signed(instr const & c, unsigned i) const {
+        instr const & a = m_code[arg(c, i)];
+        rational const & r = num(c, i);
+        return r >= m_numerals[a.m_half] ? r - m_numerals[a.m_mod] : r;
+    }
+
+    void eval(unsigned i, model_core & md) {
+        instr const & c = m_code[i];
+        if (!m_eval) {
+            m_eval = alloc(model_evaluator, md, m_params);
+            m_eval->set_model_completion(m_model_completion);
+        }
+        expr_ref r(m);
+        m_eval_args.reset();
+        for (unsigned j = 0; j < c.m_num_args; ++j) {
+            expr * v = value(arg(c, j));
+            if (!m.is_value(v)) {
+                break;
+            }
+            m_eval_args.push_back(v);
+        }
+        if (c.m_num_args > 0 && m_eval_args.size() == c.m_num_args) {
+            app_ref t(m.mk_app(to_app(c.m_expr)->get_decl(), m_eval_args.size(), m_eval_args.c_ptr()), m);
+            (*m_eval)(t, r);
+        }
+        else {
+            // The simplified form of a term with arguments that are not values
+            // depends on the shape of the arguments. Evaluate the original term,
+            // the evaluator caches its subterms between calls.
+            (*m_eval)(c.m_expr, r);
+        }
+        m_num_evals++;
+        set_expr(i, r);
+    }
+
+    void eval_const(unsigned i, model_core & md) {
+        instr const & c = m_code[i];
+        func_decl * f = to_app(c.m_expr)->get_decl();
+        expr * v = md.get_const_interp(f);
+        if (v == 0) {
+            if (m_model_completion) {
+                v = md.get_some_value(f->get_range());
+                md.register_decl(f, v);
+            }
+            else {
+                v = c.m_expr;
+            }
+        }
+        set_expr(i, v);
+    }
+
+    // Evaluate the equality of the values of a and b, return false if it cannot be decided natively.
+    bool eval_eq(unsigned a, unsigned b, bool & r) {
+        if (m_kind[a] == V_NUM && m_kind[b] == V_NUM) {
+            r = m_num[a] == m_num[b];
+            return true;
+        }
+        if (m_kind[a] == V_BOOL && m_kind[b] == V_BOOL) {
+            r = m_bool[a] == m_bool[b];
+            return true;
+        }
+        expr * va = value(a);
+        expr * vb = value(b);
+        if (va == vb) {
+            r = true;
+            return true;
+        }
+        if (m.are_distinct(va, vb)) {
+            r = false;
+            return true;
+        }
+        return false;
+    }
+
+    // Evaluate instruction i natively, return false if the arguments are not suitable.
+    bool eval_native(unsigned i, model_core & md) {
+        instr const & c = m_code[i];
+        unsigned n = c.m_num_args;
+        rational & r = m_num[i];
+        bool b;
+        switch (c.m_op) {
+        case EP_BOOL:
+            m_kind[i] = V_BOOL;
+            m_bool[i] = c.m_p1 != 0;
+            m_val.set(i, c.m_expr);
+            return true;
+        case EP_NUM:
+            m_kind[i] = V_NUM;
+            m_num[i] = m_numerals[c.m_p1];
+            m_val.set(i, c.m_expr);
+            return true;
+        case EP_CONST:
+            eval_const(i, md);
+            return true;
+        case EP_EVAL:
+            return false;
+        case EP_NOT:
+            if (!args_are(c, V_BOOL)) return false;
+            set_bool(i, !bval(c, 0));
+            return true;
+        case EP_AND:
+            if (!args_are(c, V_BOOL)) return false;
+            b = true;
+            for (unsigned j = 0; b && j < n; ++j) b = bval(c, j);
+            set_bool(i, b);
+            return true;
+        case EP_OR:
+            if (!args_are(c, V_BOOL)) return false;
+            b = false;
+            for (unsigned j = 0; !b && j < n; ++j) b = bval(c, j);
+            set_bool(i, b);
+            return true;
+        case EP_XOR:
+            if (!args_are(c, V_BOOL)) return false;
+            set_bool(i, bval(c, 0) != bval(c, 1));
+            return true;
+        case EP_IMPLIES:
+            if (!args_are(c, V_BOOL)) return false;
+            set_bool(i, !bval(c, 0) || bval(c, 1));
+            return true;
+        case EP_ITE:
+            if (m_kind[arg(c, 0)] != V_BOOL) return false;
+            copy(i, arg(c, bval(c, 0) ? 1 : 2));
+            return true;
+        case EP_EQ:
+            if (!eval_eq(arg(c, 0), arg(c, 1), b)) return false;
+            set_bool(i, b);
+            return true;
+        case EP_DISTINCT:
+            if (!args_are(c, V_NUM) && !args_are(c, V_BOOL)) return false;
+            b = true;
+            for (unsigned j = 0; b && j < n; ++j) {
+                for (unsigned k = j + 1; b && k < n; ++k) {
+                    bool eq = false;
+                    eval_eq(arg(c, j), arg(c, k), eq);
+                    b = !eq;
+                }
+            }
+            set_bool(i, b);
+            return true;
+        default:
+            break;
+        }
+        if (!args_are(c, V_NUM)) {
+            return false;
+        }
+        switch (c.m_op) {
+        case EP_ADD:
+            r = num(c, 0);
+            for (unsigned j = 1; j < n; ++j) r += num(c, j);
+            set_num(i);
+            return true;
+        case EP_SUB:
+            r = num(c, 0);
+            for (unsigned j = 1; j < n; ++j) r -= num(c, j);
+            set_num(i);
+            return true;
+        case EP_MUL:
+            r = num(c, 0);
+            for (unsigned j = 1; j < n; ++j) r *= num(c, j);
+            set_num(i);
+            return true;
+        case EP_UMINUS:
+            r = -num(c, 0);
+            set_num(i);
+            return true;
+        case EP_DIV:
+            if (num(c, 1).is_zero()) return false;
+            r = num(c, 0) / num(c, 1);
+            set_num(i);
+            return true;
+        case EP_IDIV:
+            if (num(c, 1).is_zero()) return false;
+            r = div(num(c, 0), num(c, 1));
+            set_num(i);
+            return true;
+        case EP_MOD:
+            if (num(c, 1).is_zero()) return false;
+            r = mod(num(c, 0), num(c, 1));
+            set_num(i);
+            return true;
+        case EP_ABS:
+            r = abs(num(c, 0));
+            set_num(i);
+            return true;
+        case EP_TO_REAL:
+            r = num(c, 0);
+            set_num(i);
+            return true;
+        case EP_TO_INT:
+            r = floor(num(c, 0));
+            set_num(i);
+            return true;
+        case EP_IS_INT:
+            set_bool(i, num(c, 0).is_int());
+            return true;
+        case EP_LE: set_bool(i, num(c, 0) <= num(c, 1)); return true;
+        case EP_GE: set_bool(i, num(c, 0) >= num(c, 1)); return true;
+        case EP_LT: set_bool(i, num(c, 0) < num(c, 1)); return true;
+        case EP_GT: set_bool(i, num(c, 0) > num(c, 1)); return true;
+        case EP_BADD:
+            r = num(c, 0);
+            for (unsigned j = 1; j < n; ++j) r += num(c, j);
+            set_bv(i, c);
+            return true;
+        case EP_BSUB:
+            r = num(c, 0) - num(c, 1);
+            set_bv(i, c);
+            return true;
+        case EP_BMUL:
+            r = num(c, 0);
+            for (unsigned j = 1; j < n; ++j) {
+                r *= num(c, j);
+                norm_bv(r, c);
+            }
+            set_num(i);
+            return true;
+        case EP_BNEG:
+            r = -num(c, 0);
+            set_bv(i, c);
+            return true;
+        case EP_BAND:
+            r = num(c, 0);
+            for (unsigned j = 1; j < n; ++j) r = bitwise_and(r, num(c, j));
+            set_num(i);
+            return true;
+        case EP_BOR:
+            r = num(c, 0);
+            for (unsigned j = 1; j < n; ++j) r = bitwise_or(r, num(c, j));
+            set_num(i);
+            return true;
+        case EP_BXOR:
+            r = num(c, 0);
+            for (unsigned j = 1; j < n; ++j) r = bitwise_xor(r, num(c, j));
+            set_num(i);
+            return true;
+        case EP_BNOT:
+            r = m_numerals[c.m_mod] - num(c, 0) - rational::one();
+            set_num(i);
+            return true;
+        case EP_UDIV:
+            if (num(c, 1).is_zero()) return false;
+            r = div(num(c, 0), num(c, 1));
+            set_num(i);
+            return true;
+        case EP_UREM:
+            if (num(c, 1).is_zero()) return false;
+            r = mod(num(c, 0), num(c, 1));
+            set_num(i);
+            return true;
+        case EP_SHL:
+            if (num(c, 1) >= rational(c.m_sz)) {
+                r.reset();
+            }
+            else {
+                r = num(c, 0) * rational::power_of_two(num(c, 1).get_unsigned());
+                norm_bv(r, c);
+            }
+            set_num(i);
+            return true;
+        case EP_LSHR:
+            if (num(c, 1) >= rational(c.m_sz)) {
+                r.reset();
+            }
+            else {
+                r = div(num(c, 0), rational::power_of_two(num(c, 1).get_unsigned()));
+            }
+            set_num(i);
+            return true;
+        case EP_ASHR: {
+            bool neg = num(c, 0) >= m_numerals[c.m_half];
+            rational const & ones = m_numerals[c.m_mod];
+            if (num(c, 1) >= rational(c.m_sz)) {
+                r = neg ? ones - rational::one() : rational::zero();
+            }
+            else if (neg) {
+                // ~((~a) >> b)
+                r = ones - rational::one() - div(ones - rational::one() - num(c, 0), rational::power_of_two(num(c, 1).get_unsigned()));
+            }
+            else {
+                r = div(num(c, 0), rational::power_of_two(num(c, 1).get_unsigned()));
+            }
+            set_num(i);
+            return true;
+        }
+        case EP_CONCAT:
+            r = num(c, 0);
+            for (unsigned j = 1; j < n; ++j) {
+                r *= m_numerals[m_code[arg(c, j)].m_mod];
+                r += num(c, j);
+            }
+            set_num(i);
+            return true;
+        case EP_EXTRACT:
+            r = div(num(c, 0), m_numerals[c.m_p1]);
+            set_bv(i, c);
+            return true;
+        case EP_ZERO_EXT:
+            r = num(c, 0);
+            set_num(i);
+            return true;
+        case EP_SIGN_EXT: {
+            instr const & a = m_code[arg(c, 0)];
+            r = num(c, 0);
+            if (r >= m_numerals[a.m_half]) {
+                r += m_numerals[c.m_mod] - m_numerals[a.m_mod];
+            }
+            set_num(i);
+            return true;
+        }
+        case EP_BV2INT:
+            r = num(c, 0);
+            set_num(i);
+            return true;
+        case EP_INT2BV:
+            r = num(c, 0);
+            set_bv(i, c);
+            return true;
+        case EP_ULE: set_bool(i, num(c, 0) <= num(c, 1)); return true;
+        case EP_UGE: set_bool(i, num(c, 0) >= num(c, 1)); return true;
+        case EP_ULT: set_bool(i, num(c, 0) < num(c, 1)); return true;
+        case EP_UGT: set_bool(i, num(c, 0) > num(c, 1)); return true;
+        case EP_SLE: set_bool(i, to_signed(c, 0) <= to_signed(c, 1)); return true;
+        case EP_SGE: set_bool(i, to_signed(c, 0) >= to_signed(c, 1)); return true;
+        case EP_SLT: set_bool(i, to_signed(c, 0) < to_signed(c, 1)); return true;
+        case EP_SGT: set_bool(i, to_signed(c, 0) > to_signed(c, 1)); return true;
+        default:
+            return false;
+        }
+    }
+
+    void run(model_core & md, expr_ref_vector & result) {
+        if (m.canceled()) {
+            throw model_evaluator_exception(m.limit().get_cancel_msg());
+        }
+        m_eval = 0;
+        unsigned sz = m_code.size();
+        for (unsigned i = 0; i < sz; ++i) {
+            if (eval_native(i, md)) {
+                m_num_native++;
+            }
+            else {
+                eval(i, md);
+            }
+        }
+        for (unsigned r : m_roots) {
+            result.push_back(value(r));
+        }
+        m_eval = 0;
+        m_num_models++;
+    }
+
+    void collect_statistics(statistics & st) const {
+        st.update("eval program instructions", m_code.size());
+        st.update("eval program models", m_num_models);
+        st.update("eval program native", m_num_native);
+        st.update("eval program evaluator calls", m_num_evals);
+    }
+
+    void reset_statistics() {
+        m_num_models = 0;
+        m_num_native = 0;
+        m_num_evals  = 0;
+    }
+};
+
+model_eval_program::model_eval_program(ast_manager & m, unsigned num_exprs, expr * const * exprs, params_ref const & p) {
+    m_imp = alloc(imp, m, num_exprs, exprs, p);
+}
+
+model_eval_program::~model_eval_program() {
+    dealloc(m_imp);
+}
+
+ast_manager & model_eval_program::m() const {
+    return m_imp->m;
+}
+
+unsigned model_eval_program::size() const {
+    return m_imp->m_exprs.size();
+}
+
+expr * model_eval_program::get_expr(unsigned i) const {
+    return m_imp->m_exprs.get(i);
+}
+
+unsigned model_eval_program::get_num_instructions() const {
+    return m_imp->m_code.size();
+}
+
+void model_eval_program::set_model_completion(bool f) {
+    m_imp->m_model_completion = f;
+}
+
+void model_eval_program::updt_params(params_ref const & p) {
+    m_imp->updt_params(p);
+}
+
+void model_eval_program::operator()(model_core & md, expr_ref_vector & result) {
+    result.reset();
+    m_imp->run(md, result);
+}
+
+void model_eval_program::operator()(unsigned num_models, model_core * const * mds, expr_ref_vector & result) {
+    result.reset();
+    for (unsigned j = 0; j < num_models; ++j) {
+        m_imp->run(*mds[j], result);
+    }
+}
+
+void model_eval_program::collect_statistics(statistics & st) const {
+    m_imp->collect_statistics(st);
+}
+
+void model_eval_program::reset_statistics() {
+    m_imp->reset_statistics();
+}
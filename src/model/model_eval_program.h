@@ -0,0 +1,73 @@
+/*++
+Copyright (c) 2017 Microsoft Corporation
+
+Module Name:
+
+    model_eval_program.h
+
+Abstract:
+
+    Evaluate a fixed set of expressions in many models.
+
+    The expressions are compiled once into a flat program: one
+    instruction per distinct subterm, in topological order. Evaluating
+    the program in a model is a single pass over the instructions.
+    Boolean, arithmetic and bit-vector operations on values are
+    computed directly on rationals; other operations, and operations
+    on arguments that have no value in the model, are delegated to
+    the model_evaluator.
+
+Notes:
+
+    The results coincide with the ones of model_evaluator on each
+    expression.
+
+--*/
+#ifndef MODEL_EVAL_PROGRAM_H_
+#define MODEL_EVAL_PROGRAM_H_
+
+#include "ast/ast.h"
+#include "util/params.h"
+#include "util/statistics.h"
+
+class model_core;
+
+class model_eval_program {
+    struct imp;
+    imp *  m_imp;
+public:
+    model_eval_program(ast_manager & m, unsigned num_exprs, expr * const * exprs, params_ref const & p = params_ref());
+    ~model_eval_program();
+
+    ast_manager & m() const;
+
+    /**
+       \brief Number of compiled expressions.
+    */
+    unsigned size() const;
+    expr * get_expr(unsigned i) const;
+
+    /**
+       \brief Number of instructions, i.e., distinct subterms of the compiled expressions.
+    */
+    unsigned get_num_instructions() const;
+
+    void set_model_completion(bool f);
+    void updt_params(params_ref const & p);
+
+    /**
+       \brief Store in \c result the values of the compiled expressions in \c md.
+    */
+    void operator()(model_core & md, expr_ref_vector & result);
+
+    /**
+       \brief Evaluate the compiled expressions in each of the models \c mds.
+       The values for mds[j] are stored in result[j*size()], ..., result[(j+1)*size() - 1].
+    */
+    void operator()(unsigned num_models, model_core * const * mds, expr_ref_vector & result);
+
+    void collect_statistics(statistics & st) const;
+    void reset_statistics();
+};
+
+#endif
@@ -22,6 +22,7 @@ Notes:
 
 
 #include <sstream>
+#include <fstream>
 #include <iomanip>
 
 #include "muz/base/dl_util.h"
@@ -32,6 +33,7 @@ Notes:
 #include "muz/spacer/spacer_prop_solver.h"
 #include "muz/spacer/spacer_context.h"
 #include "muz/spacer/spacer_generalizers.h"
+#include "muz/spacer/spacer_marshal.h"
 #include "ast/for_each_expr.h"
 #include "muz/base/dl_rule_set.h"
 #include "smt/tactic/unit_subsumption_tactic.h"
@@ -48,6 +50,7 @@ Notes:
 
 #include "util/timeit.h"
 #include "util/luby.h"
+#include "util/scoped_ptr_vector.h"
 #include "ast/rewriter/expr_safe_replace.h"
 #include "ast/expr_abstract.h"
 
@@ -816,6 +819,45 @@ bool pred_transformer::check_inductive(unsigned level, expr_ref_vector& state,
     return res == l_false;
 }
 
+bool pred_transformer::filter_candidates(decl2lemmas const& cands)
+{
+    expr_ref_vector* mine = 0;
+    if (!cands.find(head(), mine) || mine->empty()) { return false; }
+
+    smt::kernel solver(m, pm.fparams2());
+    solver.assert_expr(pm.get_background());
+    solver.assert_expr(m_transition);
+    solver.assert_expr(m_extend_lit);
+
+    // -- assume candidates of all predecessors
+    expr_ref_vector fmls(m);
+    decl2lemmas::iterator it = cands.begin(), end = cands.end();
+    for (; it != end; ++it) {
+        expr_ref_vector const& lemmas = *it->m_value;
+        for (unsigned i = 0; i < lemmas.size(); ++i) {
+            mk_assumptions(it->m_key, lemmas.get(i), fmls);
+        }
+    }
+    for (unsigned i = 0; i < fmls.size(); ++i) {
+        solver.assert_expr(fmls.get(i));
+    }
+
+    bool removed = false;
+    for (unsigned i = 0; i < mine->size();) {
+        solver.push();
+        solver.assert_expr(m.mk_not(mine->get(i)));
+        lbool res = solver.check();
+        solver.pop(1);
+        TRACE("spacer", tout << "candidate: " << mk_pp(mine->get(i), m)
+              << " is " << res << "\n";);
+        if (res == l_false) { ++i; continue; }
+        mine->set(i, mine->back());
+        mine->pop_back();
+        removed = true;
+    }
+    return removed;
+}
+
 void pred_transformer::mk_assumptions(func_decl* head, expr* fml,
                                       expr_ref_vector& result)
 {
@@ -2034,6 +2076,137 @@ void context::add_cover(int level, func_decl* p, expr* property)
 void context::add_invariant (func_decl *p, expr *property)
 {add_cover (infty_level(), p, property);}
 
+/**
+   Lemmas are stored as an SMT2 script of assertions of the form
+     (forall ((x1 S1) ... (xn Sn)) (=> (P x1 ... xn) lemma))
+   one for every lemma of every predicate. On import, the candidates are
+   filtered Houdini-style until the remaining ones are mutually inductive,
+   and the survivors are added as invariants.
+*/
+void context::export_lemmas(char const* file)
+{
+    unsigned lvl = m_last_result == l_false ? m_inductive_lvl : infty_level();
+    expr_ref_vector fmls(m), lemmas(m);
+    app_ref_vector vars(m);
+    expr_ref fml(m);
+    decl2rel::iterator it = m_rels.begin(), end = m_rels.end();
+    for (; it != end; ++it) {
+        pred_transformer& pt = *it->m_value;
+        if (pt.head() == m_query_pred) { continue; }
+        lemmas.reset();
+        lemmas.push_back(pt.get_formulas(lvl, false));
+        flatten_and(lemmas);
+        vars.reset();
+        for (unsigned i = 0; i < pt.sig_size(); ++i) {
+            vars.push_back(m.mk_const(m_pm.o2n(pt.sig(i), 0)));
+        }
+        for (unsigned i = 0; i < lemmas.size(); ++i) {
+            if (m.is_true(lemmas.get(i))) { continue; }
+            fml = m.mk_implies(m.mk_app(pt.head(), vars.size(),
+                                        (expr* const*)vars.c_ptr()),
+                               lemmas.get(i));
+            if (!vars.empty()) {
+                fml = mk_forall(m, vars.size(), vars.c_ptr(), fml);
+            }
+            fmls.push_back(fml);
+        }
+    }
+
+    std::ofstream out(file);
+    if (!out) {
+        IF_VERBOSE(1, verbose_stream() << "could not open " << file << "\n";);
+        return;
+    }
+    fml = mk_and(fmls);
+    marshal(out, fml, m);
+    IF_VERBOSE(1, verbose_stream() << "(spacer.export-lemmas :lemmas "
+               << fmls.size() << ")\n";);
+}
+
+void context::import_lemmas(char const* file)
+{
+    scoped_watch _w_(m_import_lemmas_watch);
+    std::ifstream in(file);
+    if (!in) {
+        IF_VERBOSE(1, verbose_stream() << "could not open " << file << "\n";);
+        return;
+    }
+    expr_ref_vector fmls(m);
+    fmls.push_back(unmarshal(in, m));
+    if (!fmls.get(0)) {
+        IF_VERBOSE(1, verbose_stream() << "could not parse " << file << "\n";);
+        return;
+    }
+    flatten_and(fmls);
+
+    // -- collect candidates, over the signature constants of each predicate
+    decl2lemmas cands;
+    scoped_ptr_vector<expr_ref_vector> pinned;
+    unsigned num_cands = 0;
+    var_subst vs(m, false);
+    expr_ref_vector sub(m);
+    expr_ref lemma(m);
+    for (unsigned i = 0; i < fmls.size(); ++i) {
+        expr *body = fmls.get(i), *head, *l;
+        unsigned num_vars = 0;
+        if (is_forall(body)) {
+            num_vars = to_quantifier(body)->get_num_decls();
+            body = to_quantifier(body)->get_expr();
+        }
+        pred_transformer* pt = 0;
+        if (!m.is_implies(body, head, l) || !is_app(head) ||
+            !m_rels.find(to_app(head)->get_decl(), pt) ||
+            pt->sig_size() != num_vars) {
+            continue;
+        }
+        sub.reset();
+        sub.resize(num_vars);
+        bool ok = true;
+        for (unsigned j = 0; ok && j < num_vars; ++j) {
+            expr* arg = to_app(head)->get_arg(j);
+            unsigned idx = is_var(arg) ? to_var(arg)->get_idx() : num_vars;
+            ok = idx < num_vars && !sub.get(idx);
+            if (ok) { sub[idx] = m.mk_const(m_pm.o2n(pt->sig(j), 0)); }
+        }
+        if (!ok) { continue; }
+        vs(l, sub.size(), sub.c_ptr(), lemma);
+
+        expr_ref_vector* lemmas = 0;
+        if (!cands.find(pt->head(), lemmas)) {
+            lemmas = alloc(expr_ref_vector, m);
+            pinned.push_back(lemmas);
+            cands.insert(pt->head(), lemmas);
+        }
+        lemmas->push_back(lemma);
+        ++num_cands;
+    }
+
+    // -- drop candidates until the rest is inductive
+    bool removed = true;
+    while (removed) {
+        checkpoint();
+        removed = false;
+        decl2rel::iterator it = m_rels.begin(), end = m_rels.end();
+        for (; it != end; ++it) {
+            removed = it->m_value->filter_candidates(cands) || removed;
+        }
+    }
+
+    unsigned num_imported = 0;
+    decl2lemmas::iterator it = cands.begin(), end = cands.end();
+    for (; it != end; ++it) {
+        pred_transformer& pt = get_pred_transformer(it->m_key);
+        expr_ref_vector const& lemmas = *it->m_value;
+        for (unsigned i = 0; i < lemmas.size(); ++i) {
+            pt.add_lemma(lemmas.get(i), infty_level());
+        }
+        num_imported += lemmas.size();
+    }
+    m_stats.m_num_imported_lemmas += num_imported;
+    IF_VERBOSE(1, verbose_stream() << "(spacer.import-lemmas :candidates "
+               << num_cands << " :inductive " << num_imported << ")\n";);
+}
+
 expr_ref context::get_reachable(func_decl *p)
 {
     pred_transformer* pt = 0;
@@ -2152,6 +2325,9 @@ void context::init_lemma_generalizers(datalog::rule_set& rules)
     fparams.m_dump_benchmarks = m_params.spacer_vs_dump_benchmarks();
     fparams.m_dump_min_time = m_params.spacer_vs_dump_min_time();
     fparams.m_dump_recheck = m_params.spacer_vs_recheck();
+    fparams.m_max_shared_context_size = m_params.spacer_vs_max_context_size();
+    m_pm.fparams2().m_max_shared_context_size = fparams.m_max_shared_context_size;
+    m_pm.fparams3().m_max_shared_context_size = fparams.m_max_shared_context_size;
 
     fparams.m_mbqi = m_params.spacer_mbqi();
 
@@ -2206,6 +2382,9 @@ lbool context::solve(unsigned from_lvl)
 {
     m_last_result = l_undef;
     try {
+        if (m_params.spacer_lemmas_import().size()) {
+            import_lemmas(m_params.spacer_lemmas_import().bare_str());
+        }
         m_last_result = solve_core (from_lvl);
         if (m_last_result == l_false) {
             simplify_formulas();
@@ -2235,6 +2414,10 @@ lbool context::solve(unsigned from_lvl)
         m_stats.m_cex_depth = get_cex_depth ();
     }
 
+    if (m_params.spacer_lemmas_export().size()) {
+        export_lemmas(m_params.spacer_lemmas_export().bare_str());
+    }
+
     if (m_params.print_statistics ()) {
         statistics st;
         collect_statistics (st);
@@ -3318,8 +3501,10 @@ void context::collect_statistics(statistics& st) const
     st.update("SPACER expand node undef", m_stats.m_expand_node_undef);
     st.update("SPACER num lemmas", m_stats.m_num_lemmas);
     st.update("SPACER restarts", m_stats.m_num_restarts);
+    st.update("SPACER num imported lemmas", m_stats.m_num_imported_lemmas);
 
     st.update ("time.spacer.init_rules", m_init_rules_watch.get_seconds ());
+    st.update ("time.spacer.import_lemmas", m_import_lemmas_watch.get_seconds ());
     st.update ("time.spacer.solve", m_solve_watch.get_seconds ());
     st.update ("time.spacer.solve.propagate", m_propagate_watch.get_seconds ());
     st.update ("time.spacer.solve.reach", m_reach_watch.get_seconds ());
@@ -3356,6 +3541,7 @@ void context::reset_statistics()
     }
 
     m_init_rules_watch.reset ();
+    m_import_lemmas_watch.reset ();
     m_solve_watch.reset ();
     m_propagate_watch.reset ();
     m_reach_watch.reset ();
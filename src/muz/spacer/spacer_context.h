@@ -48,6 +48,7 @@ class context;
 
 typedef obj_map<datalog::rule const, app_ref_vector*> rule2inst;
 typedef obj_map<func_decl, pred_transformer*> decl2rel;
+typedef obj_map<func_decl, expr_ref_vector*> decl2lemmas;
 
 class pob;
 typedef ref<pob> pob_ref;
@@ -400,6 +401,10 @@ public:
                       unsigned& solver_level, expr_ref_vector* core = 0);
     bool check_inductive(unsigned level, expr_ref_vector& state,
                          unsigned& assumes_level);
+    /// \brief Removes candidate lemmas of this predicate that are not
+    /// inductive relative to the candidates of its predecessors.
+    /// Returns true if some candidate was removed.
+    bool filter_candidates(decl2lemmas const& cands);
 
     expr_ref get_formulas(unsigned level, bool add_axioms);
 
@@ -682,6 +687,7 @@ class context {
         unsigned m_expand_node_undef;
         unsigned m_num_lemmas;
         unsigned m_num_restarts;
+        unsigned m_num_imported_lemmas;
         stats() { reset(); }
         void reset() { memset(this, 0, sizeof(*this)); }
     };
@@ -693,6 +699,7 @@ class context {
     stopwatch m_is_reach_watch;
     stopwatch m_create_children_watch;
     stopwatch m_init_rules_watch;
+    stopwatch m_import_lemmas_watch;
 
     fixedpoint_params const&    m_params;
     ast_manager&         m;
@@ -740,6 +747,11 @@ class context {
     // Initialization
     void init_lemma_generalizers(datalog::rule_set& rules);
 
+    // Warm-start: lemmas are exported after a query and re-imported as
+    // candidates that are checked for inductiveness before the next one
+    void import_lemmas(char const* file);
+    void export_lemmas(char const* file);
+
     bool check_invariant(unsigned lvl);
     bool check_invariant(unsigned lvl, func_decl* fn);
 
@@ -52,17 +52,23 @@ virtual_solver* smt_context_manager::mk_fresh()
     ++m_num_contexts;
     virtual_solver_factory *solver_factory = 0;
 
-    if (m_max_num_contexts == 0 || m_solvers.size() < m_max_num_contexts) {
-        m_solvers.push_back(alloc(spacer::virtual_solver_factory, m, m_fparams));
-        solver_factory = m_solvers.back();
-    } else
+    if (m_max_num_contexts == 0 || m_solvers.size() < m_max_num_contexts)
+    { solver_factory = mk_factory(); }
+    else
     { solver_factory = m_solvers[(m_num_contexts - 1) % m_max_num_contexts]; }
 
     return solver_factory->mk_solver();
 }
 
+virtual_solver_factory* smt_context_manager::mk_factory()
+{
+    m_solvers.push_back(alloc(spacer::virtual_solver_factory, m, m_fparams, this));
+    return m_solvers.back();
+}
+
 void smt_context_manager::collect_statistics(statistics& st) const
 {
+    st.update("virtual_solver.contexts", m_solvers.size());
     for (unsigned i = 0; i < m_solvers.size(); ++i) {
         m_solvers[i]->collect_statistics(st);
     }
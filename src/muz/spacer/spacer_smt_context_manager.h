@@ -54,6 +54,8 @@ public:
 
     ~smt_context_manager();
     virtual_solver* mk_fresh();
+    /// \brief creates a factory on top of a fresh smt::kernel
+    virtual_solver_factory* mk_factory();
 
     void collect_statistics(statistics& st) const;
     void reset_statistics();
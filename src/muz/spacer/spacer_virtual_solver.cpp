@@ -18,6 +18,7 @@ Notes:
 --*/
 
 #include "muz/spacer/spacer_virtual_solver.h"
+#include "muz/spacer/spacer_smt_context_manager.h"
 #include "ast/ast_util.h"
 #include "ast/ast_pp_util.h"
 #include "muz/spacer/spacer_util.h"
@@ -31,9 +32,9 @@ namespace spacer {
 virtual_solver::virtual_solver(virtual_solver_factory &factory,
                                smt::kernel &context, app* pred) :
     solver_na2as(context.m()),
-    m_factory(factory),
+    m_factory(&factory),
     m(context.m()),
-    m_context(context),
+    m_context(&context),
     m_pred(pred, m),
     m_virtual(!m.is_true(pred)),
     m_assertions(m),
@@ -59,7 +60,7 @@ virtual_solver::~virtual_solver()
 
     if (m_virtual) {
         m_pred = m.mk_not(m_pred);
-        m_context.assert_expr(m_pred);
+        m_context->assert_expr(m_pred);
     }
 }
 
@@ -234,11 +235,11 @@ public:
 
 proof *virtual_solver::get_proof()
 {
-    scoped_watch _t_(m_factory.m_proof_watch);
+    scoped_watch _t_(m_factory->m_proof_watch);
 
     if (!m_proof.get()) {
         elim_aux_assertions pc(m_pred);
-        m_proof = m_context.get_proof();
+        m_proof = m_context->get_proof();
         pc(m, m_proof.get(), m_proof);
     }
     return m_proof.get();
@@ -252,8 +253,10 @@ lbool virtual_solver::check_sat_core(unsigned num_assumptions,
 {
     SASSERT(!m_pushed || get_scope_level() > 0);
     m_proof.reset();
-    scoped_watch _t_(m_factory.m_check_watch);
-    m_factory.m_stats.m_num_smt_checks++;
+    maybe_migrate();
+    scoped_watch _t_(m_factory->m_check_watch);
+    m_factory->m_stats.m_num_smt_checks++;
+    m_stats.m_num_smt_checks++;
 
     stopwatch sw;
     sw.start();
@@ -268,25 +271,28 @@ lbool virtual_solver::check_sat_core(unsigned num_assumptions,
 
         std::ofstream out(file_name.str().c_str());
 
-        to_smt2_benchmark(out, m_context, num_assumptions, assumptions,
+        to_smt2_benchmark(out, *m_context, num_assumptions, assumptions,
                           "virt_solver");
 
         out << "(exit)\n";
         out.close();
     }
-    lbool res = m_context.check(num_assumptions, assumptions);
+    lbool res = m_context->check(num_assumptions, assumptions);
     sw.stop();
+    m_check_watch.add(sw);
     if (res == l_true) {
-        m_factory.m_check_sat_watch.add(sw);
-        m_factory.m_stats.m_num_sat_smt_checks++;
+        m_factory->m_check_sat_watch.add(sw);
+        m_factory->m_stats.m_num_sat_smt_checks++;
+        m_stats.m_num_sat_smt_checks++;
     } else if (res == l_undef) {
-        m_factory.m_check_undef_watch.add(sw);
-        m_factory.m_stats.m_num_undef_smt_checks++;
+        m_factory->m_check_undef_watch.add(sw);
+        m_factory->m_stats.m_num_undef_smt_checks++;
+        m_stats.m_num_undef_smt_checks++;
     }
     set_status(res);
 
     if (m_dump_benchmarks &&
-            sw.get_seconds() >= m_factory.fparams().m_dump_min_time) {
+            sw.get_seconds() >= m_factory->fparams().m_dump_min_time) {
         std::stringstream file_name;
         file_name << "virt_solver";
         if (m_virtual) { file_name << "_" << m_pred->get_decl()->get_name(); }
@@ -301,24 +307,24 @@ lbool virtual_solver::check_sat_core(unsigned num_assumptions,
         else { out << "unknown"; }
         out << ")\n";
 
-        to_smt2_benchmark(out, m_context, num_assumptions, assumptions,
+        to_smt2_benchmark(out, *m_context, num_assumptions, assumptions,
                           "virt_solver");
 
         out << "(exit)\n";
         ::statistics st;
-        m_context.collect_statistics(st);
+        m_context->collect_statistics(st);
         st.update("time", sw.get_seconds());
         st.display_smt2(out);
 
         out.close();
 
-        if (m_factory.fparams().m_dump_recheck) {
+        if (m_factory->fparams().m_dump_recheck) {
             scoped_no_proof _no_proof_(m);
             smt_params p;
             stopwatch sw2;
             smt::kernel kernel(m, p);
-            for (unsigned i = 0, sz = m_context.size(); i < sz; ++i)
-            { kernel.assert_expr(m_context.get_formulas()[i]); }
+            for (unsigned i = 0, sz = m_context->size(); i < sz; ++i)
+            { kernel.assert_expr(m_context->get_formulas()[i]); }
             sw2.start();
             kernel.check(num_assumptions, assumptions);
             sw2.stop();
@@ -334,10 +340,11 @@ lbool virtual_solver::check_sat_core(unsigned num_assumptions,
 void virtual_solver::push_core()
 {
     SASSERT(!m_pushed || get_scope_level() > 0);
+    if (!m_pushed && !m_in_delay_scope) { maybe_migrate(); }
     if (m_in_delay_scope) {
         // second push
         internalize_assertions();
-        m_context.push();
+        m_context->push();
         m_pushed = true;
         m_in_delay_scope = false;
     }
@@ -346,7 +353,7 @@ void virtual_solver::push_core()
     else {
         SASSERT(m_pushed);
         SASSERT(!m_in_delay_scope);
-        m_context.push();
+        m_context->push();
     }
 }
 void virtual_solver::pop_core(unsigned n)
@@ -354,7 +361,7 @@ void virtual_solver::pop_core(unsigned n)
     SASSERT(!m_pushed || get_scope_level() > 0);
     if (m_pushed) {
         SASSERT(!m_in_delay_scope);
-        m_context.pop(n);
+        m_context->pop(n);
         m_pushed = get_scope_level() - n > 0;
     } else
     { m_in_delay_scope = get_scope_level() - n > 0; }
@@ -362,8 +369,8 @@ void virtual_solver::pop_core(unsigned n)
 
 void virtual_solver::get_unsat_core(ptr_vector<expr> &r)
 {
-    for (unsigned i = 0, sz = m_context.get_unsat_core_size(); i < sz; ++i) {
-        expr *core = m_context.get_unsat_core_expr(i);
+    for (unsigned i = 0, sz = m_context->get_unsat_core_size(); i < sz; ++i) {
+        expr *core = m_context->get_unsat_core_expr(i);
         if (is_aux_predicate(core)) { continue; }
         r.push_back(core);
     }
@@ -375,13 +382,13 @@ void virtual_solver::assert_expr(expr *e)
     if (m.is_true(e)) { return; }
     if (m_in_delay_scope) {
         internalize_assertions();
-        m_context.push();
+        m_context->push();
         m_pushed = true;
         m_in_delay_scope = false;
     }
 
     if (m_pushed)
-    { m_context.assert_expr(e); }
+    { m_context->assert_expr(e); }
     else {
         m_flat.push_back(e);
         flatten_and(m_flat);
@@ -395,7 +402,7 @@ void virtual_solver::internalize_assertions()
     for (unsigned sz = m_assertions.size(); m_head < sz; ++m_head) {
         expr_ref f(m);
         f = m.mk_implies(m_pred, (m_assertions.get(m_head)));
-        m_context.assert_expr(f);
+        m_context->assert_expr(f);
     }
 }
 void virtual_solver::refresh()
@@ -404,19 +411,42 @@ void virtual_solver::refresh()
     m_head = 0;
 }
 
+void virtual_solver::maybe_migrate()
+{
+    if (m_pushed || !m_factory->should_split()) { return; }
+    m_factory->migrate(*this);
+    m_stats.m_num_migrations++;
+}
+
+void virtual_solver::collect_statistics(statistics &st) const
+{
+    st.update("time.vsolver.smt", m_check_watch.get_seconds());
+    st.update("vsolver.checks", m_stats.m_num_smt_checks);
+    st.update("vsolver.checks.sat", m_stats.m_num_sat_smt_checks);
+    st.update("vsolver.checks.undef", m_stats.m_num_undef_smt_checks);
+    st.update("vsolver.migrations", m_stats.m_num_migrations);
+    st.update("vsolver.assertions", m_assertions.size());
+}
+
+void virtual_solver::reset_statistics()
+{
+    m_stats.reset();
+    m_check_watch.reset();
+}
+
 void virtual_solver::reset()
 {
     SASSERT(!m_pushed);
     m_head = 0;
     m_assertions.reset();
-    m_factory.refresh();
+    m_factory->refresh();
 }
 
 void virtual_solver::get_labels(svector<symbol> &r)
 {
     r.reset();
     buffer<symbol> tmp;
-    m_context.get_relevant_labels(0, tmp);
+    m_context->get_relevant_labels(0, tmp);
     r.append(tmp.size(), tmp.c_ptr());
 }
 
@@ -426,15 +456,15 @@ solver* virtual_solver::translate(ast_manager& m, params_ref const& p)
     return 0;
 }
 void virtual_solver::updt_params(params_ref const &p)
-{ m_factory.updt_params(p); }
+{ m_factory->updt_params(p); }
 void virtual_solver::collect_param_descrs(param_descrs &r)
-{ m_factory.collect_param_descrs(r); }
+{ m_factory->collect_param_descrs(r); }
 void virtual_solver::set_produce_models(bool f)
-{ m_factory.set_produce_models(f); }
+{ m_factory->set_produce_models(f); }
 bool virtual_solver::get_produce_models()
-{return m_factory.get_produce_models(); }
+{return m_factory->get_produce_models(); }
 smt_params &virtual_solver::fparams()
-{return m_factory.fparams();}
+{return m_factory->fparams();}
 
 void virtual_solver::to_smt2_benchmark(std::ostream &out,
                                        smt::kernel &context,
@@ -463,8 +493,9 @@ void virtual_solver::to_smt2_benchmark(std::ostream &out,
 }
 
 
-virtual_solver_factory::virtual_solver_factory(ast_manager &mgr, smt_params &fparams) :
-    m_fparams(fparams), m(mgr), m_context(m, m_fparams)
+virtual_solver_factory::virtual_solver_factory(ast_manager &mgr, smt_params &fparams,
+                                               smt_context_manager *manager) :
+    m_fparams(fparams), m(mgr), m_context(m, m_fparams), m_manager(manager)
 {
     m_stats.reset();
 }
@@ -474,7 +505,8 @@ virtual_solver* virtual_solver_factory::mk_solver()
     std::stringstream name;
     name << "vsolver#" << m_solvers.size();
     app_ref pred(m);
-    pred = m.mk_const(symbol(name.str().c_str()), m.mk_bool_sort());
+    // -- fresh since solvers migrate between factories
+    pred = m.mk_fresh_const(name.str().c_str(), m.mk_bool_sort());
     SASSERT(m_context.get_scope_level() == 0);
     m_solvers.push_back(alloc(virtual_solver, *this, m_context, pred));
     return m_solvers.back();
@@ -490,6 +522,7 @@ void virtual_solver_factory::collect_statistics(statistics &st) const
     st.update("virtual_solver.checks", m_stats.m_num_smt_checks);
     st.update("virtual_solver.checks.sat", m_stats.m_num_sat_smt_checks);
     st.update("virtual_solver.checks.undef", m_stats.m_num_undef_smt_checks);
+    st.update("virtual_solver.migrations", m_stats.m_num_migrations);
 }
 void virtual_solver_factory::reset_statistics()
 {
@@ -499,6 +532,36 @@ void virtual_solver_factory::reset_statistics()
     m_check_undef_watch.reset();
     m_check_watch.reset();
     m_proof_watch.reset();
+    for (unsigned i = 0, e = m_solvers.size(); i < e; ++i)
+    { m_solvers [i]->reset_statistics(); }
+}
+
+bool virtual_solver_factory::should_split() const
+{
+    unsigned threshold = m_fparams.m_max_shared_context_size;
+    return m_manager && threshold > 0 &&
+        m_solvers.size() > 1 &&
+        m_context.get_scope_level() == 0 &&
+        m_context.size() > threshold;
+}
+
+void virtual_solver_factory::migrate(virtual_solver &s)
+{
+    SASSERT(m_solvers.contains(&s));
+    SASSERT(!s.m_pushed);
+    virtual_solver_factory &f = *m_manager->mk_factory();
+    m_solvers.erase(&s);
+    f.m_solvers.push_back(&s);
+    s.m_factory = &f;
+    s.m_context = &f.m_context;
+    s.refresh();
+    m_stats.m_num_migrations++;
+
+    IF_VERBOSE(2, verbose_stream() << "(spacer.virtual-solver :migrate "
+               << s.m_pred->get_decl()->get_name()
+               << " :context-size " << m_context.size() << ")\n";);
+    // -- the remaining solvers re-assert their formulas lazily
+    refresh();
 }
 
 void virtual_solver_factory::refresh()
@@ -26,14 +26,25 @@ Notes:
 #include"util/stopwatch.h"
 namespace spacer {
 class virtual_solver_factory;
+class smt_context_manager;
 
 class virtual_solver : public solver_na2as {
     friend class virtual_solver_factory;
 
 private:
-    virtual_solver_factory &m_factory;
+    struct stats {
+        unsigned m_num_smt_checks;
+        unsigned m_num_sat_smt_checks;
+        unsigned m_num_undef_smt_checks;
+        unsigned m_num_migrations;
+        stats() { reset(); }
+        void reset() { memset(this, 0, sizeof(*this)); }
+    };
+
+    // -- pointers since the solver can migrate to another factory
+    virtual_solver_factory *m_factory;
     ast_manager &m;
-    smt::kernel &m_context;
+    smt::kernel *m_context;
     app_ref m_pred;
 
     bool m_virtual;
@@ -49,6 +60,9 @@ private:
 
     proof_ref m_proof;
 
+    stats m_stats;
+    stopwatch m_check_watch;
+
     virtual_solver(virtual_solver_factory &factory, smt::kernel &context, app* pred);
 
     bool is_aux_predicate(expr *p);
@@ -63,6 +77,9 @@ private:
                            char const * attributes = "");
 
     void refresh();
+    /// \brief moves this solver to a fresh context if its shared
+    /// context has grown too large
+    void maybe_migrate();
 
 public:
     virtual ~virtual_solver();
@@ -79,13 +96,14 @@ public:
 
     virtual void get_unsat_core(ptr_vector<expr> &r);
     virtual void assert_expr(expr *e);
-    virtual void collect_statistics(statistics &st) const {}
-    virtual void get_model(model_ref &m) {m_context.get_model(m);}
+    virtual void collect_statistics(statistics &st) const;
+    virtual void reset_statistics();
+    virtual void get_model(model_ref &m) {m_context->get_model(m);}
     virtual proof* get_proof();
     virtual std::string reason_unknown() const
-    {return m_context.last_failure_as_string();}
+    {return m_context->last_failure_as_string();}
     virtual void set_reason_unknown(char const *msg)
-    {m_context.set_reason_unknown(msg);}
+    {m_context->set_reason_unknown(msg);}
     virtual ast_manager& get_manager() const {return m;}
     virtual void get_labels(svector<symbol> &r);
     virtual void set_produce_models(bool f);
@@ -117,11 +135,14 @@ private:
     smt::kernel m_context;
     /// solvers managed by this factory
     ptr_vector<virtual_solver> m_solvers;
+    /// provider of fresh factories for migrated solvers (may be null)
+    smt_context_manager *m_manager;
 
     struct stats {
         unsigned m_num_smt_checks;
         unsigned m_num_sat_smt_checks;
         unsigned m_num_undef_smt_checks;
+        unsigned m_num_migrations;
         stats() { reset(); }
         void reset() { memset(this, 0, sizeof(*this)); }
     };
@@ -134,8 +155,14 @@ private:
 
 
     void refresh();
+    /// \brief true if the shared context is too large and a solver
+    /// can be moved out of it
+    bool should_split() const;
+    /// \brief moves \p s to a fresh factory and rebuilds the context
+    void migrate(virtual_solver &s);
 public:
-    virtual_solver_factory(ast_manager &mgr, smt_params &fparams);
+    virtual_solver_factory(ast_manager &mgr, smt_params &fparams,
+                           smt_context_manager *manager = 0);
     virtual ~virtual_solver_factory();
     virtual_solver* mk_solver();
     void collect_statistics(statistics &st) const;
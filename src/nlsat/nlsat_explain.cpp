@@ -21,6 +21,8 @@ Revision History:
 #include "nlsat/nlsat_evaluator.h"
 #include "math/polynomial/algebraic_numbers.h"
 #include "util/ref_buffer.h"
+#include "util/scoped_ptr_vector.h"
+#include "util/z3_omp.h"
 
 namespace nlsat {
 
@@ -45,6 +47,36 @@ namespace nlsat {
         bool                    m_minimize_cores;
         bool                    m_factor;
         bool                    m_signed_project;
+        unsigned                m_num_threads;
+
+        /**
+           \brief Polynomial manager private to a thread computing psc chains.
+           The jobs assigned to the worker are stored as pairs (m_ps[i], m_qs[i]),
+           the chain of job i is stored in m_result[m_result_begin[i], m_result_begin[i+1]).
+        */
+        struct psc_worker {
+            reslimit                     m_limit;
+            polynomial::numeral_manager  m_qm;
+            pmanager                     m_pm;
+            polynomial_ref_vector        m_ps;
+            polynomial_ref_vector        m_qs;
+            polynomial_ref_vector        m_result;
+            unsigned_vector              m_result_begin;
+            psc_worker(bool modular_psc):
+                m_pm(m_limit, m_qm),
+                m_ps(m_pm),
+                m_qs(m_pm),
+                m_result(m_pm) {
+                m_pm.set_modular_psc(modular_psc);
+            }
+            void reset() {
+                m_ps.reset();
+                m_qs.reset();
+                m_result.reset();
+                m_result_begin.reset();
+            }
+        };
+        scoped_ptr_vector<psc_worker> m_workers;
 
         struct todo_set {
             polynomial::cache  &    m_cache;
@@ -152,6 +184,7 @@ namespace nlsat {
             m_full_dimensional = false;
             m_minimize_cores   = false;
             m_signed_project   = false;
+            m_num_threads      = 1;
         }
         
         ~imp() {
@@ -623,11 +656,16 @@ namespace nlsat {
            \brief Add v-psc(p, q, x) into m_todo
         */
         void psc(polynomial_ref & p, polynomial_ref & q, var x) {
-            polynomial_ref_vector & S = m_psc_tmp;
-            polynomial_ref s(m_pm);
             TRACE("nlsat_explain", tout << "computing psc of\n"; display(tout, p); tout << "\n"; display(tout, q); tout << "\n";);
+            psc_chain(p, q, x, m_psc_tmp);
+            add_psc(p, q, m_psc_tmp);
+        }
 
-            psc_chain(p, q, x, S);
+        /**
+           \brief Add the first psc in S = psc_chain(p, q, x) that does not vanish into m_todo.
+        */
+        void add_psc(polynomial_ref & p, polynomial_ref & q, polynomial_ref_vector & S) {
+            polynomial_ref s(m_pm);
             unsigned sz = S.size();
             for (unsigned i = 0; i < sz; i++) {
                 s = S.get(i);
@@ -701,6 +739,96 @@ namespace nlsat {
             }
         }
 
+        /**
+           \brief Compute the psc chains of psc_discriminant and psc_resultant
+           on m_num_threads private polynomial managers, and then add them into
+           m_todo in the order used by the sequential version.
+           Return false if the chains should be computed sequentially.
+        */
+        bool psc_parallel(polynomial_ref_vector & ps, var x) {
+#ifdef _NO_OMP_
+            return false;
+#else
+            if (m_num_threads <= 1 || omp_in_parallel())
+                return false;
+            polynomial_ref_vector ps1(m_pm), qs1(m_pm);
+            polynomial_ref p(m_pm), q(m_pm);
+            unsigned sz = ps.size();
+            for (unsigned i = 0; i < sz; i++) {
+                p = ps.get(i);
+                if (degree(p, x) < 2)
+                    continue;
+                ps1.push_back(p);
+                qs1.push_back(derivative(p, x));
+            }
+            for (unsigned i = 0; i + 1 < sz; i++) {
+                for (unsigned j = i + 1; j < sz; j++) {
+                    ps1.push_back(ps.get(i));
+                    qs1.push_back(ps.get(j));
+                }
+            }
+            unsigned num_jobs = ps1.size();
+            if (num_jobs < 2)
+                return false;
+            unsigned num_workers = std::min(m_num_threads, num_jobs);
+            while (m_workers.size() < num_workers)
+                m_workers.push_back(alloc(psc_worker, m_pm.use_modular_psc()));
+            scoped_limits scl(m_solver.rlimit());
+            for (unsigned w = 0; w < num_workers; w++) {
+                psc_worker & wk = *m_workers[w];
+                wk.reset();
+                scl.push_child(&wk.m_limit);
+            }
+            // job i is assigned to worker i % num_workers
+            for (unsigned i = 0; i < num_jobs; i++) {
+                psc_worker & wk = *m_workers[i % num_workers];
+                wk.m_ps.push_back(convert(m_pm, ps1.get(i), wk.m_pm));
+                wk.m_qs.push_back(convert(m_pm, qs1.get(i), wk.m_pm));
+            }
+            std::string ex_msg;
+            bool failed = false;
+            #pragma omp parallel for num_threads(num_workers)
+            for (int w = 0; w < static_cast<int>(num_workers); w++) {
+                psc_worker & wk = *m_workers[w];
+                try {
+                    polynomial_ref_vector S(wk.m_pm);
+                    for (unsigned i = 0; i < wk.m_ps.size(); i++) {
+                        wk.m_result_begin.push_back(wk.m_result.size());
+                        wk.m_pm.psc_chain(wk.m_ps.get(i), wk.m_qs.get(i), x, S);
+                        wk.m_result.append(S);
+                    }
+                    wk.m_result_begin.push_back(wk.m_result.size());
+                }
+                catch (z3_exception & ex) {
+                    #pragma omp critical (nlsat_explain)
+                    {
+                        if (!failed) {
+                            failed = true;
+                            ex_msg = ex.msg();
+                        }
+                    }
+                    for (unsigned v = 0; v < num_workers; v++)
+                        m_workers[v]->m_limit.cancel();
+                }
+            }
+            if (failed)
+                throw solver_exception(ex_msg.c_str());
+            for (unsigned i = 0; i < num_jobs; i++) {
+                psc_worker & wk = *m_workers[i % num_workers];
+                unsigned k = i / num_workers;
+                m_psc_tmp.reset();
+                for (unsigned j = wk.m_result_begin[k]; j < wk.m_result_begin[k+1]; j++)
+                    m_psc_tmp.push_back(convert(wk.m_pm, wk.m_result.get(j), m_pm));
+                p = ps1.get(i);
+                q = qs1.get(i);
+                add_psc(p, q, m_psc_tmp);
+            }
+            for (unsigned w = 0; w < num_workers; w++)
+                m_workers[w]->reset();
+            return true;
+#endif
+        }
+
         void test_root_literal(atom::kind k, var y, unsigned i, poly * p, scoped_literal_vector& result) {
             m_result = &result;
             add_root_literal(k, y, i, p);
@@ -980,8 +1108,10 @@ namespace nlsat {
                 TRACE("nlsat_explain", tout << "project loop, processing var "; display_var(tout, x); tout << "\npolynomials\n";
                       display(tout, ps); tout << "\n";);
                 add_lc(ps, x);
-                psc_discriminant(ps, x);
-                psc_resultant(ps, x);
+                if (!psc_parallel(ps, x)) {
+                    psc_discriminant(ps, x);
+                    psc_resultant(ps, x);
+                }
                 if (m_todo.empty())
                     break;
                 x = m_todo.remove_max_polys(ps);
@@ -1819,6 +1949,10 @@ namespace nlsat {
         m_imp->m_signed_project = f;
     }
 
+    void explain::set_num_threads(unsigned n) {
+        m_imp->m_num_threads = n;
+    }
+
     void explain::operator()(unsigned n, literal const * ls, scoped_literal_vector & result) {
         (*m_imp)(n, ls, result);
     }
@@ -44,6 +44,10 @@ namespace nlsat {
         void set_minimize_cores(bool f);
         void set_factor(bool f);
         void set_signed_project(bool f);
+        /**
+           \brief Number of threads used to compute the resultants and discriminants of a projection.
+        */
+        void set_num_threads(unsigned n);
 
         /**
            \brief Given a set of literals ls[0], ... ls[n-1] s.t.
@@ -206,6 +206,8 @@ namespace nlsat {
             m_explain.set_simplify_cores(m_simplify_cores);
             m_explain.set_minimize_cores(min_cores);
             m_explain.set_factor(p.factor());
+            m_explain.set_num_threads(p.threads());
+            m_pm.set_modular_psc(p.modular_psc());
             m_am.updt_params(p.p);
         }
 
@@ -1803,6 +1805,7 @@ namespace nlsat {
             st.update("nlsat decisions", m_decisions);
             st.update("nlsat stages", m_stages);
             st.update("nlsat irrational assignments", m_irrational_assignments);
+            m_am.collect_statistics(st);
         }
 
         void reset_statistics() {
@@ -1811,6 +1814,7 @@ namespace nlsat {
             m_decisions              = 0;
             m_stages                 = 0;
             m_irrational_assignments = 0;
+            m_am.reset_statistics();
         }
 
         // -----------------------
@@ -2747,6 +2751,10 @@ namespace nlsat {
         return m_imp->m_pm;
     }
 
+    reslimit & solver::rlimit() {
+        return m_imp->m_rlimit;
+    }
+
     void solver::set_display_var(display_var_proc const & proc) {
         m_imp->m_display_var.m_proc = &proc;
     }
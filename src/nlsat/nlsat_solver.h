@@ -53,6 +53,11 @@ namespace nlsat {
         */
         pmanager & pm();
 
+        /**
+           \brief Return a reference to the resource limit of the solver.
+        */
+        reslimit & rlimit();
+
         void set_display_var(display_var_proc const & proc);
 
         // -----------------------
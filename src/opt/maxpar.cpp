@@ -0,0 +1,299 @@
+/*++
+Copyright (c) 2017 Microsoft Corporation
+
+Module Name:
+
+    maxpar.cpp
+
+Abstract:
+
+    Portfolio MaxSAT.
+
+    maxres runs on the main manager while a model-improving linear
+    search runs on a translated copy of the hard and soft constraints
+    in a second thread. The linear search repeatedly asks for an
+    assignment that is strictly cheaper than the best one so far.
+
+    The two engines share their bounds: the upper bounds found by
+    the linear search let maxres stop as soon as its lower bound
+    meets them, and the lower bounds produced by the cores of maxres
+    let the linear search stop once its cost reaches them.
+    When one engine proves optimality the other is canceled.
+    The engine with the best upper bound supplies the assignment.
+
+Notes:
+
+--*/
+
+#include "opt/maxsmt.h"
+#include "opt/maxres.h"
+#include "opt/maxpar.h"
+#include "opt/opt_context.h"
+#include "ast/ast_translation.h"
+#include "ast/ast_util.h"
+#include "ast/pb_decl_plugin.h"
+#include "smt/smt_solver.h"
+#include "util/z3_omp.h"
+
+using namespace opt;
+
+/**
+   \brief linear search for cheaper assignments of the soft constraints.
+   Assumes that it owns its manager.
+*/
+class linear_search {
+    ast_manager&      m;
+    ref<solver>       m_solver;
+    expr_ref_vector   m_nsoft;          // negated soft constraints
+    vector<rational>  m_weights;
+    maxsmt_bounds&    m_bounds;
+    model_ref         m_model;
+    rational          m_upper;
+    unsigned          m_num_models;
+
+    rational cost(model* mdl) {
+        rational r(0);
+        expr_ref tmp(m);
+        for (unsigned i = 0; i < m_nsoft.size(); ++i) {
+            if (!mdl->eval(m_nsoft[i].get(), tmp, true) || !m.is_false(tmp)) {
+                r += m_weights[i];
+            }
+        }
+        return r;
+    }
+
+public:
+    linear_search(ast_manager& m, params_ref const& p, maxsmt_bounds& bounds,
+                  expr_ref_vector const& hard, expr_ref_vector const& soft, weights_t& ws):
+        m(m),
+        m_solver(mk_smt_solver(m, p, symbol::null)),
+        m_nsoft(m),
+        m_weights(ws),
+        m_bounds(bounds),
+        m_num_models(0) {
+        m_solver->assert_expr(hard);
+        for (unsigned i = 0; i < soft.size(); ++i) {
+            m_nsoft.push_back(mk_not(m, soft[i]));
+        }
+    }
+
+    lbool operator()() {
+        pb_util pb(m);
+        expr_ref fml(m);
+        lbool is_sat = l_true;
+        while (is_sat == l_true) {
+            is_sat = m_solver->check_sat(0, 0);
+            if (is_sat != l_true) {
+                break;
+            }
+            model_ref mdl;
+            m_solver->get_model(mdl);
+            rational c = cost(mdl.get());
+            SASSERT(!m_model || c < m_upper);
+            m_model = mdl;
+            m_upper = c;
+            ++m_num_models;
+            m_bounds.update(rational(0), m_upper);
+            IF_VERBOSE(1, verbose_stream() << "(opt.par-maxres linear-search " << m_upper << ")\n";);
+            if (m_bounds.get_lower() >= m_upper) {
+                return l_true;
+            }
+            fml = pb.mk_lt(m_nsoft.size(), m_weights.c_ptr(), m_nsoft.c_ptr(), m_upper);
+            m_solver->assert_expr(fml);
+        }
+        if (is_sat == l_false && m_model) {
+            m_bounds.update(m_upper, m_upper);
+            return l_true;
+        }
+        return is_sat;
+    }
+
+    model* get_model() const { return m_model.get(); }
+    rational const& get_upper() const { return m_upper; }
+    unsigned num_models() const { return m_num_models; }
+};
+
+
+class maxpar : public maxsmt_solver_base {
+    struct stats {
+        unsigned m_num_ls_models;
+        unsigned m_num_ls_wins;
+        unsigned m_num_maxres_wins;
+        stats() { reset(); }
+        void reset() { memset(this, 0, sizeof(*this)); }
+    };
+
+    unsigned                       m_index;
+    scoped_ptr<maxsmt_solver_base> m_maxres;
+    bool                           m_maxres_won;
+    stats                          m_stats;
+
+public:
+    maxpar(maxsat_context& c, unsigned index, weights_t& ws, expr_ref_vector const& soft):
+        maxsmt_solver_base(c, ws, soft),
+        m_index(index),
+        m_maxres_won(true) {
+    }
+
+    virtual ~maxpar() {}
+
+    virtual lbool operator()() {
+        m_maxres = mk_maxres(m_c, m_index, m_weights, m_soft);
+        m_maxres->updt_params(m_params);
+        m_maxres->set_adjust_value(m_adjust_value);
+        m_maxres_won = true;
+        bool use_seq;
+#ifdef _NO_OMP_
+        use_seq = true;
+#else
+        use_seq = 0 != omp_in_parallel();
+#endif
+        // the solver state left by a canceled maxres is only
+        // safe to discard if no other objective depends on it.
+        if (use_seq || m_c.num_objectives() > 1 || m_soft.empty()) {
+            return run_maxres();
+        }
+        return race();
+    }
+
+    virtual rational get_lower() const { return m_maxres_won ? m_maxres->get_lower() : m_lower; }
+    virtual rational get_upper() const { return m_maxres_won ? m_maxres->get_upper() : m_upper; }
+    virtual bool get_assignment(unsigned index) const {
+        return m_maxres_won ? m_maxres->get_assignment(index) : m_assignment[index];
+    }
+
+    virtual void get_model(model_ref& mdl, svector<symbol>& labels) {
+        if (m_maxres_won) {
+            m_maxres->get_model(mdl, labels);
+        }
+        else {
+            maxsmt_solver_base::get_model(mdl, labels);
+        }
+    }
+
+    virtual void commit_assignment() {
+        if (m_maxres_won) {
+            m_maxres->commit_assignment();
+        }
+        else {
+            maxsmt_solver_base::commit_assignment();
+        }
+    }
+
+    virtual void collect_statistics(statistics& st) const {
+        if (m_maxres) {
+            m_maxres->collect_statistics(st);
+        }
+        st.update("maxpar-linear-search-models", m_stats.m_num_ls_models);
+        st.update("maxpar-linear-search-wins", m_stats.m_num_ls_wins);
+        st.update("maxpar-maxres-wins", m_stats.m_num_maxres_wins);
+        st.update("maxpar-best-upper", get_upper().get_double());
+    }
+
+    virtual void updt_params(params_ref& p) {
+        maxsmt_solver_base::updt_params(p);
+        if (m_maxres) {
+            m_maxres->updt_params(p);
+        }
+    }
+
+private:
+
+    lbool run_maxres() {
+        lbool is_sat = (*m_maxres)();
+        if (is_sat == l_true) {
+            ++m_stats.m_num_maxres_wins;
+        }
+        return is_sat;
+    }
+
+    lbool race() {
+        if (!init()) return l_undef;
+        maxsmt_bounds bounds(m_upper);
+        m_maxres->set_bounds(&bounds);
+
+        scoped_ptr<ast_manager> new_m = alloc(ast_manager, m, !m.proof_mode());
+        scoped_limits scl(m.limit());
+        scl.push_child(&new_m->limit());
+        scoped_ptr<linear_search> ls;
+        {
+            ast_translation tr(m, *new_m);
+            expr_ref_vector hard(m), hard2(*new_m), soft2(*new_m);
+            s().get_assertions(hard);
+            for (unsigned i = 0; i < hard.size(); ++i) {
+                hard2.push_back(tr(hard[i].get()));
+            }
+            for (unsigned i = 0; i < m_soft.size(); ++i) {
+                soft2.push_back(tr(m_soft[i]));
+            }
+            ls = alloc(linear_search, *new_m, m_params, bounds, hard2, soft2, m_weights);
+        }
+
+        lbool results[2] = { l_undef, l_undef };
+        bool canceled_main = false;
+        #pragma omp parallel for
+        for (int i = 0; i < 2; ++i) {
+            try {
+                if (i == 0) {
+                    results[0] = (*m_maxres)();
+                    if (results[0] != l_undef) {
+                        new_m->limit().cancel();
+                    }
+                }
+                else {
+                    results[1] = (*ls)();
+                    if (results[1] == l_true) {
+                        #pragma omp critical (maxpar)
+                        {
+                            canceled_main = true;
+                            m.limit().inc_cancel();
+                        }
+                    }
+                }
+            }
+            catch (z3_exception&) {
+                results[i] = l_undef;
+            }
+        }
+        if (canceled_main) {
+            m.limit().dec_cancel();
+        }
+        m_maxres->set_bounds(0);
+        m_stats.m_num_ls_models += ls->num_models();
+
+        if (results[0] == l_false) {
+            return l_false;
+        }
+        if (!ls->get_model() || ls->get_upper() >= m_maxres->get_upper()) {
+            if (results[0] == l_true) {
+                ++m_stats.m_num_maxres_wins;
+            }
+            return results[0];
+        }
+
+        // the linear search has the best assignment.
+        ast_translation tr(*new_m, m);
+        model_ref mdl = ls->get_model()->translate(tr);
+        m_model = mdl;
+        m_labels.reset();
+        m_upper = ls->get_upper();
+        m_lower = std::max(bounds.get_lower(), m_maxres->get_lower());
+        expr_ref tmp(m);
+        for (unsigned i = 0; i < m_soft.size(); ++i) {
+            m_assignment[i] = m_model->eval(m_soft[i], tmp, true) && m.is_true(tmp);
+        }
+        m_maxres_won = false;
+        if (m_lower < m_upper) {
+            return l_undef;
+        }
+        ++m_stats.m_num_ls_wins;
+        m_c.set_model(m_model);
+        trace_bounds("par-maxres");
+        return l_true;
+    }
+};
+
+opt::maxsmt_solver_base* opt::mk_par_maxres(
+    maxsat_context& c, unsigned id, weights_t& ws, expr_ref_vector const& soft) {
+    return alloc(maxpar, c, id, ws, soft);
+}
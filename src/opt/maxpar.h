@@ -0,0 +1,27 @@
+/*++
+Copyright (c) 2017 Microsoft Corporation
+
+Module Name:
+
+    maxpar.h
+
+Abstract:
+
+    Portfolio MaxSAT: maxres racing a model-improving linear search.
+
+Notes:
+
+--*/
+
+#ifndef MAXPAR_H_
+#define MAXPAR_H_
+
+#include "opt/maxsmt.h"
+
+namespace opt {
+
+    maxsmt_solver_base* mk_par_maxres(maxsat_context& c, unsigned id, weights_t & ws, expr_ref_vector const& soft);
+
+};
+
+#endif
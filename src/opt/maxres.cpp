@@ -64,6 +64,7 @@ Notes:
 #include "opt/opt_params.hpp"
 #include "ast/ast_util.h"
 #include "smt/smt_solver.h"
+#include "util/totalizer.h"
 
 using namespace opt;
 
@@ -73,10 +74,28 @@ public:
         s_primal,
         s_primal_dual
     };
+
+    // literals and clauses for the totalizer over falsified soft constraints.
+    struct bound_ext {
+        maxres&          mr;
+        expr_ref_vector  m_trail;
+        typedef expr* literal;
+        typedef ptr_vector<expr> literal_vector;
+        bound_ext(maxres& mr): mr(mr), m_trail(mr.m) {}
+        literal trail(literal l) { m_trail.push_back(l); return l; }
+        literal mk_false() { return mr.m.mk_false(); }
+        literal mk_true() { return mr.m.mk_true(); }
+        literal mk_not(literal a) { if (mr.m.is_not(a, a)) return a; return trail(mr.m.mk_not(a)); }
+        literal fresh() { return trail(mr.mk_fresh_bool("tot")); }
+        void mk_clause(unsigned n, literal const* lits) { mr.s().assert_expr(mk_or(mr.m, n, lits)); }
+    };
 private:
     struct stats {
         unsigned m_num_cores;
         unsigned m_num_cs;
+        unsigned m_num_hardened;
+        unsigned m_num_strata;
+        unsigned m_num_totalizer_clauses;
         stats() { reset(); }
         void reset() {
             memset(this, 0, sizeof(*this));
@@ -108,11 +127,16 @@ private:
                                                // this option is disabled if SAT core is used.
     bool             m_pivot_on_cs;            // prefer smaller correction set to core.
     bool             m_dump_benchmarks;        // display benchmarks (into wcnf format)
+    bool             m_stratify;               // select weight levels based on weight diversity
+    bool             m_hardening;              // assert soft constraints whose weight exceeds the gap
 
 
     std::string      m_trace_id;
     typedef ptr_vector<expr> exprs;
 
+    bound_ext                       m_bound_ext;
+    scoped_ptr<totalizer<bound_ext> > m_totalizer; // counts falsified unit weight soft constraints
+
 public:
     maxres(maxsat_context& c, unsigned index, 
            weights_t& ws, expr_ref_vector const& soft, 
@@ -133,7 +157,10 @@ public:
         m_max_core_size(3),
         m_maximize_assignment(false),
         m_max_correction_set_size(3),
-        m_pivot_on_cs(true)
+        m_pivot_on_cs(true),
+        m_stratify(false),
+        m_hardening(true),
+        m_bound_ext(*this)
     {
         switch(st) {
         case s_primal:
@@ -184,6 +211,7 @@ public:
 
     void trace() {
         trace_bounds(m_trace_id.c_str());
+        share_bounds();
     }
 
     lbool mus_solver() {
@@ -199,10 +227,14 @@ public:
                   tout << "\n";
                   display(tout);
                   );
+            harden();
             is_sat = check_sat_hill_climb(m_asms);
             if (m.canceled()) {
                 return l_undef;
             }
+            if (is_dominated()) {
+                return l_true;
+            }
             switch (is_sat) {
             case l_true: 
                 SASSERT(is_true(m_asms));
@@ -239,6 +271,9 @@ public:
             if (m.canceled()) {
                 return l_undef;
             }
+            if (is_dominated()) {
+                return l_true;
+            }
             switch (is_sat) {
             case l_true: 
                 get_current_correction_set(cs);
@@ -286,10 +321,16 @@ public:
             bool first = index > 0;
             SASSERT(index < asms.size() || asms.empty());
             while (index < asms.size() && is_sat == l_true) {
-                while (!first && asms.size() > 20*(index - m_last_index) && index < asms.size()) {
-                    index = next_index(asms, index);
+                if (m_stratify) {
+                    index = next_stratum(asms, index);
+                }
+                else {
+                    while (!first && asms.size() > 20*(index - m_last_index) && index < asms.size()) {
+                        index = next_index(asms, index);
+                    }
                 }
                 first = false;
+                ++m_stats.m_num_strata;
                 // IF_VERBOSE(3, verbose_stream() << "weight: " << get_weight(asms[0].get()) << " " << get_weight(asms[index-1].get()) << " num soft: " << index << "\n";);
                 m_last_index = index;
                 is_sat = check_sat(index, asms.c_ptr());
@@ -341,6 +382,9 @@ public:
     virtual void collect_statistics(statistics& st) const { 
         st.update("maxres-cores", m_stats.m_num_cores);
         st.update("maxres-correction-sets", m_stats.m_num_cs);
+        st.update("maxres-hardened", m_stats.m_num_hardened);
+        st.update("maxres-strata", m_stats.m_num_strata);
+        st.update("maxres-totalizer-clauses", m_stats.m_num_totalizer_clauses);
     }
 
     lbool get_cores(vector<exprs>& cores) {
@@ -435,6 +479,59 @@ public:
         return index;
     }
 
+    /**
+       Diversity-based stratification.
+       When there are few distinct weights compared to the number of
+       soft constraints, the next stratum adds the next weight level.
+       When the weights are diverse, stepping through individual levels
+       would add few soft constraints per call, so the next stratum adds
+       all soft constraints within an order of magnitude of the largest
+       weight not yet included.
+    */
+    unsigned next_stratum(expr_ref_vector const& asms, unsigned index) {
+        if (index >= asms.size()) {
+            return index;
+        }
+        unsigned num_levels = 0;
+        for (unsigned i = index; i < asms.size(); i = next_index(asms, i)) {
+            ++num_levels;
+        }
+        if (4*num_levels <= asms.size() - index) {
+            return next_index(asms, index);
+        }
+        rational bound = get_weight(asms[index]) / rational(10);
+        for (; index < asms.size() && get_weight(asms[index]) > bound; ++index);
+        return index;
+    }
+
+    /**
+       Hardening.
+       The weights of the remaining assumptions account for the cost of an
+       assignment above m_lower. An assignment that falsifies an assumption
+       whose weight exceeds m_upper - m_lower is therefore worse than the
+       best assignment found so far, and the assumption can be asserted.
+       This relies on the cost preserving reformulation of the primal
+       solver; correction set reformulation adds hard disjunctions.
+    */
+    void harden() {
+        if (!m_hardening || m_st != s_primal || !m_model) {
+            return;
+        }
+        rational gap = m_upper - m_lower;
+        for (unsigned i = 0; i < m_asms.size(); ++i) {
+            expr* a = m_asms[i].get();
+            if (get_weight(a) > gap) {
+                TRACE("opt", tout << "harden: " << mk_pp(a, m) << " : " << get_weight(a) << "\n";);
+                s().assert_expr(a);
+                m_defs.push_back(a);
+                ++m_stats.m_num_hardened;
+                m_asms[i] = m_asms.back();
+                m_asms.pop_back();
+                --i;
+            }
+        }
+    }
+
     void process_sat(exprs const& corr_set) {
         ++m_stats.m_num_cs;
         expr_ref fml(m), tmp(m);
@@ -742,6 +839,13 @@ public:
 
     void add_upper_bound_block() {
         if (!m_add_upper_bound_block) return;
+        if (m_totalizer) {
+            // reuse the counter from previous bounds.
+            unsigned num_clauses = m_totalizer->num_clauses();
+            s().assert_expr(m_bound_ext.mk_not(m_totalizer->at_least(m_upper.get_unsigned())));
+            m_stats.m_num_totalizer_clauses += m_totalizer->num_clauses() - num_clauses;
+            return;
+        }
         pb_util u(m);
         expr_ref_vector nsoft(m);
         expr_ref fml(m);
@@ -799,6 +903,8 @@ public:
         m_pivot_on_cs = _p.maxres_pivot_on_correction_set();
         m_wmax = _p.maxres_wmax();
         m_dump_benchmarks = _p.dump_benchmarks();
+        m_stratify = _p.maxres_stratify();
+        m_hardening = _p.maxres_hardening();
     }
 
     lbool init_local() {
@@ -817,12 +923,33 @@ public:
         m_max_upper = m_upper;
         m_found_feasible_optimum = false;
         m_last_index = 0;
+        init_totalizer();
         add_upper_bound_block();
         m_csmodel = 0;
         m_correction_set_size = 0;
         return l_true;
     }
 
+    void init_totalizer() {
+        m_totalizer = 0;
+        m_bound_ext.m_trail.reset();
+        if (!m_add_upper_bound_block || m_soft.empty()) {
+            return;
+        }
+        for (unsigned i = 0; i < m_weights.size(); ++i) {
+            if (!m_weights[i].is_one()) {
+                return;
+            }
+        }
+        expr_ref_vector nsoft(m);
+        for (unsigned i = 0; i < m_soft.size(); ++i) {
+            nsoft.push_back(mk_not(m, m_soft[i]));
+        }
+        m_bound_ext.m_trail.append(nsoft);
+        m_totalizer = alloc(totalizer<bound_ext>, m_bound_ext);
+        m_totalizer->add(nsoft.size(), nsoft.c_ptr());
+    }
+
     virtual void commit_assignment() {
         if (m_found_feasible_optimum) {
             TRACE("opt", tout << "Committing feasible solution\n";
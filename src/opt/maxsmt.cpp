@@ -20,6 +20,7 @@ Notes:
 #include <typeinfo>
 #include "opt/maxsmt.h"
 #include "opt/maxres.h"
+#include "opt/maxpar.h"
 #include "opt/wmax.h"
 #include "ast/ast_pp.h"
 #include "util/uint_set.h"
@@ -28,10 +29,37 @@ Notes:
 #include "smt/theory_pb.h"
 #include "ast/ast_util.h"
 #include "ast/pb_decl_plugin.h"
+#include "util/z3_omp.h"
 
 
 namespace opt {
 
+    void maxsmt_bounds::update(rational const& lower, rational const& upper) {
+        #pragma omp critical (maxsmt_bounds)
+        {
+            if (lower > m_lower) m_lower = lower;
+            if (upper < m_upper) m_upper = upper;
+        }
+    }
+
+    rational maxsmt_bounds::get_lower() const {
+        rational r;
+        #pragma omp critical (maxsmt_bounds)
+        {
+            r = m_lower;
+        }
+        return r;
+    }
+
+    rational maxsmt_bounds::get_upper() const {
+        rational r;
+        #pragma omp critical (maxsmt_bounds)
+        {
+            r = m_upper;
+        }
+        return r;
+    }
+
     maxsmt_solver_base::maxsmt_solver_base(
         maxsat_context& c, vector<rational> const& ws, expr_ref_vector const& soft):
         m(c.get_manager()), 
@@ -39,7 +67,8 @@ namespace opt {
         m_soft(soft),
         m_weights(ws),
         m_assertions(m),
-        m_trail(m) {
+        m_trail(m),
+        m_bounds(0) {
         c.get_base_model(m_model);
         SASSERT(m_model);
         updt_params(c.params());
@@ -158,6 +187,20 @@ namespace opt {
                    verbose_stream() << "(opt." << solver << " [" << l << ":" << u << "])\n";);        
     }
 
+    void maxsmt_solver_base::share_bounds() {
+        if (m_bounds) {
+            m_bounds->update(m_lower, m_upper);
+        }
+    }
+
+    /**
+       \brief true if a competing engine found an assignment 
+       that matches the current lower bound.
+    */
+    bool maxsmt_solver_base::is_dominated() const {
+        return m_bounds && m_bounds->get_upper() <= m_lower;
+    }
+
     lbool maxsmt_solver_base::find_mutexes(obj_map<expr, rational>& new_soft) {
         m_lower.reset();
         for (unsigned i = 0; i < m_soft.size(); ++i) {
@@ -240,6 +283,9 @@ namespace opt {
         else if (maxsat_engine == symbol("pd-maxres")) {            
             m_msolver = mk_primal_dual_maxres(m_c, m_index, m_weights, m_soft_constraints);
         }
+        else if (maxsat_engine == symbol("par-maxres")) {
+            m_msolver = mk_par_maxres(m_c, m_index, m_weights, m_soft_constraints);
+        }
         else if (maxsat_engine == symbol("wmax")) {
             m_msolver = mk_wmax(m_c, m_weights, m_soft_constraints);
         }
@@ -35,6 +35,20 @@ namespace opt {
 
     class maxsat_context;
 
+    /**
+       \brief bounds shared between maxsat engines that race on the
+       same soft constraints from different threads.
+    */
+    class maxsmt_bounds {
+        rational m_lower;
+        rational m_upper;
+    public:
+        maxsmt_bounds(rational const& upper): m_upper(upper) {}
+        void update(rational const& lower, rational const& upper);
+        rational get_lower() const;
+        rational get_upper() const;
+    };
+
     class maxsmt_solver {
     protected:
         adjust_value m_adjust_value;
@@ -69,6 +83,7 @@ namespace opt {
         svector<symbol>  m_labels;
         svector<bool>    m_assignment;       // truth assignment to soft constraints
         params_ref       m_params;           // config
+        maxsmt_bounds*   m_bounds;           // bounds shared with competing engines
 
     public:
         maxsmt_solver_base(maxsat_context& c, weights_t& ws, expr_ref_vector const& soft); 
@@ -86,6 +101,7 @@ namespace opt {
         bool init();
         void set_mus(bool f);
         app* mk_fresh_bool(char const* name);
+        void set_bounds(maxsmt_bounds* b) { m_bounds = b; }
 
         class smt::theory_wmaxsat* get_wmax_theory() const;
         smt::theory_wmaxsat* ensure_wmax_theory();
@@ -103,6 +119,8 @@ namespace opt {
     protected:
         void enable_sls(bool force);
         void trace_bounds(char const* solver);
+        void share_bounds();
+        bool is_dominated() const;
 
         void process_mutex(expr_ref_vector& mutex, obj_map<expr, rational>& new_soft);
 
@@ -9,6 +9,10 @@ Abstract:
 
     Theory based MaxSAT.
 
+    The number of falsified soft constraints is counted by an
+    incremental totalizer. Each improved assignment tightens the
+    bound on the existing counter with a unit literal.
+
 Author:
 
     Nikolaj Bjorner (nbjorner) 2016-11-18
@@ -23,7 +27,7 @@ Notes:
 #include "smt/smt_theory.h"
 #include "smt/smt_context.h"
 #include "opt/opt_context.h"
-#include "util/sorting_network.h"
+#include "util/totalizer.h"
 #include "tactic/filter_model_converter.h"
 
 namespace opt {
@@ -32,12 +36,12 @@ namespace opt {
     public:
         typedef expr* literal;
         typedef ptr_vector<expr> literal_vector;
-        psort_nw<sortmax> m_sort;
+        scoped_ptr<totalizer<sortmax> > m_totalizer;
         expr_ref_vector   m_trail;
         func_decl_ref_vector m_fresh;
         ref<filter_model_converter> m_filter;
         sortmax(maxsat_context& c, weights_t& ws, expr_ref_vector const& soft): 
-            maxsmt_solver_base(c, ws, soft), m_sort(*this), m_trail(m), m_fresh(m) {}
+            maxsmt_solver_base(c, ws, soft), m_trail(m), m_fresh(m) {}
 
         virtual ~sortmax() {}
 
@@ -54,55 +58,45 @@ namespace opt {
             rational offset = m_lower;
             m_upper = offset;
             expr_ref_vector in(m);
-            expr_ref tmp(m);
-            ptr_vector<expr> out;
             obj_map<expr, rational>::iterator it = soft.begin(), end = soft.end();
             for (; it != end; ++it) {
                 if (!it->m_value.is_unsigned()) {
                     throw default_exception("sortmax can only handle unsigned weights. Use a different heuristic.");
                 }
                 unsigned n = it->m_value.get_unsigned();
+                expr* f = mk_not(it->m_key);
                 while (n > 0) {
-                    in.push_back(it->m_key);
+                    in.push_back(f);
                     --n;
                 }
-            }
-            m_sort.sorting(in.size(), in.c_ptr(), out);
-
-            // initialize sorting network outputs using the initial assignment.
-            unsigned first = 0;
-            it = soft.begin();
-            for (; it != end; ++it) {
-                expr_ref tmp(m);
-                if (m_model->eval(it->m_key, tmp) && m.is_true(tmp)) {
-                    unsigned n = it->m_value.get_unsigned();
-                    while (n > 0) {
-                        s().assert_expr(out[first]);
-                        ++first;
-                        --n;
-                    }
-                }
-                else {
+                if (!is_true(it->m_key)) {
                     m_upper += it->m_value;
                 }
             }
-            while (l_true == is_sat && first < out.size() && m_lower < m_upper) {
+            m_totalizer = alloc(totalizer<sortmax>, *this);
+            m_totalizer->add(in.size(), in.c_ptr());
+
+            // the counter is encoded up to the cost of the initial assignment
+            // and each improvement asserts a tighter bound on the same outputs.
+            while (l_true == is_sat && m_lower < m_upper) {
                 trace_bounds("sortmax");
-                s().assert_expr(out[first]);
+                rational cost = m_upper - offset;
+                s().assert_expr(m_totalizer->at_most(cost.get_unsigned() - 1));
                 is_sat = s().check_sat(0, 0);
                 TRACE("opt", tout << is_sat << "\n"; s().display(tout); tout << "\n";);
                 if (m.canceled()) {
                     is_sat = l_undef;
                 }
                 if (is_sat == l_true) {
-                    ++first;
                     s().get_model(m_model);
                     update_assignment();
-                    for (; first < out.size() && is_true(out[first]); ++first) { 
-                        s().assert_expr(out[first]);
-                    }
                     TRACE("opt", model_smt2_pp(tout, m, *m_model.get(), 0););
-                    m_upper = m_lower + rational(out.size() - first);
+                    m_upper = offset;
+                    for (it = soft.begin(); it != end; ++it) {
+                        if (!is_true(it->m_key)) {
+                            m_upper += it->m_value;
+                        }
+                    }
                     (*m_filter)(m_model);
                 }
             }
@@ -114,6 +108,12 @@ namespace opt {
             return is_sat;
         }
 
+        virtual void collect_statistics(statistics& st) const {
+            if (m_totalizer) {
+                st.update("sortmax-totalizer-clauses", m_totalizer->num_clauses());
+            }
+        }
+
         void update_assignment() {
             for (unsigned i = 0; i < m_soft.size(); ++i) {
                 m_assignment[i] = is_true(m_soft[i]);
@@ -125,11 +125,9 @@ namespace opt {
             return m_model->eval(e, tmp) && m.is_true(tmp);
         }
 
-        // definitions used for sorting network
+        // definitions used for the totalizer
         literal mk_false() { return m.mk_false(); }
         literal mk_true() { return m.mk_true(); }
-        literal mk_max(literal a, literal b) { return trail(m.mk_or(a, b)); }
-        literal mk_min(literal a, literal b) { return trail(m.mk_and(a, b)); }
         literal mk_not(literal a) { if (m.is_not(a,a)) return a; return trail(m.mk_not(a)); }
 
         std::ostream& pp(std::ostream& out, literal lit) {  return out << mk_pp(lit, m);  }
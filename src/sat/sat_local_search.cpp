@@ -0,0 +1,281 @@
+/*++
+Copyright (c) 2017 Microsoft Corporation
+
+Module Name:
+
+    sat_local_search.cpp
+
+Abstract:
+
+    Clause level local search (ProbSAT) on the irredundant clauses.
+
+    Starting from the saved phases, a random unsatisfied clause is
+    picked in every step and one of its variables is flipped with
+    probability proportional to cb^-b, where b is the number of
+    clauses that become unsatisfied by the flip. Variables assigned
+    at the base level are never flipped. The best assignment is
+    written back to the saved phases, so that a satisfying assignment
+    found by local search is found by the next dive of the CDCL search.
+
+Author:
+
+Revision History:
+
+--*/
+#include "sat/sat_local_search.h"
+#include "sat/sat_local_search_params.hpp"
+#include "sat/sat_solver.h"
+#include "util/stopwatch.h"
+#include "util/trace.h"
+#include <cmath>
+
+namespace sat {
+
+    local_search::local_search(solver & _s, params_ref const & p):
+        s(_s),
+        m_best_unsat(UINT_MAX) {
+        updt_params(p);
+        reset_statistics();
+    }
+
+    struct local_search::report {
+        local_search & m_local_search;
+        stopwatch      m_watch;
+        unsigned       m_flips;
+        report(local_search & l):
+            m_local_search(l),
+            m_flips(l.m_flips) {
+            m_watch.start();
+        }
+
+        ~report() {
+            m_watch.stop();
+            IF_VERBOSE(SAT_VB_LVL,
+                       verbose_stream() << " (sat-local-search :flips "
+                       << (m_local_search.m_flips - m_flips)
+                       << " :unsat " << m_local_search.m_best_unsat
+                       << mem_stat()
+                       << " :time " << std::fixed << std::setprecision(2) << m_watch.get_seconds() << ")\n";);
+        }
+    };
+
+    bool local_search::operator()() {
+        if (!m_local_search || s.m_ext || s.inconsistent())
+            return false;
+        SASSERT(s.scope_lvl() == 0);
+        report rpt(*this);
+        m_calls++;
+        init();
+        save_best();
+        unsigned flips = 0;
+        while (!m_unsat.empty() && flips < m_max_flips) {
+            if ((flips & 0xFFF) == 0)
+                s.checkpoint();
+            pick_flip();
+            flips++;
+            if (m_unsat.size() < m_best_unsat)
+                save_best();
+        }
+        m_flips += flips;
+        bool found = m_best_unsat == 0;
+        if (found)
+            m_models++;
+        TRACE("sat_local_search", tout << "flips: " << flips << " unsat: " << m_best_unsat << "\n";);
+        set_phases();
+        finalize();
+        return found;
+    }
+
+    void local_search::init() {
+        unsigned num_vars = s.num_vars();
+        m_value.reset();
+        m_fixed.reset();
+        m_value.resize(num_vars, false);
+        m_fixed.resize(num_vars, false);
+        for (bool_var v = 0; v < num_vars; v++) {
+            if (s.value(v) != l_undef) {
+                m_value[v] = s.value(v) == l_true;
+                m_fixed[v] = true;
+            }
+            else if (s.was_eliminated(v)) {
+                m_fixed[v] = true;
+            }
+            else {
+                m_value[v] = s.m_phase[v] == POS_PHASE;
+            }
+        }
+
+        m_lits.reset();
+        m_clause_begin.reset();
+        m_clause_begin.push_back(0);
+        m_use_list.reset();
+        m_use_list.resize(2 * num_vars);
+        clause_vector::iterator it  = s.m_clauses.begin();
+        clause_vector::iterator end = s.m_clauses.end();
+        for (; it != end; ++it) {
+            clause & c = *(*it);
+            add_clause(c.size(), c.begin());
+        }
+        svector<solver::bin_clause> bins;
+        s.collect_bin_clauses(bins, false);
+        for (unsigned i = 0; i < bins.size(); i++) {
+            literal lits[2] = { bins[i].first, bins[i].second };
+            add_clause(2, lits);
+        }
+
+        m_num_true.reset();
+        m_unsat.reset();
+        m_unsat_pos.reset();
+        m_num_true.resize(num_clauses(), 0);
+        m_unsat_pos.resize(num_clauses(), UINT_MAX);
+        for (unsigned c = 0; c < num_clauses(); c++) {
+            for (unsigned j = m_clause_begin[c]; j < m_clause_begin[c + 1]; j++) {
+                if (is_true(m_lits[j]))
+                    m_num_true[c]++;
+            }
+            if (m_num_true[c] == 0)
+                set_unsat(c);
+        }
+
+        if (m_break_prob.empty()) {
+            for (unsigned b = 0; b < 32; b++)
+                m_break_prob.push_back(std::pow(m_cb, -static_cast<double>(b)));
+        }
+        m_best_unsat = UINT_MAX;
+    }
+
+    // clauses satisfied at the base level are skipped, and literals that are false at the base level are dropped.
+    void local_search::add_clause(unsigned n, literal const * lits) {
+        unsigned begin = m_lits.size();
+        for (unsigned i = 0; i < n; i++) {
+            literal l = lits[i];
+            if (m_fixed[l.var()]) {
+                if (is_true(l)) {
+                    m_lits.shrink(begin);
+                    return;
+                }
+                continue;
+            }
+            m_lits.push_back(l);
+        }
+        unsigned c = num_clauses();
+        for (unsigned j = begin; j < m_lits.size(); j++)
+            m_use_list[m_lits[j].index()].push_back(c);
+        m_clause_begin.push_back(m_lits.size());
+    }
+
+    void local_search::set_unsat(unsigned c) {
+        SASSERT(m_unsat_pos[c] == UINT_MAX);
+        m_unsat_pos[c] = m_unsat.size();
+        m_unsat.push_back(c);
+    }
+
+    void local_search::unset_unsat(unsigned c) {
+        unsigned pos  = m_unsat_pos[c];
+        unsigned last = m_unsat.back();
+        m_unsat[pos] = last;
+        m_unsat_pos[last] = pos;
+        m_unsat.pop_back();
+        m_unsat_pos[c] = UINT_MAX;
+    }
+
+    unsigned local_search::break_count(bool_var v) const {
+        literal t(v, !m_value[v]);
+        SASSERT(is_true(t));
+        unsigned_vector const & occs = m_use_list[t.index()];
+        unsigned b = 0;
+        for (unsigned i = 0; i < occs.size(); i++) {
+            if (m_num_true[occs[i]] == 1)
+                b++;
+        }
+        return b;
+    }
+
+    void local_search::flip(bool_var v) {
+        SASSERT(!m_fixed[v]);
+        literal t(v, !m_value[v]);
+        m_value[v] = !m_value[v];
+        unsigned_vector const & to_false = m_use_list[t.index()];
+        for (unsigned i = 0; i < to_false.size(); i++) {
+            unsigned c = to_false[i];
+            if (--m_num_true[c] == 0)
+                set_unsat(c);
+        }
+        unsigned_vector const & to_true = m_use_list[(~t).index()];
+        for (unsigned i = 0; i < to_true.size(); i++) {
+            unsigned c = to_true[i];
+            if (m_num_true[c]++ == 0)
+                unset_unsat(c);
+        }
+    }
+
+    void local_search::pick_flip() {
+        unsigned c = m_unsat[s.m_rand() % m_unsat.size()];
+        unsigned begin = m_clause_begin[c], end = m_clause_begin[c + 1];
+        double sum = 0;
+        m_probs.reset();
+        for (unsigned j = begin; j < end; j++) {
+            unsigned b = break_count(m_lits[j].var());
+            double p = m_break_prob[std::min(b, m_break_prob.size() - 1)];
+            m_probs.push_back(p);
+            sum += p;
+        }
+        if (begin == end)
+            return;
+        double r = sum * s.m_rand() / (random_gen::max_value() + 1.0);
+        unsigned j = 0;
+        for (; j + 1 < m_probs.size(); j++) {
+            r -= m_probs[j];
+            if (r < 0)
+                break;
+        }
+        flip(m_lits[begin + j].var());
+    }
+
+    void local_search::save_best() {
+        m_best_unsat = m_unsat.size();
+        m_best_value.reset();
+        m_best_value.append(m_value);
+    }
+
+    void local_search::set_phases() {
+        for (bool_var v = 0; v < m_best_value.size(); v++) {
+            if (!m_fixed[v])
+                s.m_phase[v] = m_best_value[v] ? POS_PHASE : NEG_PHASE;
+        }
+    }
+
+    void local_search::finalize() {
+        m_lits.finalize();
+        m_clause_begin.finalize();
+        m_use_list.finalize();
+        m_num_true.finalize();
+        m_unsat.finalize();
+        m_unsat_pos.finalize();
+        m_best_value.finalize();
+    }
+
+    void local_search::updt_params(params_ref const & _p) {
+        sat_local_search_params p(_p);
+        m_local_search = p.local_search();
+        m_max_flips    = p.local_search_flips();
+        m_cb           = std::max(1.0, p.local_search_cb());
+        m_break_prob.reset();
+    }
+
+    void local_search::collect_param_descrs(param_descrs & d) {
+        sat_local_search_params::collect_param_descrs(d);
+    }
+
+    void local_search::collect_statistics(statistics & st) const {
+        st.update("local search calls", m_calls);
+        st.update("local search models", m_models);
+        st.update("local search flips", m_flips);
+    }
+
+    void local_search::reset_statistics() {
+        m_calls  = 0;
+        m_models = 0;
+        m_flips  = 0;
+    }
+};
@@ -0,0 +1,89 @@
+/*++
+Copyright (c) 2017 Microsoft Corporation
+
+Module Name:
+
+    sat_local_search.h
+
+Abstract:
+
+    Clause level local search (ProbSAT) on the irredundant clauses.
+    The best assignment found is used to seed the saved phases.
+
+Author:
+
+Revision History:
+
+--*/
+#ifndef SAT_LOCAL_SEARCH_H_
+#define SAT_LOCAL_SEARCH_H_
+
+#include "sat/sat_types.h"
+#include "util/statistics.h"
+#include "util/params.h"
+
+namespace sat {
+    class solver;
+
+    class local_search {
+        struct report;
+
+        solver &                s;
+
+        // clauses, with the literals of clause i in m_lits[m_clause_begin[i] .. m_clause_begin[i+1]]
+        literal_vector          m_lits;
+        unsigned_vector         m_clause_begin;
+        vector<unsigned_vector> m_use_list;      // literal index -> clauses containing the literal
+        unsigned_vector         m_num_true;      // clause -> number of true literals
+        unsigned_vector         m_unsat;         // clauses without true literals
+        unsigned_vector         m_unsat_pos;     // clause -> position in m_unsat
+        svector<bool>           m_value;
+        svector<bool>           m_fixed;         // assigned at the base level or eliminated
+        svector<bool>           m_best_value;
+        unsigned                m_best_unsat;
+        svector<double>         m_break_prob;    // m_break_prob[b] = cb^-b
+        svector<double>         m_probs;
+
+        // config
+        bool                    m_local_search;
+        unsigned                m_max_flips;
+        double                  m_cb;
+
+        // stats
+        unsigned                m_calls;
+        unsigned                m_models;
+        unsigned                m_flips;
+
+        bool is_true(literal l) const { return m_value[l.var()] != l.sign(); }
+        unsigned num_clauses() const { return m_clause_begin.size() - 1; }
+
+        void init();
+        void add_clause(unsigned n, literal const * lits);
+        void set_unsat(unsigned c);
+        void unset_unsat(unsigned c);
+        unsigned break_count(bool_var v) const;
+        void flip(bool_var v);
+        void pick_flip();
+        void save_best();
+        void set_phases();
+        void finalize();
+
+    public:
+        local_search(solver & s, params_ref const & p);
+
+        /**
+           \brief run a round of local search starting from the saved phases.
+           Return true if the assignment found satisfies all clauses.
+        */
+        bool operator()();
+
+        void updt_params(params_ref const & p);
+        static void collect_param_descrs(param_descrs & d);
+
+        void collect_statistics(statistics & st) const;
+        void reset_statistics();
+    };
+
+};
+
+#endif
@@ -0,0 +1,234 @@
+/*++
+Copyright (c) 2017 Microsoft Corporation
+
+Module Name:
+
+    sat_lookahead.cpp
+
+Abstract:
+
+    Lookahead based cube generation.
+
+    At every node of the split tree the most active unassigned
+    candidate variables are scored by propagating each of their
+    literals. A literal whose propagation fails is a failed literal:
+    its negation is asserted at the node and the candidates are
+    scored again. If both literals of a variable fail, the node is
+    refuted and produces no cube. Otherwise the node branches on the
+    variable maximizing n1*n2 + n1 + n2, where n1 and n2 are the
+    numbers of literals implied by its two literals. The decisions on
+    a path of length max_depth, or on a path where no candidate is
+    left, form a cube. Implied literals are left out of the cubes,
+    so every cube only contains candidate literals.
+
+Author:
+
+Revision History:
+
+--*/
+#include "sat/sat_lookahead.h"
+#include "sat/sat_lookahead_params.hpp"
+#include "sat/sat_solver.h"
+#include "util/stopwatch.h"
+#include "util/trace.h"
+
+namespace sat {
+
+    lookahead::lookahead(solver & _s, params_ref const & p):
+        s(_s),
+        m_canceled(false) {
+        updt_params(p);
+        reset_statistics();
+    }
+
+    struct lookahead::report {
+        lookahead & m_lookahead;
+        stopwatch   m_watch;
+        unsigned    m_cubes;
+        unsigned    m_failed;
+        report(lookahead & l):
+            m_lookahead(l),
+            m_cubes(l.m_cubes),
+            m_failed(l.m_failed) {
+            m_watch.start();
+        }
+
+        ~report() {
+            m_watch.stop();
+            IF_VERBOSE(SAT_VB_LVL,
+                       verbose_stream() << " (sat-lookahead :cubes "
+                       << (m_lookahead.m_cubes - m_cubes)
+                       << " :failed-literals " << (m_lookahead.m_failed - m_failed)
+                       << mem_stat()
+                       << " :time " << std::fixed << std::setprecision(2) << m_watch.get_seconds() << ")\n";);
+        }
+    };
+
+    // Return false if l is a failed literal.
+    // Otherwise num_implied is the number of literals assigned by propagating l.
+    bool lookahead::try_lit(literal l, unsigned & num_implied) {
+        SASSERT(s.m_qhead == s.m_trail.size());
+        SASSERT(s.value(l) == l_undef);
+        m_probes++;
+        s.push();
+        unsigned old_tr_sz = s.m_trail.size();
+        s.assign(l, justification());
+        s.propagate(false);
+        bool ok = !s.inconsistent();
+        num_implied = s.m_trail.size() - old_tr_sz;
+        s.pop(1);
+        return ok;
+    }
+
+    struct activity_gt {
+        svector<unsigned> const & m_activity;
+        activity_gt(svector<unsigned> const & act):m_activity(act) {}
+        bool operator()(bool_var v1, bool_var v2) const { return m_activity[v1] > m_activity[v2]; }
+    };
+
+    void lookahead::collect_candidates(bool_var_vector const & vars) {
+        m_candidates.reset();
+        for (unsigned i = 0; i < vars.size(); ++i) {
+            bool_var v = vars[i];
+            if (s.value(v) == l_undef && !s.was_eliminated(v)) {
+                m_candidates.push_back(v);
+            }
+        }
+        if (m_candidates.size() > m_max_candidates) {
+            std::partial_sort(m_candidates.begin(), m_candidates.begin() + m_max_candidates, m_candidates.end(), activity_gt(s.m_activity));
+            m_candidates.shrink(m_max_candidates);
+        }
+    }
+
+    // Return l_false if the current node is refuted,
+    // l_undef if there are no candidates left or lookahead was canceled,
+    // and l_true if l is the literal to branch on.
+    lbool lookahead::select(bool_var_vector const & vars, literal & l) {
+    start:
+        collect_candidates(vars);
+        double best_score = -1;
+        l = null_literal;
+        for (unsigned i = 0; i < m_candidates.size(); ++i) {
+            if (!s.m_rlimit.inc()) {
+                m_canceled = true;
+                return l_undef;
+            }
+            bool_var v = m_candidates[i];
+            if (s.value(v) != l_undef) {
+                continue;
+            }
+            literal pos(v, false);
+            unsigned n1 = 0, n2 = 0;
+            bool ok1 = try_lit(pos, n1);
+            bool ok2 = try_lit(~pos, n2);
+            if (!ok1 && !ok2) {
+                return l_false;
+            }
+            if (!ok1 || !ok2) {
+                TRACE("sat_lookahead", tout << "failed literal: " << (ok1 ? ~pos : pos) << "\n";);
+                m_failed++;
+                s.assign(ok1 ? pos : ~pos, justification());
+                s.propagate(false);
+                if (s.inconsistent()) {
+                    return l_false;
+                }
+                goto start;
+            }
+            double score = static_cast<double>(n1) * n2 + n1 + n2;
+            if (score > best_score) {
+                best_score = score;
+                // branch first on the literal that propagates more.
+                l = n1 >= n2 ? pos : ~pos;
+            }
+        }
+        return l == null_literal ? l_undef : l_true;
+    }
+
+    void lookahead::cube(bool_var_vector const & vars, unsigned depth, literal_vector & path, vector<literal_vector> & cubes) {
+        literal l;
+        if (depth == 0 || m_canceled) {
+            cubes.push_back(path);
+            return;
+        }
+        switch (select(vars, l)) {
+        case l_false:
+            m_refuted++;
+            return;
+        case l_undef:
+            cubes.push_back(path);
+            return;
+        default:
+            break;
+        }
+        TRACE("sat_lookahead", tout << "depth: " << depth << " split: " << l << "\n";);
+        for (unsigned i = 0; i < 2; ++i, l.neg()) {
+            s.push();
+            s.assign(l, justification());
+            s.propagate(false);
+            if (s.inconsistent()) {
+                m_refuted++;
+            }
+            else {
+                path.push_back(l);
+                cube(vars, depth - 1, path, cubes);
+                path.pop_back();
+            }
+            s.pop(1);
+        }
+    }
+
+    lbool lookahead::operator()(bool_var_vector const & vars, unsigned max_depth, vector<literal_vector> & cubes) {
+        cubes.reset();
+        s.pop_to_base_level();
+        if (s.inconsistent()) {
+            return l_false;
+        }
+        s.propagate(false);
+        if (s.inconsistent()) {
+            return l_false;
+        }
+        report rpt(*this);
+        m_calls++;
+        m_canceled = false;
+        s.push();
+        for (unsigned i = 0; !s.inconsistent() && i < s.m_user_scope_literals.size(); ++i) {
+            s.assign(~s.m_user_scope_literals[i], justification());
+        }
+        if (!s.inconsistent()) {
+            s.propagate(false);
+        }
+        if (!s.inconsistent()) {
+            literal_vector path;
+            cube(vars, max_depth, path, cubes);
+        }
+        s.pop_to_base_level();
+        m_cubes += cubes.size();
+        m_candidates.finalize();
+        return cubes.empty() ? l_false : l_undef;
+    }
+
+    void lookahead::updt_params(params_ref const & _p) {
+        sat_lookahead_params p(_p);
+        m_max_candidates = std::max(1u, p.lookahead_candidates());
+    }
+
+    void lookahead::collect_param_descrs(param_descrs & d) {
+        sat_lookahead_params::collect_param_descrs(d);
+    }
+
+    void lookahead::collect_statistics(statistics & st) const {
+        st.update("lookahead calls", m_calls);
+        st.update("lookahead cubes", m_cubes);
+        st.update("lookahead probes", m_probes);
+        st.update("lookahead failed literals", m_failed);
+        st.update("lookahead refuted", m_refuted);
+    }
+
+    void lookahead::reset_statistics() {
+        m_calls   = 0;
+        m_cubes   = 0;
+        m_probes  = 0;
+        m_failed  = 0;
+        m_refuted = 0;
+    }
+};
@@ -0,0 +1,71 @@
+/*++
+Copyright (c) 2017 Microsoft Corporation
+
+Module Name:
+
+    sat_lookahead.h
+
+Abstract:
+
+    Lookahead based cube generation.
+    The search space is split into cubes by branching on the
+    literals with the best lookahead score.
+
+Author:
+
+Revision History:
+
+--*/
+#ifndef SAT_LOOKAHEAD_H_
+#define SAT_LOOKAHEAD_H_
+
+#include "sat/sat_types.h"
+#include "util/statistics.h"
+#include "util/params.h"
+
+namespace sat {
+    class solver;
+
+    class lookahead {
+        struct report;
+
+        solver &                s;
+        bool_var_vector         m_candidates;
+        bool                    m_canceled;
+
+        // config
+        unsigned                m_max_candidates;
+
+        // stats
+        unsigned                m_calls;
+        unsigned                m_cubes;
+        unsigned                m_probes;
+        unsigned                m_failed;
+        unsigned                m_refuted;
+
+        bool try_lit(literal l, unsigned & num_implied);
+        void collect_candidates(bool_var_vector const & vars);
+        lbool select(bool_var_vector const & vars, literal & l);
+        void cube(bool_var_vector const & vars, unsigned depth, literal_vector & path, vector<literal_vector> & cubes);
+
+    public:
+        lookahead(solver & s, params_ref const & p);
+
+        /**
+           \brief split the search space into at most 2^max_depth cubes over the variables vars.
+           Every model of the clauses satisfies one of the cubes.
+           Return l_false if the clauses are unsatisfiable, then cubes is empty.
+           Otherwise return l_undef.
+        */
+        lbool operator()(bool_var_vector const & vars, unsigned max_depth, vector<literal_vector> & cubes);
+
+        void updt_params(params_ref const & p);
+        static void collect_param_descrs(param_descrs & d);
+
+        void collect_statistics(statistics & st) const;
+        void reset_statistics();
+    };
+
+};
+
+#endif
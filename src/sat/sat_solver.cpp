@@ -42,6 +42,8 @@ namespace sat {
         m_scc(*this, p),
         m_asymm_branch(*this, p),
         m_probing(*this, p),
+        m_local_search(*this, p),
+        m_lookahead(*this, p),
         m_mus(*this),
         m_inconsistent(false),
         m_num_frozen(0),
@@ -1222,6 +1224,12 @@ namespace sat {
         CASSERT("sat_missed_prop", check_missed_propagation());
         CASSERT("sat_simplify_bug", check_invariant());
 
+        if (m_local_search()) {
+            // the saved phases satisfy all clauses; use them for the next dive.
+            m_phase_counter  = 0;
+            m_phase_cache_on = true;
+        }
+
         if (m_ext) {
             m_ext->clauses_modifed();
             m_ext->simplify();
@@ -2754,6 +2762,8 @@ namespace sat {
         m_simplifier.updt_params(p);
         m_asymm_branch.updt_params(p);
         m_probing.updt_params(p);
+        m_local_search.updt_params(p);
+        m_lookahead.updt_params(p);
         m_scc.updt_params(p);
         m_rand.set_seed(m_config.m_random_seed);
     }
@@ -2763,6 +2773,8 @@ namespace sat {
         simplifier::collect_param_descrs(d);
         asymm_branch::collect_param_descrs(d);
         probing::collect_param_descrs(d);
+        local_search::collect_param_descrs(d);
+        lookahead::collect_param_descrs(d);
         scc::collect_param_descrs(d);
     }
 
@@ -2773,6 +2785,8 @@ namespace sat {
         m_scc.collect_statistics(st);
         m_asymm_branch.collect_statistics(st);
         m_probing.collect_statistics(st);
+        m_local_search.collect_statistics(st);
+        m_lookahead.collect_statistics(st);
     }
 
     void solver::reset_statistics() {
@@ -2781,6 +2795,8 @@ namespace sat {
         m_simplifier.reset_statistics();
         m_asymm_branch.reset_statistics();
         m_probing.reset_statistics();
+        m_local_search.reset_statistics();
+        m_lookahead.reset_statistics();
     }
 
     // -----------------------
@@ -30,6 +30,8 @@ Revision History:
 #include "sat/sat_simplifier.h"
 #include "sat/sat_scc.h"
 #include "sat/sat_asymm_branch.h"
+#include "sat/sat_local_search.h"
+#include "sat/sat_lookahead.h"
 #include "sat/sat_iff3_finder.h"
 #include "sat/sat_probing.h"
 #include "sat/sat_mus.h"
@@ -87,6 +89,8 @@ namespace sat {
         scc                     m_scc;
         asymm_branch            m_asymm_branch;
         probing                 m_probing;
+        local_search            m_local_search;
+        lookahead               m_lookahead;
         mus                     m_mus;           // MUS for minimal core extraction
         bool                    m_inconsistent;
         // A conflict is usually a single justification. That is, a justification
@@ -144,6 +148,8 @@ namespace sat {
         friend class elim_eqs;
         friend class asymm_branch;
         friend class probing;
+        friend class local_search;
+        friend class lookahead;
         friend class iff3_finder;
         friend class mus;
         friend struct mk_stat;
@@ -476,6 +482,11 @@ namespace sat {
 
         lbool get_consequences(literal_vector const& assms, bool_var_vector const& vars, vector<literal_vector>& conseq);
 
+        /**
+           \brief split the search space into cubes over vars by lookahead, see lookahead::operator().
+        */
+        lbool cube(bool_var_vector const& vars, unsigned max_depth, vector<literal_vector>& cubes) { return m_lookahead(vars, max_depth, cubes); }
+
     private:
 
         typedef hashtable<unsigned, u_hash, u_eq> index_set;
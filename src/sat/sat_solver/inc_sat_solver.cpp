@@ -91,15 +91,8 @@ public:
             throw default_exception("Cannot translate sat solver at non-base level");
         }
         inc_sat_solver* result = alloc(inc_sat_solver, dst_m, p);
-        expr_ref fml(dst_m);
-        for (unsigned i = 0; i < m_fmls.size(); ++i) {
-            fml = tr(m_fmls[i].get());
-            result->m_fmls.push_back(fml);
-        }
-        for (unsigned i = 0; i < m_asmsf.size(); ++i) {
-            fml = tr(m_asmsf[i].get());
-            result->m_asmsf.push_back(fml);
-        }
+        tr(m_fmls.size(), m_fmls.c_ptr(), result->m_fmls);
+        tr(m_asmsf.size(), m_asmsf.c_ptr(), result->m_asmsf);
         return result;
     }
 
@@ -326,6 +319,61 @@ public:
         return l_true;
     }
 
+    virtual lbool cube(unsigned max_depth, vector<expr_ref_vector>& cubes) {
+        init_preprocess();
+        cubes.reset();
+        m_solver.pop_to_base_level();
+        lbool r = internalize_formulas();
+        if (r == l_undef) {
+            return solver::cube(max_depth, cubes);
+        }
+        if (r == l_false) {
+            return r;
+        }
+        // split only on variables that can be expressed in terms of the assertions:
+        // Boolean constants and the bits of bit-vector constants.
+        expr_ref_vector var2expr(m);
+        sat::bool_var_vector vars;
+        bv_util bvutil(m);
+        obj_map<func_decl, expr*> const& const2bits = m_bb_rewriter->const2bits();
+        obj_map<func_decl, expr*>::iterator it = const2bits.begin(), end = const2bits.end();
+        for (; it != end; ++it) {
+            if (it->m_key->is_skolem()) continue;
+            app* abv = to_app(it->m_value);
+            expr_ref c(m.mk_const(it->m_key), m);
+            for (unsigned j = 0; j < abv->get_num_args(); ++j) {
+                sat::bool_var v = m_map.to_bool_var(abv->get_arg(j));
+                if (v != sat::null_bool_var && !var2expr.get(v, 0)) {
+                    var2expr.reserve(v + 1);
+                    var2expr[v] = m.mk_eq(bvutil.mk_extract(j, j, c), bvutil.mk_numeral(1, 1));
+                    vars.push_back(v);
+                }
+            }
+        }
+        atom2bool_var::iterator it2 = m_map.begin(), end2 = m_map.end();
+        for (; it2 != end2; ++it2) {
+            expr* e = it2->m_key;
+            sat::bool_var v = it2->m_value;
+            if (is_uninterp_const(e) && !to_app(e)->get_decl()->is_skolem() && !var2expr.get(v, 0)) {
+                var2expr.reserve(v + 1);
+                var2expr[v] = e;
+                vars.push_back(v);
+            }
+        }
+        vector<sat::literal_vector> lcubes;
+        r = m_solver.cube(vars, max_depth, lcubes);
+        for (unsigned i = 0; i < lcubes.size(); ++i) {
+            expr_ref_vector cube(m);
+            for (unsigned j = 0; j < lcubes[i].size(); ++j) {
+                sat::literal lit = lcubes[i][j];
+                expr* e = var2expr.get(lit.var());
+                cube.push_back(lit.sign() ? m.mk_not(e) : e);
+            }
+            cubes.push_back(cube);
+        }
+        return r;
+    }
+
     virtual std::string reason_unknown() const {
         return m_unknown;
     }
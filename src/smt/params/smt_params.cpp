@@ -40,6 +40,7 @@ void smt_params::updt_local_params(params_ref const & _p) {
     m_rlimit  = p.rlimit();
     m_max_conflicts = p.max_conflicts();
     m_core_validate = p.core_validate();
+    m_lookahead_candidates = p.lookahead_candidates();
     m_logic = _p.get_sym("logic", m_logic);
     m_string_solver = p.string_solver();
     model_params mp(_p);
@@ -52,6 +53,7 @@ void smt_params::updt_local_params(params_ref const & _p) {
     m_dump_benchmarks = false;
     m_dump_min_time = 0.5;
     m_dump_recheck = false;
+    m_max_shared_context_size = 0;
 }
 
 void smt_params::updt_params(params_ref const & p) {
@@ -151,6 +153,7 @@ void smt_params::display(std::ostream & out) const {
 
     DISPLAY_PARAM(m_display_installed_theories);
     DISPLAY_PARAM(m_core_validate);
+    DISPLAY_PARAM(m_lookahead_candidates);
 
     DISPLAY_PARAM(m_preprocess);
     DISPLAY_PARAM(m_user_theory_preprocess_axioms);
@@ -203,6 +203,13 @@ struct smt_params : public preprocessor_params,
     bool             m_display_installed_theories;
     bool             m_core_validate;
 
+    // -----------------------------------
+    //
+    // Cubes
+    //
+    // -----------------------------------
+    unsigned         m_lookahead_candidates;
+
     // -----------------------------------
     //
     // From front_end_params
@@ -226,6 +233,7 @@ struct smt_params : public preprocessor_params,
     bool                m_dump_benchmarks;
     double              m_dump_min_time;
     bool                m_dump_recheck;
+    unsigned            m_max_shared_context_size;
 
     // -----------------------------------
     //
@@ -296,6 +304,7 @@ struct smt_params : public preprocessor_params,
         m_progress_sampling_freq(0),
         m_display_installed_theories(false),
         m_core_validate(false),
+        m_lookahead_candidates(32),
         m_preprocess(true), // temporary hack for disabling all preprocessing..
         m_user_theory_preprocess_axioms(false),
         m_user_theory_persist_axioms(false),
@@ -152,15 +152,19 @@ namespace smt {
         asserted_formulas& dst_af = dst_ctx.m_asserted_formulas;
 
         // Copy asserted formulas.
+        ptr_vector<expr> fmls;
+        expr_ref_vector new_fmls(dst_m);
+        for (unsigned i = 0; i < src_af.get_num_formulas(); ++i) {
+            fmls.push_back(src_af.get_formula(i));
+        }
+        tr(fmls.size(), fmls.c_ptr(), new_fmls);
         for (unsigned i = 0; i < src_af.get_num_formulas(); ++i) {
-            expr_ref fml(dst_m);
             proof_ref pr(dst_m);
             proof* pr_src = src_af.get_formula_proof(i);
-            fml = tr(src_af.get_formula(i));
             if (pr_src) {
                 pr = tr(pr_src);
             }
-            dst_af.assert_expr(fml, pr);
+            dst_af.assert_expr(new_fmls.get(i), pr);
         }
 
         if (!src_ctx.m_setup.already_configured()) {
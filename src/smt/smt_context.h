@@ -1442,6 +1442,20 @@ namespace smt {
 
         void display_partial_assignment(std::ostream& out, expr_ref_vector const& asms, unsigned min_core_size);
 
+        // -----------------------------------
+        //
+        // Cubes
+        //
+        // -----------------------------------
+
+        void collect_cube_candidates(bool_var_vector& vars);
+
+        bool lookahead_literal(literal l, unsigned& num_implied);
+
+        lbool select_cube_literal(bool_var_vector const& vars, literal& l);
+
+        void cube(bool_var_vector const& vars, unsigned depth, literal_vector& path, vector<expr_ref_vector>& cubes);
+
     public:
         context(ast_manager & m, smt_params & fp, params_ref const & p = params_ref());
 
@@ -1487,6 +1501,8 @@ namespace smt {
 
         lbool preferred_sat(expr_ref_vector const& asms, vector<expr_ref_vector>& cores);
 
+        lbool cube(unsigned max_depth, vector<expr_ref_vector>& cubes);
+
         lbool setup_and_check(bool reset_cancel = true);
 
         // return 'true' if assertions are inconsistent.
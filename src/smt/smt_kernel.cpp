@@ -123,6 +123,10 @@ namespace smt {
         lbool find_mutexes(expr_ref_vector const& vars, vector<expr_ref_vector>& mutexes) {
             return m_kernel.find_mutexes(vars, mutexes);
         }
+
+        lbool cube(unsigned max_depth, vector<expr_ref_vector>& cubes) {
+            return m_kernel.cube(max_depth, cubes);
+        }
         
         void get_model(model_ref & m) const {
             m_kernel.get_model(m);
@@ -295,6 +299,10 @@ namespace smt {
         return m_imp->find_mutexes(vars, mutexes);
     }
 
+    lbool kernel::cube(unsigned max_depth, vector<expr_ref_vector>& cubes) {
+        return m_imp->cube(max_depth, cubes);
+    }
+
     void kernel::get_model(model_ref & m) const {
         m_imp->get_model(m);
     }
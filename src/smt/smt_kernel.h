@@ -143,6 +143,11 @@ namespace smt {
         */
         lbool preferred_sat(expr_ref_vector const& asms, vector<expr_ref_vector>& cores);
 
+        /**
+           \brief split the search space into cubes by lookahead.
+        */
+        lbool cube(unsigned max_depth, vector<expr_ref_vector>& cubes);
+
         /**
            \brief Return the model associated with the last check command.
         */
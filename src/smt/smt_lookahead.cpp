@@ -0,0 +1,188 @@
+/*++
+Copyright (c) 2017 Microsoft Corporation
+
+Module Name:
+
+    smt_lookahead.cpp
+
+Abstract:
+
+    Lookahead based cube generation for smt_context.
+
+    The search space is split by branching on atoms of the asserted
+    formulas. At every node the most active unassigned atoms are scored
+    by propagating both of their literals; the atom maximizing
+    n1*n2 + n1 + n2 is selected, where n1 and n2 count the implied
+    literals. Failed literals are asserted negated at the node, and
+    nodes where both literals of an atom fail are refuted. The
+    decisions on the remaining paths form the cubes.
+
+Author:
+
+Revision History:
+
+--*/
+#include "smt/smt_context.h"
+#include "ast/for_each_expr.h"
+#include "util/obj_hashtable.h"
+
+namespace smt {
+
+    struct collect_bool_apps_proc {
+        ast_manager &         m;
+        obj_hashtable<expr> & m_apps;
+        collect_bool_apps_proc(ast_manager & m, obj_hashtable<expr> & apps): m(m), m_apps(apps) {}
+        void operator()(var * v) {}
+        void operator()(quantifier * q) {}
+        void operator()(app * a) {
+            if (m.is_bool(a)) {
+                m_apps.insert(a);
+            }
+        }
+    };
+
+    /**
+       \brief Collect the Boolean variables whose atoms occur in the asserted formulas
+       and do not contain symbols introduced by preprocessing.
+       Cubes over these atoms can be asserted in other solvers for the same formulas.
+    */
+    void context::collect_cube_candidates(bool_var_vector& vars) {
+        obj_hashtable<expr> apps;
+        collect_bool_apps_proc proc(m_manager, apps);
+        expr_mark visited;
+        for (unsigned i = 0; i < get_num_asserted_formulas(); ++i) {
+            for_each_expr(proc, visited, get_asserted_formula(i));
+        }
+        for (bool_var v = 0; v < static_cast<bool_var>(get_num_bool_vars()); ++v) {
+            expr * e = bool_var2expr(v);
+            if (e && apps.contains(e) && !has_skolem_functions(e)) {
+                vars.push_back(v);
+            }
+        }
+    }
+
+    bool context::lookahead_literal(literal l, unsigned& num_implied) {
+        SASSERT(get_assignment(l) == l_undef);
+        push_scope();
+        unsigned old_sz = m_assigned_literals.size();
+        assign(l, b_justification::mk_axiom(), true);
+        bool ok = propagate();
+        num_implied = m_assigned_literals.size() - old_sz;
+        pop_scope(1);
+        return ok;
+    }
+
+    struct bool_var_activity_gt {
+        svector<double> const & m_activity;
+        bool_var_activity_gt(svector<double> const & act): m_activity(act) {}
+        bool operator()(bool_var v1, bool_var v2) const { return m_activity[v1] > m_activity[v2]; }
+    };
+
+    /**
+       \brief Return l_false if the current node is refuted, l_undef if there is nothing
+       left to split on, and l_true if l is the literal to split on.
+    */
+    lbool context::select_cube_literal(bool_var_vector const& vars, literal& l) {
+        unsigned max_candidates = std::max(1u, m_fparams.m_lookahead_candidates);
+        bool_var_vector candidates;
+    start:
+        candidates.reset();
+        for (unsigned i = 0; i < vars.size(); ++i) {
+            if (get_assignment(vars[i]) == l_undef) {
+                candidates.push_back(vars[i]);
+            }
+        }
+        if (candidates.size() > max_candidates) {
+            std::partial_sort(candidates.begin(), candidates.begin() + max_candidates, candidates.end(), bool_var_activity_gt(m_activity));
+            candidates.shrink(max_candidates);
+        }
+        double best_score = -1;
+        l = null_literal;
+        for (unsigned i = 0; i < candidates.size(); ++i) {
+            if (get_cancel_flag()) {
+                return l_undef;
+            }
+            bool_var v = candidates[i];
+            if (get_assignment(v) != l_undef) {
+                continue;
+            }
+            literal pos(v, false);
+            unsigned n1 = 0, n2 = 0;
+            bool ok1 = lookahead_literal(pos, n1);
+            bool ok2 = lookahead_literal(~pos, n2);
+            if (!ok1 && !ok2) {
+                return l_false;
+            }
+            if (!ok1 || !ok2) {
+                TRACE("smt_lookahead", tout << "failed literal: " << (ok1 ? ~pos : pos) << "\n";);
+                assign(ok1 ? pos : ~pos, b_justification::mk_axiom(), true);
+                if (!propagate()) {
+                    return l_false;
+                }
+                goto start;
+            }
+            double score = static_cast<double>(n1) * n2 + n1 + n2;
+            if (score > best_score) {
+                best_score = score;
+                l = n1 >= n2 ? pos : ~pos;
+            }
+        }
+        return l == null_literal ? l_undef : l_true;
+    }
+
+    void context::cube(bool_var_vector const& vars, unsigned depth, literal_vector& path, vector<expr_ref_vector>& cubes) {
+        literal l;
+        lbool r = l_undef;
+        if (depth > 0 && !get_cancel_flag()) {
+            r = select_cube_literal(vars, l);
+        }
+        if (r == l_false) {
+            return;
+        }
+        if (r == l_undef) {
+            expr_ref_vector c(m_manager);
+            expr_ref e(m_manager);
+            for (unsigned i = 0; i < path.size(); ++i) {
+                literal2expr(path[i], e);
+                c.push_back(e);
+            }
+            cubes.push_back(c);
+            return;
+        }
+        TRACE("smt_lookahead", tout << "depth: " << depth << " split: " << l << "\n";);
+        for (unsigned i = 0; i < 2; ++i, l.neg()) {
+            push_scope();
+            assign(l, b_justification::mk_axiom(), true);
+            if (propagate()) {
+                path.push_back(l);
+                cube(vars, depth - 1, path, cubes);
+                path.pop_back();
+            }
+            pop_scope(1);
+        }
+    }
+
+    lbool context::cube(unsigned max_depth, vector<expr_ref_vector>& cubes) {
+        pop_to_base_lvl();
+        cubes.reset();
+        setup_context(false);
+        internalize_assertions();
+        if (m_asserted_formulas.inconsistent() || inconsistent()) {
+            return l_false;
+        }
+        init_search();
+        flet<bool> l(m_searching, true);
+        bool_var_vector vars;
+        collect_cube_candidates(vars);
+        push_scope();
+        if (propagate()) {
+            literal_vector path;
+            cube(vars, max_depth, path, cubes);
+        }
+        pop_scope(1);
+        end_search();
+        TRACE("smt_lookahead", tout << "candidates: " << vars.size() << " cubes: " << cubes.size() << "\n";);
+        return cubes.empty() ? l_false : l_undef;
+    }
+
+};
@@ -105,6 +105,10 @@ namespace smt {
             return m_context.find_mutexes(vars, mutexes);
         }
 
+        virtual lbool cube(unsigned max_depth, vector<expr_ref_vector>& cubes) {
+            return m_context.cube(max_depth, cubes);
+        }
+
         virtual void assert_expr(expr * t) {
             m_context.assert_expr(t);
         }
@@ -24,6 +24,7 @@ Notes:
 #include "util/lp/lp_params.hpp"
 #include "ast/rewriter/rewriter_types.h"
 #include "tactic/filter_model_converter.h"
+#include "tactic/core/solve_components_tactic.h"
 #include "ast/ast_util.h"
 #include "solver/solver2tactic.h"
 #include "smt/smt_solver.h"
@@ -298,3 +299,7 @@ tactic * mk_smt_tactic_using(bool auto_config, params_ref const & _p) {
     return using_params(r, p);
 }
 
+
+tactic * mk_smt_components_tactic(ast_manager & m, params_ref const & p) {
+    return mk_solve_components_tactic(m, mk_smt_tactic(p), p);
+}
@@ -30,9 +30,12 @@ class filter_model_converter;
 tactic * mk_smt_tactic(params_ref const & p = params_ref());
 // syntax sugar for using_params(mk_smt_tactic(), p) where p = (:auto_config, auto_config)
 tactic * mk_smt_tactic_using(bool auto_config = true, params_ref const & p = params_ref());
+// apply the smt tactic to the independent components of a goal in parallel.
+tactic * mk_smt_components_tactic(ast_manager & m, params_ref const & p = params_ref());
 
 
 /*
   ADD_TACTIC("smt", "apply a SAT based SMT solver.", "mk_smt_tactic(p)") 
+  ADD_TACTIC("smt-components", "apply a SAT based SMT solver to the components of a goal that share no uninterpreted symbols in parallel.", "mk_smt_components_tactic(m, p)")
 */
 #endif
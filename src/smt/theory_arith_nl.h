@@ -2239,6 +2239,7 @@ namespace smt {
         if (m_nl_gb_exhausted)
             return GB_FAIL;
         grobner gb(get_manager(), m_dep_manager);
+        gb.set_f4(m_params.m_nl_arith_gb_f4);
         init_grobner(nl_cluster, gb);
         TRACE("non_linear", display(tout););
         bool warn            = false;
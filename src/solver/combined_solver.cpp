@@ -212,6 +212,12 @@ public:
         return l_undef;
     }
 
+    virtual lbool cube(unsigned max_depth, vector<expr_ref_vector>& cubes) {
+        switch_inc_mode();
+        m_use_solver1_results = false;
+        return m_solver2->cube(max_depth, cubes);
+    }
+
     virtual lbool check_sat(unsigned num_assumptions, expr * const * assumptions) {
         m_check_sat_executed  = true;        
         m_use_solver1_results = false;
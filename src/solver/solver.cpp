@@ -158,6 +158,12 @@ lbool solver::preferred_sat(expr_ref_vector const& asms, vector<expr_ref_vector>
     return check_sat(0, 0);
 }
 
+lbool solver::cube(unsigned max_depth, vector<expr_ref_vector>& cubes) {
+    cubes.reset();
+    cubes.push_back(expr_ref_vector(get_manager()));
+    return l_undef;
+}
+
 bool solver::is_literal(ast_manager& m, expr* e) {
     return is_uninterp_const(e) || (m.is_not(e, e) && is_uninterp_const(e));
 }
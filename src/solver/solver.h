@@ -172,6 +172,14 @@ public:
      */
     virtual lbool preferred_sat(expr_ref_vector const& asms, vector<expr_ref_vector>& cores);
 
+    /**
+       \brief Split the search space into at most 2^max_depth cubes. Each cube is a conjunction of literals,
+       and every model of the assertions satisfies one of the cubes, so the cubes can be checked
+       independently as assumptions. Return l_false, with no cubes, if the assertions were found unsatisfiable.
+       Otherwise return l_undef. By default, the search space is not split and the only cube is empty.
+     */
+    virtual lbool cube(unsigned max_depth, vector<expr_ref_vector>& cubes);
+
     /**
        \brief Display the content of this solver.
     */
@@ -246,6 +246,193 @@ expr * tactic2solver::get_assertion(unsigned idx) const {
 }
 
 
+/**
+   \brief Incremental version of tactic2solver.
+
+   The tactic is only used for preprocessing. It is applied to the
+   assertions added since the last check, and the result is asserted
+   into an incremental solver that is reused across checks.
+   Model converters produced by the tactic are kept per scope.
+
+   Assertions are preprocessed independently of each other, so the
+   tactic should not eliminate symbols that occur in later assertions
+   (e.g., solve-eqs). Assertions are passed unchanged to the solver if
+   the tactic fails or splits the goal, or if proofs are enabled.
+*/
+class incremental_tactic2solver : public solver_na2as {
+    struct stats {
+        unsigned m_num_preprocessed;
+        unsigned m_num_unprocessed;
+        stats() { reset(); }
+        void reset() { memset(this, 0, sizeof(*this)); }
+    };
+    expr_ref_vector              m_assertions;
+    unsigned                     m_head;             // assertions before m_head are in m_solver
+    unsigned_vector              m_assertions_lim;
+    unsigned_vector              m_head_lim;
+    model_converter_ref_vector   m_mcs;
+    unsigned_vector              m_mcs_lim;
+    tactic_ref                   m_tactic;
+    ref<solver>                  m_solver;
+    params_ref                   m_params;
+    bool                         m_produce_proofs;
+    stats                        m_stats;
+
+    void internalize_assertions();
+
+public:
+    incremental_tactic2solver(ast_manager & m, tactic * t, solver * s, params_ref const & p, bool produce_proofs);
+    virtual ~incremental_tactic2solver() {}
+
+    virtual solver* translate(ast_manager& m, params_ref const& p);
+
+    virtual void updt_params(params_ref const & p);
+    virtual void collect_param_descrs(param_descrs & r);
+
+    virtual void set_produce_models(bool f) { m_solver->set_produce_models(f); }
+
+    virtual void assert_expr(expr * t) { m_assertions.push_back(t); }
+
+    virtual void push_core();
+    virtual void pop_core(unsigned n);
+    virtual lbool check_sat_core(unsigned num_assumptions, expr * const * assumptions);
+
+    virtual void collect_statistics(statistics & st) const;
+    virtual void get_unsat_core(ptr_vector<expr> & r) { m_solver->get_unsat_core(r); }
+    virtual void get_model(model_ref & m);
+    virtual proof * get_proof() { return m_solver->get_proof(); }
+    virtual std::string reason_unknown() const { return m_solver->reason_unknown(); }
+    virtual void set_reason_unknown(char const* msg) { m_solver->set_reason_unknown(msg); }
+    virtual void get_labels(svector<symbol> & r) { m_solver->get_labels(r); }
+
+    virtual void set_progress_callback(progress_callback * callback) { m_solver->set_progress_callback(callback); }
+
+    virtual unsigned get_num_assertions() const { return m_assertions.size(); }
+    virtual expr * get_assertion(unsigned idx) const { return m_assertions.get(idx); }
+
+    virtual ast_manager& get_manager() const { return m_assertions.get_manager(); }
+};
+
+incremental_tactic2solver::incremental_tactic2solver(ast_manager & m, tactic * t, solver * s, params_ref const & p, bool produce_proofs):
+    solver_na2as(m),
+    m_assertions(m),
+    m_head(0),
+    m_tactic(t),
+    m_solver(s),
+    m_params(p),
+    m_produce_proofs(produce_proofs) {
+    m_tactic->updt_params(m_params);
+}
+
+void incremental_tactic2solver::updt_params(params_ref const & p) {
+    m_params.append(p);
+    m_tactic->updt_params(m_params);
+    m_solver->updt_params(p);
+}
+
+void incremental_tactic2solver::collect_param_descrs(param_descrs & r) {
+    m_tactic->collect_param_descrs(r);
+    m_solver->collect_param_descrs(r);
+}
+
+void incremental_tactic2solver::internalize_assertions() {
+    if (m_head == m_assertions.size()) 
+        return;
+    ast_manager & m = get_manager();
+    goal_ref_buffer     result;
+    bool                ok = false;
+    if (!m_produce_proofs) {
+        goal_ref g = alloc(goal, m, false, true, false);
+        for (unsigned i = m_head; i < m_assertions.size(); ++i) {
+            g->assert_expr(m_assertions.get(i));
+        }
+        model_converter_ref mc;
+        proof_converter_ref pc;
+        expr_dependency_ref core(m);
+        try {
+            (*m_tactic)(g, result, mc, pc, core);
+            ok = result.size() == 1;
+        }
+        catch (tactic_exception & ex) {
+            IF_VERBOSE(1, verbose_stream() << "(tactic2solver \"preprocessing failed: " << ex.msg() << "\")\n";);
+            TRACE("tactic2solver", tout << "exception: " << ex.msg() << "\n";);
+        }
+        m_tactic->cleanup();
+        if (ok && mc) {
+            m_mcs.push_back(mc.get());
+        }
+    }
+    if (ok) {
+        goal const & r = *result[0];
+        for (unsigned i = 0; i < r.size(); ++i) {
+            m_solver->assert_expr(r.form(i));
+        }
+        m_stats.m_num_preprocessed += m_assertions.size() - m_head;
+    }
+    else {
+        for (unsigned i = m_head; i < m_assertions.size(); ++i) {
+            m_solver->assert_expr(m_assertions.get(i));
+        }
+        m_stats.m_num_unprocessed += m_assertions.size() - m_head;
+    }
+    m_head = m_assertions.size();
+}
+
+void incremental_tactic2solver::push_core() {
+    internalize_assertions();
+    m_solver->push();
+    m_assertions_lim.push_back(m_assertions.size());
+    m_head_lim.push_back(m_head);
+    m_mcs_lim.push_back(m_mcs.size());
+}
+
+void incremental_tactic2solver::pop_core(unsigned n) {
+    m_solver->pop(n);
+    unsigned new_lvl = m_assertions_lim.size() - n;
+    m_assertions.shrink(m_assertions_lim[new_lvl]);
+    m_head = m_head_lim[new_lvl];
+    m_mcs.shrink(m_mcs_lim[new_lvl]);
+    m_assertions_lim.shrink(new_lvl);
+    m_head_lim.shrink(new_lvl);
+    m_mcs_lim.shrink(new_lvl);
+}
+
+lbool incremental_tactic2solver::check_sat_core(unsigned num_assumptions, expr * const * assumptions) {
+    internalize_assertions();
+    return m_solver->check_sat(num_assumptions, assumptions);
+}
+
+void incremental_tactic2solver::get_model(model_ref & md) {
+    m_solver->get_model(md);
+    for (unsigned i = m_mcs.size(); md && i-- > 0; ) {
+        (*m_mcs[i])(md, 0);
+    }
+}
+
+void incremental_tactic2solver::collect_statistics(statistics & st) const {
+    m_solver->collect_statistics(st);
+    m_tactic->collect_statistics(st);
+    st.update("tactic2solver preprocessed", m_stats.m_num_preprocessed);
+    st.update("tactic2solver unprocessed", m_stats.m_num_unprocessed);
+}
+
+solver* incremental_tactic2solver::translate(ast_manager& m, params_ref const& p) {
+    if (!m_assertions_lim.empty()) {
+        throw default_exception("translation of contexts is only supported at base level");
+    }
+    ast_translation tr(get_manager(), m, false);
+    incremental_tactic2solver* r = alloc(incremental_tactic2solver, m, m_tactic->translate(m), m_solver->translate(m, p), p, m_produce_proofs);
+    for (unsigned i = 0; i < m_assertions.size(); ++i) {
+        r->m_assertions.push_back(tr(m_assertions.get(i)));
+    }
+    for (unsigned i = 0; i < m_mcs.size(); ++i) {
+        r->m_mcs.push_back(m_mcs[i]->translate(tr));
+    }
+    r->m_head = m_head;
+    return r;
+}
+
+
 solver * mk_tactic2solver(ast_manager & m, 
                           tactic * t, 
                           params_ref const & p,
@@ -256,6 +443,14 @@ solver * mk_tactic2solver(ast_manager & m,
     return alloc(tactic2solver, m, t, p, produce_proofs, produce_models, produce_unsat_cores, logic);
 }
 
+solver * mk_incremental_tactic2solver(ast_manager & m, 
+                                      tactic * t, 
+                                      solver * s, 
+                                      params_ref const & p, 
+                                      bool produce_proofs) {
+    return alloc(incremental_tactic2solver, m, t, s, p, produce_proofs);
+}
+
 class tactic2solver_factory : public solver_factory {
     ref<tactic> m_tactic;
 public:
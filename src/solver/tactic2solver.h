@@ -37,6 +37,18 @@ solver * mk_tactic2solver(ast_manager & m,
                           bool produce_unsat_cores = false, 
                           symbol const & logic = symbol::null);
 
+/**
+   \brief Return a solver that preprocesses new assertions using \c t 
+   and asserts the result into the incremental solver \c s.
+   Unlike mk_tactic2solver, the tactic is not re-applied to all
+   assertions on every check.
+*/
+solver * mk_incremental_tactic2solver(ast_manager & m, 
+                                      tactic * t, 
+                                      solver * s, 
+                                      params_ref const & p = params_ref(), 
+                                      bool produce_proofs = false);
+
 
 solver_factory * mk_tactic2solver_factory(tactic * t);
 solver_factory * mk_tactic_factory2solver_factory(tactic_factory * f);
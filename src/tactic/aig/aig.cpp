@@ -19,7 +19,9 @@ Notes:
 #include "tactic/aig/aig.h"
 #include "tactic/goal.h"
 #include "ast/ast_smt2_pp.h"
+#include "sat/sat_solver.h"
 #include "util/cooperate.h"
+#include "util/map.h"
 
 #define USE_TWO_LEVEL_RULES
 #define FIRST_NODE_ID (UINT_MAX/2)
@@ -75,6 +77,29 @@ static void unmark(unsigned sz, aig * const * ns) {
     }
 }
 
+/**
+   \brief Truth tables of functions with at most 4 inputs are stored in the 16 lower bits of
+   an unsigned. Bit k is the value of the function on the assignment encoded by k, where
+   the i-th input is the i-th bit of k.
+*/
+#define TT_MASK 0xFFFFu
+
+static const unsigned g_tt_vars[4] = { 0xAAAAu, 0xCCCCu, 0xF0F0u, 0xFF00u };
+
+static unsigned tt_cofactor0(unsigned tt, unsigned v) {
+    unsigned t = tt & ~g_tt_vars[v] & TT_MASK;
+    return t | (t << (1u << v));
+}
+
+static unsigned tt_cofactor1(unsigned tt, unsigned v) {
+    unsigned t = tt & g_tt_vars[v];
+    return t | (t >> (1u << v));
+}
+
+static bool tt_depends_on(unsigned tt, unsigned v) {
+    return tt_cofactor0(tt, v) != tt_cofactor1(tt, v);
+}
+
 struct aig_hash {
     unsigned operator()(aig * n) const {
         SASSERT(!is_var(n));
@@ -117,6 +142,16 @@ struct aig_manager::imp {
     bool                     m_default_gate_encoding;
     unsigned long long       m_max_memory;
 
+    struct stats {
+        unsigned m_num_rewrites;
+        unsigned m_num_sat_calls;
+        unsigned m_num_merges;
+        unsigned m_num_cex;
+        stats() { reset(); }
+        void reset() { memset(this, 0, sizeof(*this)); }
+    };
+    stats                    m_stats;
+
     void dec_ref_core(aig * n) {
         SASSERT(n->m_ref_count > 0);
         n->m_ref_count--;
@@ -1298,6 +1333,775 @@ struct aig_manager::imp {
         }
     };
 
+    /**
+       \brief Store in nodes the AIGs reachable from r. Children are stored before their parents.
+    */
+    void collect_cone(aig * r, ptr_vector<aig> & nodes) const {
+        ptr_vector<aig> todo;
+        todo.push_back(r);
+        while (!todo.empty()) {
+            aig * t = todo.back();
+            if (t->m_mark) {
+                todo.pop_back();
+                continue;
+            }
+            if (!is_var(t)) {
+                bool visited = true;
+                for (unsigned i = 0; i < 2; i++) {
+                    aig * c = t->m_children[i].ptr();
+                    if (!c->m_mark) {
+                        todo.push_back(c);
+                        visited = false;
+                    }
+                }
+                if (!visited)
+                    continue;
+            }
+            t->m_mark = true;
+            nodes.push_back(t);
+            todo.pop_back();
+        }
+        unmark(nodes.size(), nodes.c_ptr());
+    }
+
+    /**
+       \brief Cut based rewriting.
+
+       The cuts with at most 4 leaves of every AND node are enumerated together with
+       their truth tables. A node is replaced by an irredundant sum of products of the
+       function of one of its cuts (or of its negation) when the sum of products uses
+       fewer AND nodes than the maximum fanout free cone of the node with respect to
+       the cut, that is, the nodes that become unused once the node is replaced.
+    */
+    struct cut_rewriter {
+        enum { MAX_CUT_SIZE = 4, MAX_CUTS = 8 };
+        struct cut {
+            unsigned m_size;
+            unsigned m_leaves[MAX_CUT_SIZE]; // sorted indices of the leaves in m_nodes
+            unsigned m_tt;                   // truth table over the leaves
+            cut():m_size(0), m_tt(0) {
+                for (unsigned i = 0; i < MAX_CUT_SIZE; i++)
+                    m_leaves[i] = UINT_MAX;
+            }
+        };
+        struct cube {
+            unsigned m_pos; // variables occurring positively
+            unsigned m_neg; // variables occurring negatively
+            cube(unsigned p, unsigned n):m_pos(p), m_neg(n) {}
+        };
+        struct cut_lt {
+            bool operator()(cut const & c1, cut const & c2) const { return c1.m_size < c2.m_size; }
+        };
+        imp &                 m;
+        ptr_vector<aig>       m_nodes;
+        u_map<unsigned>       m_id2idx;
+        unsigned_vector       m_refs;
+        vector<svector<cut> > m_cuts;
+        svector<aig_lit>      m_images;
+        svector<aig_lit>      m_pinned;
+        unsigned_vector       m_todo;
+        unsigned_vector       m_derefed;
+        svector<cube>         m_cover;
+        svector<cube>         m_best_cover;
+        svector<unsigned char> m_dcost;
+
+        cut_rewriter(imp & _m):m(_m), m_dcost(TT_MASK + 1, static_cast<unsigned char>(UCHAR_MAX)) {}
+
+        ~cut_rewriter() {
+            release();
+        }
+
+        void release() {
+            for (unsigned i = 0; i < m_pinned.size(); i++)
+                m.dec_ref(m_pinned[i]);
+            m_pinned.reset();
+        }
+
+        aig_lit pin(aig_lit l) {
+            m.inc_ref(l);
+            m_pinned.push_back(l);
+            return l;
+        }
+
+        unsigned idx(aig_lit const & l) const {
+            unsigned r = UINT_MAX;
+            VERIFY(m_id2idx.find(id(l), r));
+            return r;
+        }
+
+        aig_lit image(aig_lit const & l) const {
+            aig_lit r = m_images[idx(l)];
+            if (l.is_inverted())
+                r.invert();
+            return r;
+        }
+
+        bool is_leaf(unsigned i, cut const & c) const {
+            for (unsigned j = 0; j < c.m_size; j++)
+                if (c.m_leaves[j] == i)
+                    return true;
+            return false;
+        }
+
+        static bool merge(cut const & c1, cut const & c2, cut & r) {
+            unsigned i = 0, j = 0;
+            r.m_size = 0;
+            while (i < c1.m_size || j < c2.m_size) {
+                if (r.m_size == MAX_CUT_SIZE)
+                    return false;
+                if (j == c2.m_size || (i < c1.m_size && c1.m_leaves[i] < c2.m_leaves[j]))
+                    r.m_leaves[r.m_size++] = c1.m_leaves[i++];
+                else if (i == c1.m_size || c2.m_leaves[j] < c1.m_leaves[i])
+                    r.m_leaves[r.m_size++] = c2.m_leaves[j++];
+                else {
+                    r.m_leaves[r.m_size++] = c1.m_leaves[i++];
+                    j++;
+                }
+            }
+            return true;
+        }
+
+        static bool same_leaves(cut const & c1, cut const & c2) {
+            if (c1.m_size != c2.m_size)
+                return false;
+            for (unsigned i = 0; i < c1.m_size; i++)
+                if (c1.m_leaves[i] != c2.m_leaves[i])
+                    return false;
+            return true;
+        }
+
+        /**
+           \brief Return the truth table of c over the leaves of s, where the leaves of c are contained in s.
+        */
+        static unsigned expand(cut const & c, cut const & s) {
+            unsigned pos[MAX_CUT_SIZE];
+            for (unsigned i = 0, j = 0; i < c.m_size; i++) {
+                while (j < s.m_size && s.m_leaves[j] != c.m_leaves[i])
+                    j++;
+                SASSERT(j < s.m_size);
+                pos[i] = j;
+            }
+            unsigned r = 0;
+            for (unsigned k = 0; k < 16; k++) {
+                unsigned l = 0;
+                for (unsigned i = 0; i < c.m_size; i++)
+                    if (k & (1u << pos[i]))
+                        l |= (1u << i);
+                if (c.m_tt & (1u << l))
+                    r |= (1u << k);
+            }
+            return r;
+        }
+
+        void mk_trivial_cut(unsigned i) {
+            cut c;
+            c.m_size = 1;
+            c.m_leaves[0] = i;
+            c.m_tt = g_tt_vars[0];
+            m_cuts[i].push_back(c);
+        }
+
+        void mk_cuts(unsigned i) {
+            aig * n = m_nodes[i];
+            mk_trivial_cut(i);
+            if (is_var(n))
+                return;
+            svector<cut> & cs = m_cuts[i];
+            aig_lit l = left(n), r = right(n);
+            svector<cut> const & cs1 = m_cuts[idx(l)];
+            svector<cut> const & cs2 = m_cuts[idx(r)];
+            for (unsigned j = 0; j < cs1.size(); j++) {
+                for (unsigned k = 0; k < cs2.size(); k++) {
+                    cut c;
+                    if (!merge(cs1[j], cs2[k], c))
+                        continue;
+                    bool found = false;
+                    for (unsigned h = 1; !found && h < cs.size(); h++)
+                        found = same_leaves(cs[h], c);
+                    if (found)
+                        continue;
+                    unsigned tt1 = expand(cs1[j], c);
+                    unsigned tt2 = expand(cs2[k], c);
+                    if (l.is_inverted()) tt1 = ~tt1 & TT_MASK;
+                    if (r.is_inverted()) tt2 = ~tt2 & TT_MASK;
+                    c.m_tt = tt1 & tt2;
+                    cs.push_back(c);
+                }
+            }
+            std::stable_sort(cs.begin() + 1, cs.end(), cut_lt());
+            if (cs.size() > MAX_CUTS + 1)
+                cs.shrink(MAX_CUTS + 1);
+        }
+
+        /**
+           \brief Return the number of AND nodes that are only used to compute the node i
+           from the leaves of c.
+        */
+        unsigned mffc_size(unsigned i, cut const & c) {
+            unsigned count = 0;
+            m_todo.reset();
+            m_derefed.reset();
+            m_todo.push_back(i);
+            while (!m_todo.empty()) {
+                unsigned j = m_todo.back();
+                m_todo.pop_back();
+                aig * n = m_nodes[j];
+                if (is_var(n) || is_leaf(j, c))
+                    continue;
+                count++;
+                m_derefed.push_back(j);
+                for (unsigned k = 0; k < 2; k++) {
+                    unsigned ch = idx(n->m_children[k]);
+                    SASSERT(m_refs[ch] > 0);
+                    if (--m_refs[ch] == 0)
+                        m_todo.push_back(ch);
+                }
+            }
+            for (unsigned j = 0; j < m_derefed.size(); j++) {
+                aig * n = m_nodes[m_derefed[j]];
+                m_refs[idx(left(n))]++;
+                m_refs[idx(right(n))]++;
+            }
+            return count;
+        }
+
+        /**
+           \brief Minato-Morreale algorithm: store in cover an irredundant sum of products of a
+           function f such that on => f => upper, where on and upper depend only on the first
+           num_vars variables. Return the truth table of the cover.
+        */
+        static unsigned isop(unsigned on, unsigned upper, unsigned num_vars, svector<cube> & cover) {
+            if (on == 0)
+                return 0;
+            if (upper == TT_MASK) {
+                cover.push_back(cube(0, 0));
+                return TT_MASK;
+            }
+            SASSERT(num_vars > 0);
+            unsigned v = num_vars - 1;
+            while (!tt_depends_on(on, v) && !tt_depends_on(upper, v)) {
+                SASSERT(v > 0);
+                v--;
+            }
+            unsigned on0 = tt_cofactor0(on, v), on1 = tt_cofactor1(on, v);
+            unsigned up0 = tt_cofactor0(upper, v), up1 = tt_cofactor1(upper, v);
+            unsigned sz0 = cover.size();
+            unsigned r0  = isop(on0 & ~up1 & TT_MASK, up0, v, cover);
+            for (unsigned i = sz0; i < cover.size(); i++)
+                cover[i].m_neg |= (1u << v);
+            unsigned sz1 = cover.size();
+            unsigned r1  = isop(on1 & ~up0 & TT_MASK, up1, v, cover);
+            for (unsigned i = sz1; i < cover.size(); i++)
+                cover[i].m_pos |= (1u << v);
+            unsigned rs  = isop(((on0 & ~r0) | (on1 & ~r1)) & TT_MASK, up0 & up1, v, cover);
+            return (rs | (r0 & ~g_tt_vars[v]) | (r1 & g_tt_vars[v])) & TT_MASK;
+        }
+
+        static unsigned num_lits(cube const & c) {
+            unsigned r = 0;
+            for (unsigned v = 0; v < MAX_CUT_SIZE; v++)
+                if ((c.m_pos | c.m_neg) & (1u << v))
+                    r++;
+            return r;
+        }
+
+        /**
+           \brief Return the number of AND nodes needed to build the cover.
+        */
+        static unsigned cost(svector<cube> const & cover) {
+            if (cover.empty())
+                return 0;
+            unsigned r = cover.size() - 1;
+            for (unsigned i = 0; i < cover.size(); i++) {
+                unsigned n = num_lits(cover[i]);
+                if (n > 0)
+                    r += n - 1;
+            }
+            return r;
+        }
+
+        aig_lit mk_cover(cut const & c, svector<cube> const & cover, bool negate) {
+            aig_lit r = m.m_false;
+            for (unsigned i = 0; i < cover.size(); i++) {
+                aig_lit t = m.m_true;
+                for (unsigned v = 0; v < c.m_size; v++) {
+                    aig_lit l = m_images[c.m_leaves[v]];
+                    if (cover[i].m_pos & (1u << v))
+                        t = pin(m.mk_and(t, l));
+                    if (cover[i].m_neg & (1u << v)) {
+                        l.invert();
+                        t = pin(m.mk_and(t, l));
+                    }
+                }
+                r = pin(m.mk_or(r, t));
+            }
+            if (negate)
+                r.invert();
+            return r;
+        }
+
+        /**
+           \brief Return the number of AND nodes used to build f by decomposing it recursively
+           into AND, OR, XOR and if-then-else nodes of its cofactors.
+        */
+        unsigned dcost(unsigned f) {
+            unsigned char & c = m_dcost[f];
+            if (c != UCHAR_MAX)
+                return c;
+            unsigned best = UINT_MAX;
+            if (is_lit(f))
+                best = 0;
+            for (unsigned v = 0; best > 0 && v < MAX_CUT_SIZE; v++) {
+                if (tt_depends_on(f, v))
+                    best = std::min(best, dcost(tt_cofactor0(f, v), tt_cofactor1(f, v)));
+            }
+            c = static_cast<unsigned char>(std::min(best, UCHAR_MAX - 1u));
+            return c;
+        }
+
+        unsigned dcost(unsigned f0, unsigned f1) {
+            if (f0 == 0 || f0 == TT_MASK)
+                return dcost(f1) + 1;
+            if (f1 == 0 || f1 == TT_MASK)
+                return dcost(f0) + 1;
+            if (f0 == (~f1 & TT_MASK))
+                return dcost(f0) + 3;
+            return dcost(f0) + dcost(f1) + 3;
+        }
+
+        static bool is_lit(unsigned f) {
+            if (f == 0 || f == TT_MASK)
+                return true;
+            for (unsigned v = 0; v < MAX_CUT_SIZE; v++)
+                if (f == g_tt_vars[v] || f == (~g_tt_vars[v] & TT_MASK))
+                    return true;
+            return false;
+        }
+
+        aig_lit mk_decomposition(cut const & c, unsigned f) {
+            if (f == 0)
+                return m.m_false;
+            if (f == TT_MASK)
+                return m.m_true;
+            for (unsigned v = 0; v < c.m_size; v++) {
+                aig_lit l = m_images[c.m_leaves[v]];
+                if (f == g_tt_vars[v])
+                    return l;
+                l.invert();
+                if (f == (~g_tt_vars[v] & TT_MASK))
+                    return l;
+            }
+            unsigned best = UINT_MAX, best_v = 0;
+            for (unsigned v = 0; v < c.m_size; v++) {
+                if (!tt_depends_on(f, v))
+                    continue;
+                unsigned k = dcost(tt_cofactor0(f, v), tt_cofactor1(f, v));
+                if (k < best) {
+                    best   = k;
+                    best_v = v;
+                }
+            }
+            unsigned f0 = tt_cofactor0(f, best_v), f1 = tt_cofactor1(f, best_v);
+            aig_lit x = m_images[c.m_leaves[best_v]];
+            aig_lit nx = x;
+            nx.invert();
+            if (f0 == 0)
+                return pin(m.mk_and(x, mk_decomposition(c, f1)));
+            if (f0 == TT_MASK)
+                return pin(m.mk_or(nx, mk_decomposition(c, f1)));
+            if (f1 == 0)
+                return pin(m.mk_and(nx, mk_decomposition(c, f0)));
+            if (f1 == TT_MASK)
+                return pin(m.mk_or(x, mk_decomposition(c, f0)));
+            if (f0 == (~f1 & TT_MASK))
+                return pin(m.mk_xor(x, mk_decomposition(c, f0)));
+            aig_lit g1 = mk_decomposition(c, f1);
+            aig_lit g0 = mk_decomposition(c, f0);
+            return pin(m.mk_ite(x, g1, g0));
+        }
+
+        void rewrite(unsigned i) {
+            enum kind { SOP, NEG_SOP, DECOMPOSITION };
+            aig * n = m_nodes[i];
+            unsigned best_gain = 0;
+            unsigned best_cut  = 0;
+            kind best_kind     = SOP;
+            svector<cut> const & cs = m_cuts[i];
+            for (unsigned j = 1; j < cs.size(); j++) {
+                cut const & c = cs[j];
+                unsigned mffc  = mffc_size(i, c);
+                if (mffc <= best_gain)
+                    continue;
+                for (unsigned k = SOP; k <= NEG_SOP; k++) {
+                    unsigned tt = k == SOP ? c.m_tt : ~c.m_tt & TT_MASK;
+                    m_cover.reset();
+                    isop(tt, tt, c.m_size, m_cover);
+                    unsigned cost1 = cost(m_cover);
+                    if (cost1 + best_gain < mffc) {
+                        best_gain = mffc - cost1;
+                        best_cut  = j;
+                        best_kind = static_cast<kind>(k);
+                        m_best_cover.reset();
+                        m_best_cover.append(m_cover);
+                    }
+                }
+                unsigned cost2 = dcost(c.m_tt);
+                if (cost2 + best_gain < mffc) {
+                    best_gain = mffc - cost2;
+                    best_cut  = j;
+                    best_kind = DECOMPOSITION;
+                }
+            }
+            if (best_gain > 0) {
+                m.m_stats.m_num_rewrites++;
+                if (best_kind == DECOMPOSITION)
+                    m_images[i] = mk_decomposition(cs[best_cut], cs[best_cut].m_tt);
+                else
+                    m_images[i] = mk_cover(cs[best_cut], m_best_cover, best_kind == NEG_SOP);
+            }
+            else {
+                m_images[i] = pin(m.mk_and(image(left(n)), image(right(n))));
+            }
+        }
+
+        aig_lit operator()(aig_lit p) {
+            if (is_var(p)) {
+                return p;
+            }
+            collect_cone(p.ptr());
+            unsigned sz = m_nodes.size();
+            m_refs.resize(sz, 0);
+            m_cuts.resize(sz);
+            m_images.resize(sz, aig_lit::null);
+            m_refs[sz - 1]++;
+            for (unsigned i = 0; i < sz; i++) {
+                aig * n = m_nodes[i];
+                if (is_var(n))
+                    continue;
+                m_refs[idx(left(n))]++;
+                m_refs[idx(right(n))]++;
+            }
+            for (unsigned i = 0; i < sz; i++) {
+                m.checkpoint();
+                aig * n = m_nodes[i];
+                mk_cuts(i);
+                if (is_var(n))
+                    m_images[i] = aig_lit(n);
+                else
+                    rewrite(i);
+            }
+            aig_lit r = m_images[sz - 1];
+            if (p.is_inverted())
+                r.invert();
+            m.inc_ref(r);
+            release();
+            m.dec_ref_result(r);
+            return r;
+        }
+
+        void collect_cone(aig * p) {
+            m.collect_cone(p, m_nodes);
+            for (unsigned i = 0; i < m_nodes.size(); i++)
+                m_id2idx.insert(m_nodes[i]->m_id, i);
+        }
+    };
+
+    /**
+       \brief SAT sweeping (fraiging).
+
+       The nodes are simulated with random input patterns, and nodes with the same
+       simulation signature (modulo negation) are candidates to be equivalent.
+       Candidates are checked with a SAT solver in topological order. Equivalent
+       nodes are merged, and the counterexamples of the failed checks are added to
+       the simulation patterns to refine the candidates.
+    */
+    struct fraig_proc {
+        imp &                   m;
+        ptr_vector<aig>         m_nodes;
+        u_map<unsigned>         m_id2idx;
+        unsigned_vector         m_left;
+        unsigned_vector         m_right;
+        vector<svector<uint64> > m_sims;       // m_sims[w][i] is the w-th simulation word of node i
+        unsigned                m_cex_bit;    // next bit of the last word used for a counterexample
+        unsigned                m_num_rand_words;
+        u_map<unsigned>         m_sig2node;   // hash of signature -> representative
+        unsigned_vector         m_repr;
+        svector<bool>           m_phase;
+        sat::solver             m_solver;
+        svector<sat::bool_var>  m_vars;
+        svector<aig_lit>        m_images;
+        svector<aig_lit>        m_pinned;
+        random_gen              m_rand;
+        bool                    m_exhausted;
+
+        static params_ref mk_params(unsigned max_conflicts) {
+            params_ref p;
+            p.set_uint("max_conflicts", max_conflicts);
+            return p;
+        }
+
+        fraig_proc(imp & _m, unsigned num_words, unsigned max_conflicts):
+            m(_m),
+            m_cex_bit(64),
+            m_num_rand_words(std::max(num_words, 1u)),
+            m_solver(mk_params(max_conflicts), _m.m().limit(), 0),
+            m_exhausted(false) {
+        }
+
+        ~fraig_proc() {
+            release();
+        }
+
+        void release() {
+            for (unsigned i = 0; i < m_pinned.size(); i++)
+                m.dec_ref(m_pinned[i]);
+            m_pinned.reset();
+        }
+
+        unsigned idx(aig_lit const & l) const {
+            unsigned r = UINT_MAX;
+            VERIFY(m_id2idx.find(id(l), r));
+            return r;
+        }
+
+        bool is_true_node(unsigned i) const { return m_nodes[i]->m_id == 0; }
+
+        uint64 rand_word() {
+            uint64 r = 0;
+            for (unsigned i = 0; i < 5; i++)
+                r = (r << 15) | static_cast<uint64>(m_rand());
+            return r;
+        }
+
+        void simulate(unsigned w) {
+            svector<uint64> & s = m_sims[w];
+            for (unsigned i = 0; i < m_nodes.size(); i++) {
+                aig * n = m_nodes[i];
+                if (is_var(n))
+                    continue;
+                uint64 a = s[m_left[i]];
+                uint64 b = s[m_right[i]];
+                if (left(n).is_inverted()) a = ~a;
+                if (right(n).is_inverted()) b = ~b;
+                s[i] = a & b;
+            }
+        }
+
+        // the signature of a node is normalized so that the first pattern evaluates to false.
+        bool sig_phase(unsigned i) const { return (m_sims[0][i] & 1) != 0; }
+
+        unsigned sig_hash(unsigned i) const {
+            uint64 mask = sig_phase(i) ? ~0ull : 0ull;
+            unsigned h = 17;
+            for (unsigned w = 0; w < m_sims.size(); w++) {
+                uint64 x = m_sims[w][i] ^ mask;
+                h = hash_u_u(h, hash_u_u(static_cast<unsigned>(x), static_cast<unsigned>(x >> 32)));
+            }
+            return h;
+        }
+
+        bool same_sig(unsigned i, unsigned j) const {
+            uint64 mask = (sig_phase(i) != sig_phase(j)) ? ~0ull : 0ull;
+            for (unsigned w = 0; w < m_sims.size(); w++)
+                if (m_sims[w][i] != (m_sims[w][j] ^ mask))
+                    return false;
+            return true;
+        }
+
+        void insert_repr(unsigned i) {
+            unsigned h = sig_hash(i);
+            if (!m_sig2node.contains(h))
+                m_sig2node.insert(h, i);
+        }
+
+        void rebuild_table(unsigned num_processed) {
+            m_sig2node.reset();
+            for (unsigned i = 0; i < num_processed; i++)
+                if (m_repr[i] == UINT_MAX)
+                    insert_repr(i);
+        }
+
+        sat::literal lit(unsigned i, bool sign) const { return sat::literal(m_vars[i], sign); }
+
+        void init() {
+            unsigned sz = m_nodes.size();
+            m_left.resize(sz, UINT_MAX);
+            m_right.resize(sz, UINT_MAX);
+            m_repr.resize(sz, UINT_MAX);
+            m_phase.resize(sz, false);
+            m_images.resize(sz, aig_lit::null);
+            for (unsigned i = 0; i < sz; i++) {
+                aig * n = m_nodes[i];
+                m_vars.push_back(m_solver.mk_var(true, true));
+                if (is_var(n)) {
+                    if (is_true_node(i)) {
+                        sat::literal t = lit(i, false);
+                        m_solver.mk_clause(1, &t);
+                    }
+                    continue;
+                }
+                m_left[i]  = idx(left(n));
+                m_right[i] = idx(right(n));
+                sat::literal x = lit(i, false);
+                sat::literal a = lit(m_left[i], left(n).is_inverted());
+                sat::literal b = lit(m_right[i], right(n).is_inverted());
+                m_solver.mk_clause(~x, a);
+                m_solver.mk_clause(~x, b);
+                m_solver.mk_clause(x, ~a, ~b);
+            }
+            for (unsigned w = 0; w < m_num_rand_words; w++) {
+                m_sims.push_back(svector<uint64>(sz, 0ull));
+                svector<uint64> & s = m_sims.back();
+                for (unsigned i = 0; i < sz; i++) {
+                    if (is_var(m_nodes[i]))
+                        s[i] = is_true_node(i) ? ~0ull : rand_word();
+                }
+                simulate(w);
+            }
+        }
+
+        /**
+           \brief Add the current model of the SAT solver to the simulation patterns.
+        */
+        void add_cex() {
+            m.m_stats.m_num_cex++;
+            unsigned sz = m_nodes.size();
+            if (m_cex_bit == 64) {
+                m_sims.push_back(svector<uint64>(sz, 0ull));
+                m_cex_bit = 0;
+            }
+            svector<uint64> & s = m_sims.back();
+            sat::model const & mdl = m_solver.get_model();
+            for (unsigned i = 0; i < sz; i++) {
+                if (!is_var(m_nodes[i]))
+                    continue;
+                if (is_true_node(i) || mdl[m_vars[i]] == l_true)
+                    s[i] |= (1ull << m_cex_bit);
+            }
+            m_cex_bit++;
+            simulate(m_sims.size() - 1);
+        }
+
+        /**
+           \brief Return l_true if a and b are equivalent, l_false if they are not
+           (the counterexample is added to the simulation patterns), and l_undef if
+           the conflict budget was exhausted.
+        */
+        lbool check_equiv(sat::literal a, sat::literal b) {
+            for (unsigned k = 0; k < 2; k++) {
+                sat::literal asms[2] = { a, ~b };
+                m.m_stats.m_num_sat_calls++;
+                lbool r = m_solver.check(2, asms);
+                if (r == l_undef)
+                    return l_undef;
+                if (r == l_true) {
+                    add_cex();
+                    return l_false;
+                }
+                std::swap(a, b);
+            }
+            m_solver.pop_to_base_level();
+            m_solver.mk_clause(~a, b);
+            m_solver.mk_clause(a, ~b);
+            return l_true;
+        }
+
+        void sweep(unsigned i) {
+            if (m_exhausted || is_var(m_nodes[i])) {
+                insert_repr(i);
+                return;
+            }
+            unsigned j;
+            while (m_sig2node.find(sig_hash(i), j) && same_sig(i, j)) {
+                m.checkpoint();
+                bool phase = sig_phase(i) != sig_phase(j);
+                switch (check_equiv(lit(i, false), lit(j, phase))) {
+                case l_true:
+                    m.m_stats.m_num_merges++;
+                    m_repr[i]  = j;
+                    m_phase[i] = phase;
+                    return;
+                case l_false:
+                    rebuild_table(i);
+                    break;
+                case l_undef:
+                    m_exhausted = true;
+                    insert_repr(i);
+                    return;
+                }
+            }
+            insert_repr(i);
+        }
+
+        aig_lit operator()(aig_lit p) {
+            if (is_var(p)) {
+                return p;
+            }
+            m.collect_cone(p.ptr(), m_nodes);
+            for (unsigned i = 0; i < m_nodes.size(); i++)
+                m_id2idx.insert(m_nodes[i]->m_id, i);
+            init();
+            for (unsigned i = 0; i < m_nodes.size(); i++) {
+                m.checkpoint();
+                sweep(i);
+            }
+            for (unsigned i = 0; i < m_nodes.size(); i++) {
+                aig * n = m_nodes[i];
+                if (is_var(n)) {
+                    m_images[i] = aig_lit(n);
+                }
+                else if (m_repr[i] != UINT_MAX) {
+                    m_images[i] = m_images[m_repr[i]];
+                    if (m_phase[i])
+                        m_images[i].invert();
+                }
+                else {
+                    aig_lit a = m_images[m_left[i]];
+                    aig_lit b = m_images[m_right[i]];
+                    if (left(n).is_inverted()) a.invert();
+                    if (right(n).is_inverted()) b.invert();
+                    m_images[i] = m.mk_and(a, b);
+                    m.inc_ref(m_images[i]);
+                    m_pinned.push_back(m_images[i]);
+                }
+            }
+            aig_lit r = m_images.back();
+            if (p.is_inverted())
+                r.invert();
+            m.inc_ref(r);
+            release();
+            m.dec_ref_result(r);
+            return r;
+        }
+    };
+
+    aig_lit rewrite(aig_lit l) {
+        cut_rewriter p(*this);
+        return p(l);
+    }
+
+    aig_lit fraig(aig_lit l, unsigned num_words, unsigned max_conflicts) {
+        fraig_proc p(*this, num_words, max_conflicts);
+        return p(l);
+    }
+
+    unsigned get_num_nodes(aig_lit l) const {
+        ptr_vector<aig> nodes;
+        collect_cone(l.ptr(), nodes);
+        unsigned r = 0;
+        for (unsigned i = 0; i < nodes.size(); i++)
+            if (!is_var(nodes[i]))
+                r++;
+        return r;
+    }
+
+    void collect_statistics(statistics & st) const {
+        st.update("aig rewrites", m_stats.m_num_rewrites);
+        st.update("aig fraig sat calls", m_stats.m_num_sat_calls);
+        st.update("aig fraig merges", m_stats.m_num_merges);
+        st.update("aig fraig cex", m_stats.m_num_cex);
+    }
+
 public:
     imp(ast_manager & m, unsigned long long max_memory, bool default_gate_encoding):
         m_var_id_gen(0),
@@ -1726,6 +2530,14 @@ void aig_manager::max_sharing(aig_ref & r) {
     r = aig_ref(*this, m_imp->max_sharing(aig_lit(r)));
 }
 
+void aig_manager::rewrite(aig_ref & r) {
+    r = aig_ref(*this, m_imp->rewrite(aig_lit(r)));
+}
+
+void aig_manager::fraig(aig_ref & r, unsigned num_words, unsigned max_conflicts) {
+    r = aig_ref(*this, m_imp->fraig(aig_lit(r), num_words, max_conflicts));
+}
+
 void aig_manager::to_formula(aig_ref const & r, goal & g) {
     SASSERT(!g.proofs_enabled());
     SASSERT(!g.unsat_core_enabled());
@@ -1748,5 +2560,10 @@ unsigned aig_manager::get_num_aigs() const {
     return m_imp->get_num_aigs();
 }
 
+unsigned aig_manager::get_num_nodes(aig_ref const & r) const {
+    return m_imp->get_num_nodes(aig_lit(r));
+}
 
-
+void aig_manager::collect_statistics(statistics & st) const {
+    m_imp->collect_statistics(st);
+}
@@ -21,6 +21,7 @@ Notes:
 
 #include "ast/ast.h"
 #include "tactic/tactic_exception.h"
+#include "util/statistics.h"
 
 class goal;
 class aig_lit;
@@ -68,11 +69,25 @@ public:
     aig_ref mk_iff(aig_ref const & r1, aig_ref const & r2);
     aig_ref mk_ite(aig_ref const & r1, aig_ref const & r2, aig_ref const & r3);
     void max_sharing(aig_ref & r);
+    /**
+       \brief Replace AND nodes by smaller implementations of the functions of their 4-input cuts.
+    */
+    void rewrite(aig_ref & r);
+    /**
+       \brief Merge equivalent nodes. Candidates are found by random simulation with num_words
+       words of 64 patterns, and checked with a SAT solver within a budget of max_conflicts conflicts.
+    */
+    void fraig(aig_ref & r, unsigned num_words = 4, unsigned max_conflicts = 100000);
     void to_formula(aig_ref const & r, expr_ref & result);
     void to_formula(aig_ref const & r, goal & result);
     void display(std::ostream & out, aig_ref const & r) const;
     void display_smt2(std::ostream & out, aig_ref const & r) const;
     unsigned get_num_aigs() const;
+    /**
+       \brief Return the number of AND nodes reachable from r.
+    */
+    unsigned get_num_nodes(aig_ref const & r) const;
+    void collect_statistics(statistics & st) const;
 };
 
 #endif
@@ -25,7 +25,12 @@ class aig_tactic : public tactic {
     unsigned long long m_max_memory;
     bool               m_aig_gate_encoding;
     bool               m_aig_per_assertion;
+    bool               m_aig_rewrite;
+    bool               m_aig_fraig;
+    unsigned           m_aig_fraig_sim_words;
+    unsigned           m_aig_fraig_max_conflicts;
     aig_manager *      m_aig_manager;
+    statistics         m_stats;
 
     struct mk_aig_manager {
         aig_tactic & m_owner;
@@ -36,6 +41,7 @@ class aig_tactic : public tactic {
         }
         
         ~mk_aig_manager() {
+            m_owner.m_aig_manager->collect_statistics(m_owner.m_stats);
             dealloc(m_owner.m_aig_manager);
             m_owner.m_aig_manager = 0;
         }
@@ -51,6 +57,10 @@ public:
         t->m_max_memory = m_max_memory;
         t->m_aig_gate_encoding = m_aig_gate_encoding;
         t->m_aig_per_assertion = m_aig_per_assertion;
+        t->m_aig_rewrite = m_aig_rewrite;
+        t->m_aig_fraig = m_aig_fraig;
+        t->m_aig_fraig_sim_words = m_aig_fraig_sim_words;
+        t->m_aig_fraig_max_conflicts = m_aig_fraig_max_conflicts;
         return t;
     }
 
@@ -58,11 +68,31 @@ public:
         m_max_memory        = megabytes_to_bytes(p.get_uint("max_memory", UINT_MAX));
         m_aig_gate_encoding = p.get_bool("aig_default_gate_encoding", true);
         m_aig_per_assertion = p.get_bool("aig_per_assertion", true); 
+        m_aig_rewrite       = p.get_bool("aig_rewrite", false);
+        m_aig_fraig         = p.get_bool("aig_fraig", false);
+        m_aig_fraig_sim_words = p.get_uint("aig_fraig_sim_words", 4);
+        m_aig_fraig_max_conflicts = p.get_uint("aig_fraig_max_conflicts", 100000);
     }
 
     virtual void collect_param_descrs(param_descrs & r) { 
         insert_max_memory(r);
         r.insert("aig_per_assertion", CPK_BOOL, "(default: true) process one assertion at a time.");
+        r.insert("aig_rewrite", CPK_BOOL, "(default: false) replace AND nodes by smaller implementations of the functions of their 4-input cuts.");
+        r.insert("aig_fraig", CPK_BOOL, "(default: false) merge equivalent AND nodes using random simulation and a SAT solver (SAT sweeping).");
+        r.insert("aig_fraig_sim_words", CPK_UINT, "(default: 4) number of 64-bit words of random simulation patterns used in SAT sweeping.");
+        r.insert("aig_fraig_max_conflicts", CPK_UINT, "(default: 100000) maximum number of conflicts used by the SAT solver in SAT sweeping.");
+    }
+
+    void simplify(aig_ref & r) {
+        m_aig_manager->max_sharing(r);
+        if (!m_aig_rewrite && !m_aig_fraig)
+            return;
+        m_stats.update("aig nodes before", m_aig_manager->get_num_nodes(r));
+        if (m_aig_rewrite)
+            m_aig_manager->rewrite(r);
+        if (m_aig_fraig)
+            m_aig_manager->fraig(r, m_aig_fraig_sim_words, m_aig_fraig_max_conflicts);
+        m_stats.update("aig nodes after", m_aig_manager->get_num_nodes(r));
     }
 
     void operator()(goal_ref const & g) {
@@ -73,7 +103,7 @@ public:
         if (m_aig_per_assertion) {
             for (unsigned i = 0; i < g->size(); i++) {
                 aig_ref r = m_aig_manager->mk_aig(g->form(i));
-                m_aig_manager->max_sharing(r);
+                simplify(r);
                 expr_ref new_f(g->m());
                 m_aig_manager->to_formula(r, new_f);
                 expr_dependency * ed = g->dep(i);
@@ -84,7 +114,7 @@ public:
             fail_if_unsat_core_generation("aig", g);
             aig_ref r = m_aig_manager->mk_aig(*(g.get()));
             g->reset(); // save memory
-            m_aig_manager->max_sharing(r);
+            simplify(r);
             m_aig_manager->to_formula(r, *(g.get()));
         }
         SASSERT(g->is_well_sorted());
@@ -102,6 +132,14 @@ public:
         result.push_back(g.get());
     }
 
+    virtual void collect_statistics(statistics & st) const {
+        st.copy(m_stats);
+    }
+
+    virtual void reset_statistics() {
+        m_stats.reset();
+    }
+
     virtual void cleanup() {}
 
 };
@@ -129,6 +129,8 @@ public:
         insert_max_memory(r);
         insert_max_steps(r);
         r.insert("blast_mul", CPK_BOOL, "(default: true) bit-blast multipliers (and dividers, remainders).");
+        r.insert("blast_mul_encoding", CPK_SYMBOL, "(default: array) encoding of bit-blasted multipliers: array (shift-add), wallace (carry-save adder tree), dadda (column reduction tree).");
+        r.insert("blast_mul_const", CPK_BOOL, "(default: false) bit-blast multiplication by a constant as a sum of shifted operands using its canonical signed digit representation.");
         r.insert("blast_add", CPK_BOOL, "(default: true) bit-blast adders.");
         r.insert("blast_quant", CPK_BOOL, "(default: false) bit-blast quantified variables.");
         r.insert("blast_full", CPK_BOOL, "(default: false) bit-blast any term with bit-vector sort, this option will make E-matching ineffective in any pattern containing bit-vector terms.");
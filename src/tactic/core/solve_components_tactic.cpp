@@ -0,0 +1,415 @@
+/*++
+Copyright (c) 2017 Microsoft Corporation
+
+Module Name:
+
+    solve_components_tactic.cpp
+
+Abstract:
+
+    Tactic that partitions a goal into components that share no
+    uninterpreted symbols and solves the components in parallel.
+
+Notes:
+
+    Formulas are related by a union-find over the uninterpreted
+    constants and functions they contain. Goals with quantifiers
+    are not split: quantified formulas can bound the size of
+    uninterpreted sorts, which ties otherwise unrelated components.
+
+--*/
+#include "tactic/tactical.h"
+#include "tactic/core/solve_components_tactic.h"
+#include "ast/ast_translation.h"
+#include "util/union_find.h"
+#include "util/scoped_ptr_vector.h"
+#include "util/z3_omp.h"
+
+class solve_components_tactic : public tactic {
+
+    struct stats {
+        unsigned m_num_splits;
+        unsigned m_num_components;
+        unsigned m_max_component;
+        unsigned m_num_groups;
+        stats() { reset(); }
+        void reset() { memset(this, 0, sizeof(*this)); }
+    };
+
+    enum group_status {
+        GROUP_UNDECIDED,
+        GROUP_SAT,
+        GROUP_UNSAT,
+        GROUP_FAILED
+    };
+
+    static const unsigned UNVISITED = UINT_MAX;
+    static const unsigned NO_SYMBOL = UINT_MAX - 1;
+
+    ast_manager &  m;
+    tactic_ref     m_tactic;
+    params_ref     m_params;
+    unsigned       m_max_groups;
+    stats          m_stats;
+    statistics     m_group_stats;
+
+    /**
+       \brief Store in comp[i] the component of the i-th formula of g.
+       Formulas without uninterpreted symbols form a component of their own.
+       Return false if g contains quantifiers.
+    */
+    bool get_components(goal const & g, unsigned_vector & comp, unsigned & num_comps) {
+        union_find_default_ctx       uf_ctx;
+        union_find<>                 uf(uf_ctx);
+        obj_map<func_decl, unsigned> decl2var;
+        unsigned_vector              rep;
+        unsigned_vector              roots;
+        ptr_vector<expr>             todo;
+
+        unsigned sz = g.size();
+        for (unsigned i = 0; i < sz; i++) {
+            todo.push_back(g.form(i));
+            while (!todo.empty()) {
+                expr * e = todo.back();
+                unsigned id = e->get_id();
+                if (id < rep.size() && rep[id] != UNVISITED) {
+                    todo.pop_back();
+                    continue;
+                }
+                if (!is_app(e))
+                    return false;
+                app * a = to_app(e);
+                bool visited = true;
+                for (unsigned j = 0; j < a->get_num_args(); j++) {
+                    unsigned arg_id = a->get_arg(j)->get_id();
+                    if (arg_id >= rep.size() || rep[arg_id] == UNVISITED) {
+                        todo.push_back(a->get_arg(j));
+                        visited = false;
+                    }
+                }
+                if (!visited)
+                    continue;
+                todo.pop_back();
+                unsigned r = NO_SYMBOL;
+                func_decl * d = a->get_decl();
+                if (d->get_family_id() == null_family_id)
+                    merge(uf, decl2var, d, r);
+                for (unsigned j = 0; j < d->get_num_parameters(); j++) {
+                    parameter const & p = d->get_parameter(j);
+                    if (p.is_ast() && is_func_decl(p.get_ast()) && to_func_decl(p.get_ast())->get_family_id() == null_family_id)
+                        merge(uf, decl2var, to_func_decl(p.get_ast()), r);
+                }
+                for (unsigned j = 0; j < a->get_num_args(); j++) {
+                    unsigned r2 = rep[a->get_arg(j)->get_id()];
+                    if (r2 == NO_SYMBOL)
+                        continue;
+                    if (r == NO_SYMBOL)
+                        r = r2;
+                    else
+                        uf.merge(r, r2);
+                }
+                rep.reserve(id + 1, UNVISITED);
+                rep[id] = r;
+            }
+            roots.push_back(rep[g.form(i)->get_id()]);
+        }
+
+        unsigned_vector root2comp;
+        root2comp.resize(uf.get_num_vars(), UINT_MAX);
+        unsigned no_symbol_comp = UINT_MAX;
+        num_comps = 0;
+        for (unsigned i = 0; i < sz; i++) {
+            unsigned & c = roots[i] == NO_SYMBOL ? no_symbol_comp : root2comp[uf.find(roots[i])];
+            if (c == UINT_MAX)
+                c = num_comps++;
+            comp.push_back(c);
+        }
+        return true;
+    }
+
+    void merge(union_find<> & uf, obj_map<func_decl, unsigned> & decl2var, func_decl * d, unsigned & r) {
+        unsigned v;
+        if (!decl2var.find(d, v)) {
+            v = uf.mk_var();
+            decl2var.insert(d, v);
+        }
+        if (r == NO_SYMBOL)
+            r = v;
+        else
+            uf.merge(r, v);
+    }
+
+    /**
+       \brief Distribute the components over at most m_max_groups groups,
+       assigning the largest components first to the smallest group.
+    */
+    unsigned mk_groups(unsigned num_comps, unsigned_vector const & comp, unsigned_vector & comp2group) {
+        unsigned_vector comp_size;
+        comp_size.resize(num_comps, 0);
+        for (unsigned i = 0; i < comp.size(); i++)
+            comp_size[comp[i]]++;
+        unsigned_vector order;
+        for (unsigned c = 0; c < num_comps; c++) {
+            order.push_back(c);
+            m_stats.m_max_component = std::max(m_stats.m_max_component, comp_size[c]);
+        }
+        std::stable_sort(order.begin(), order.end(), [&](unsigned c1, unsigned c2) { return comp_size[c1] > comp_size[c2]; });
+
+        unsigned num_groups = std::min(num_comps, std::max(m_max_groups, 1u));
+        unsigned_vector group_size;
+        group_size.resize(num_groups, 0);
+        comp2group.resize(num_comps, 0);
+        for (unsigned c : order) {
+            unsigned g = 0;
+            for (unsigned k = 1; k < num_groups; k++) {
+                if (group_size[k] < group_size[g])
+                    g = k;
+            }
+            comp2group[c] = g;
+            group_size[g] += comp_size[c];
+        }
+        return num_groups;
+    }
+
+    /**
+       \brief Combine the models of the groups. The groups share no
+       uninterpreted symbols, only the universes of uninterpreted sorts
+       have to be merged.
+    */
+    model * mk_model(ptr_vector<ast_manager> const & managers, model_converter_ref_buffer & mcs) {
+        model * md = alloc(model, m);
+        sref_buffer<model>               models;
+        obj_map<sort, ptr_vector<expr>*> universes;
+        scoped_ptr_vector<ptr_vector<expr> > universe_vectors;
+        ptr_vector<sort>                 usorts;
+        obj_hashtable<expr>              in_universe;
+        for (unsigned i = 0; i < managers.size(); i++) {
+            model_ref new_md = alloc(model, *managers[i]);
+            if (mcs[i])
+                (*mcs[i])(new_md, 0);
+            ast_translation translator(*managers[i], m, false);
+            model * tr_md = new_md->translate(translator);
+            models.push_back(tr_md);
+            for (unsigned j = 0; j < tr_md->get_num_constants(); j++) {
+                func_decl * d = tr_md->get_constant(j);
+                if (!md->has_interpretation(d))
+                    md->register_decl(d, tr_md->get_const_interp(d));
+            }
+            for (unsigned j = 0; j < tr_md->get_num_functions(); j++) {
+                func_decl * f = tr_md->get_function(j);
+                if (!md->has_interpretation(f))
+                    md->register_decl(f, tr_md->get_func_interp(f)->copy());
+            }
+            for (unsigned j = 0; j < tr_md->get_num_uninterpreted_sorts(); j++) {
+                sort * s = tr_md->get_uninterpreted_sort(j);
+                ptr_vector<expr> * u = 0;
+                if (!universes.find(s, u)) {
+                    u = alloc(ptr_vector<expr>);
+                    universe_vectors.push_back(u);
+                    universes.insert(s, u);
+                    usorts.push_back(s);
+                }
+                for (expr * v : tr_md->get_universe(s)) {
+                    if (!in_universe.contains(v)) {
+                        in_universe.insert(v);
+                        u->push_back(v);
+                    }
+                }
+            }
+        }
+        for (sort * s : usorts) {
+            ptr_vector<expr> * u = universes[s];
+            md->register_usort(s, u->size(), u->c_ptr());
+        }
+        return md;
+    }
+
+public:
+    solve_components_tactic(ast_manager & m, tactic * t, params_ref const & p):
+        m(m),
+        m_tactic(t) {
+        updt_params(p);
+    }
+
+    virtual tactic * translate(ast_manager & new_m) {
+        return alloc(solve_components_tactic, new_m, m_tactic->translate(new_m), m_params);
+    }
+
+    virtual ~solve_components_tactic() {}
+
+    virtual void updt_params(params_ref const & p) {
+        m_params = p;
+        m_max_groups = p.get_uint("max_groups", 8);
+        m_tactic->updt_params(p);
+    }
+
+    virtual void collect_param_descrs(param_descrs & r) {
+        r.insert("max_groups", CPK_UINT, "(default: 8) maximal number of goals the independent components of a goal are distributed over.");
+        m_tactic->collect_param_descrs(r);
+    }
+
+    virtual void operator()(goal_ref const & in,
+                            goal_ref_buffer & result,
+                            model_converter_ref & mc,
+                            proof_converter_ref & pc,
+                            expr_dependency_ref & core) {
+        mc = 0; pc = 0; core = 0;
+        unsigned_vector comp;
+        unsigned num_comps = 0;
+        if (in->proofs_enabled() || in->inconsistent() || !get_components(*in, comp, num_comps) || num_comps <= 1) {
+            (*m_tactic)(in, result, mc, pc, core);
+            return;
+        }
+
+        tactic_report report("solve-components", *in);
+        unsigned_vector comp2group;
+        unsigned num_groups = mk_groups(num_comps, comp, comp2group);
+        m_stats.m_num_splits++;
+        m_stats.m_num_components += num_comps;
+        m_stats.m_num_groups += num_groups;
+        report_tactic_progress(":components", num_comps);
+
+        goal_ref_vector group_goals;
+        for (unsigned k = 0; k < num_groups; k++)
+            group_goals.push_back(alloc(goal, *in, true));
+        for (unsigned i = 0; i < in->size(); i++)
+            group_goals[comp2group[comp[i]]]->assert_expr(in->form(i), in->dep(i));
+
+        scoped_ptr_vector<ast_manager> managers;
+        scoped_limits                  scl(m.limit());
+        goal_ref_vector                goals;
+        tactic_ref_vector              ts;
+        for (unsigned k = 0; k < num_groups; k++) {
+            ast_manager * new_m = alloc(ast_manager, m, !m.proof_mode());
+            managers.push_back(new_m);
+            ast_translation translator(m, *new_m);
+            goals.push_back(group_goals[k]->translate(translator));
+            ts.push_back(m_tactic->translate(*new_m));
+            scl.push_child(&new_m->limit());
+        }
+        group_goals.reset();
+
+        svector<group_status>      status;
+        goal_ref_vector            unsat_goals;
+        model_converter_ref_buffer mcs;
+        status.resize(num_groups, GROUP_UNDECIDED);
+        unsat_goals.resize(num_groups);
+        mcs.resize(num_groups);
+        bool        is_error = false;
+        unsigned    error_code = 0;
+        std::string ex_msg;
+
+        #pragma omp parallel for
+        for (int i = 0; i < static_cast<int>(num_groups); i++) {
+            ast_manager & new_m = *(managers[i]);
+            goal_ref_buffer     _result;
+            model_converter_ref _mc;
+            proof_converter_ref _pc;
+            expr_dependency_ref _core(new_m);
+            try {
+                (*ts[i])(goals[i], _result, _mc, _pc, _core);
+                if (is_decided_sat(_result)) {
+                    status[i] = GROUP_SAT;
+                    mcs.set(i, _mc.get());
+                }
+                else if (is_decided_unsat(_result)) {
+                    status[i] = GROUP_UNSAT;
+                    unsat_goals.set(i, _result[0]);
+                    // one unsatisfiable component decides the goal.
+                    for (unsigned j = 0; j < num_groups; j++) {
+                        if (static_cast<unsigned>(i) != j)
+                            managers[j]->limit().cancel();
+                    }
+                }
+            }
+            catch (z3_error & err) {
+                status[i] = GROUP_FAILED;
+                #pragma omp critical (solve_components_tactic)
+                {
+                    if (ex_msg.empty() && !is_error) {
+                        is_error   = true;
+                        error_code = err.error_code();
+                    }
+                }
+            }
+            catch (z3_exception & ex) {
+                status[i] = GROUP_FAILED;
+                #pragma omp critical (solve_components_tactic)
+                {
+                    if (ex_msg.empty() && !is_error)
+                        ex_msg = ex.msg();
+                }
+            }
+        }
+
+        for (unsigned k = 0; k < num_groups; k++)
+            ts[k]->collect_statistics(m_group_stats);
+
+        for (unsigned k = 0; k < num_groups; k++) {
+            if (status[k] != GROUP_UNSAT)
+                continue;
+            expr_dependency_ref dep(m);
+            if (in->unsat_core_enabled() && unsat_goals[k]->dep(0) != 0) {
+                ast_translation translator(*(managers[k]), m, false);
+                expr_dependency_translation td(translator);
+                dep = td(unsat_goals[k]->dep(0));
+            }
+            unsat_goals.reset();
+            in->reset();
+            in->inc_depth();
+            in->assert_expr(m.mk_false(), 0, dep);
+            result.push_back(in.get());
+            return;
+        }
+        unsat_goals.reset();
+
+        if (m.canceled())
+            throw tactic_exception(m.limit().get_cancel_msg());
+        if (is_error)
+            throw z3_error(error_code);
+        if (!ex_msg.empty())
+            throw tactic_exception(ex_msg.c_str());
+
+        for (unsigned k = 0; k < num_groups; k++) {
+            if (status[k] != GROUP_SAT) {
+                // some component was not decided, leave the goal to the caller.
+                result.push_back(in.get());
+                return;
+            }
+        }
+
+        if (in->models_enabled()) {
+            ptr_vector<ast_manager> ms;
+            for (unsigned k = 0; k < num_groups; k++)
+                ms.push_back(managers[k]);
+            mc = model2model_converter(mk_model(ms, mcs));
+        }
+        mcs.reset();
+        in->reset();
+        in->inc_depth();
+        result.push_back(in.get());
+    }
+
+    virtual void cleanup() {
+        m_tactic->cleanup();
+    }
+
+    virtual void collect_statistics(statistics & st) const {
+        st.update("components splits", m_stats.m_num_splits);
+        st.update("components", m_stats.m_num_components);
+        st.update("components max size", m_stats.m_max_component);
+        st.update("components groups", m_stats.m_num_groups);
+        st.copy(m_group_stats);
+        m_tactic->collect_statistics(st);
+    }
+
+    virtual void reset_statistics() {
+        m_stats.reset();
+        m_group_stats.reset();
+        m_tactic->reset_statistics();
+    }
+};
+
+tactic * mk_solve_components_tactic(ast_manager & m, tactic * t, params_ref const & p) {
+    return alloc(solve_components_tactic, m, t, p);
+}
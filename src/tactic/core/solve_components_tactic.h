@@ -0,0 +1,36 @@
+/*++
+Copyright (c) 2017 Microsoft Corporation
+
+Module Name:
+
+    solve_components_tactic.h
+
+Abstract:
+
+    Tactic that partitions a goal into components that share no
+    uninterpreted symbols and solves the components in parallel,
+    each one on its own manager.
+
+Notes:
+
+    The goal is satisfiable iff every component is. If some component
+    is unsatisfiable, so is the goal; if all of them are satisfiable,
+    the models of the components are combined into a model of the goal.
+    Otherwise the goal is returned unchanged.
+
+--*/
+#ifndef SOLVE_COMPONENTS_TACTIC_H_
+#define SOLVE_COMPONENTS_TACTIC_H_
+
+#include "util/params.h"
+class ast_manager;
+class tactic;
+
+/**
+   \brief Return a tactic that applies \c t to every component of the goal.
+   The components are distributed over at most \c max_groups goals
+   that are solved in parallel.
+*/
+tactic * mk_solve_components_tactic(ast_manager & m, tactic * t, params_ref const & p = params_ref());
+
+#endif
@@ -639,8 +639,14 @@ goal * goal::translate(ast_translation & translator) const {
     goal * res = alloc(goal, m_to, m_to.proofs_enabled() && proofs_enabled(), models_enabled(), unsat_core_enabled());
 
     unsigned sz = m().size(m_forms);
+    ptr_vector<expr> forms;
+    expr_ref_vector new_forms(m_to);
     for (unsigned i = 0; i < sz; i++) {
-        res->m().push_back(res->m_forms, translator(m().get(m_forms, i)));
+        forms.push_back(m().get(m_forms, i));
+    }
+    translator(forms.size(), forms.c_ptr(), new_forms);
+    for (unsigned i = 0; i < sz; i++) {
+        res->m().push_back(res->m_forms, new_forms.get(i));
         if (res->proofs_enabled())
             res->m().push_back(res->m_proofs, translator(m().get(m_proofs, i)));
         if (res->unsat_core_enabled())
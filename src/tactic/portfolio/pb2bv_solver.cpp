@@ -91,6 +91,7 @@ public:
     virtual void get_labels(svector<symbol> & r) { m_solver->get_labels(r); }
     virtual ast_manager& get_manager() const { return m;  }
     virtual lbool find_mutexes(expr_ref_vector const& vars, vector<expr_ref_vector>& mutexes) { return m_solver->find_mutexes(vars, mutexes); }    
+    virtual lbool cube(unsigned max_depth, vector<expr_ref_vector>& cubes) { flush_assertions(); return m_solver->cube(max_depth, cubes); }
     virtual lbool get_consequences_core(expr_ref_vector const& asms, expr_ref_vector const& vars, expr_ref_vector& consequences) {
         flush_assertions(); 
         return m_solver->get_consequences(asms, vars, consequences); }
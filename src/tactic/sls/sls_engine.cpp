@@ -26,6 +26,7 @@ Notes:
 #include "tactic/tactic.h"
 #include "util/cooperate.h"
 #include "util/luby.h"
+#include "ast/ast_translation.h"
 
 #include "tactic/sls/sls_params.hpp"
 #include "tactic/sls/sls_engine.h"
@@ -39,7 +40,9 @@ sls_engine::sls_engine(ast_manager & m, params_ref const & p) :
     m_two(m_mpz_manager.mk_z(2)),
     m_bv_util(m),
     m_tracker(m, m_bv_util, m_mpz_manager, m_powers),
-    m_evaluator(m, m_bv_util, m_tracker, m_mpz_manager, m_powers)
+    m_evaluator(m, m_bv_util, m_tracker, m_mpz_manager, m_powers),
+    m_shared(0),
+    m_id(0)
 {
     updt_params(p);
     m_tracker.updt_params(p);
@@ -71,6 +74,7 @@ void sls_engine::updt_params(params_ref const & _p) {
     m_early_prune = p.early_prune();
     m_random_offset = p.random_offset();
     m_rescore = p.rescore();
+    m_share_interval = p.share_interval();
 
     // Andreas: Would cause trouble because repick requires an assertion being picked before which is not the case in GSAT.
     if (m_walksat_repick && !m_walksat)
@@ -91,6 +95,10 @@ void sls_engine::collect_statistics(statistics& st) const {
     st.update("sls INV moves", m_stats.m_invs);
     st.update("sls moves", m_stats.m_moves);
     st.update("sls moves/sec", m_stats.m_moves / seconds);
+    if (m_shared) {
+        st.update("sls imported assignments", m_stats.m_imports);
+        st.update("sls exported assignments", m_stats.m_exports);
+    }
 }
 
 void sls_engine::checkpoint() {
@@ -203,6 +211,11 @@ bool sls_engine::what_if(
 }
 
 void sls_engine::mk_add(unsigned bv_sz, const mpz & old_value, mpz & add_value, mpz & result) {
+    if (m_tracker.machine_words() && is_sls_word(bv_sz)) {
+        uint64 r = m_mpz_manager.get_uint64(old_value) + m_mpz_manager.get_uint64(add_value);
+        m_mpz_manager.set(result, r & sls_word_mask(bv_sz));
+        return;
+    }
     mpz temp, mask, mask2;
     m_mpz_manager.add(old_value, add_value, temp);
     m_mpz_manager.set(mask, m_powers(bv_sz));
@@ -215,6 +228,10 @@ void sls_engine::mk_add(unsigned bv_sz, const mpz & old_value, mpz & add_value,
 }
 
 void sls_engine::mk_inc(unsigned bv_sz, const mpz & old_value, mpz & incremented) {
+    if (m_tracker.machine_words() && is_sls_word(bv_sz)) {
+        m_mpz_manager.set(incremented, (m_mpz_manager.get_uint64(old_value) + 1) & sls_word_mask(bv_sz));
+        return;
+    }
     unsigned shift;
     m_mpz_manager.add(old_value, m_one, incremented);
     if (m_mpz_manager.is_power_of_two(incremented, shift) && shift == bv_sz)
@@ -222,7 +239,10 @@ void sls_engine::mk_inc(unsigned bv_sz, const mpz & old_value, mpz & incremented
 }
 
 void sls_engine::mk_dec(unsigned bv_sz, const mpz & old_value, mpz & decremented) {
-    if (m_mpz_manager.is_zero(old_value)) {
+    if (m_tracker.machine_words() && is_sls_word(bv_sz)) {
+        m_mpz_manager.set(decremented, (m_mpz_manager.get_uint64(old_value) - 1) & sls_word_mask(bv_sz));
+    }
+    else if (m_mpz_manager.is_zero(old_value)) {
         m_mpz_manager.set(decremented, m_powers(bv_sz));
         m_mpz_manager.dec(decremented);
     }
@@ -237,7 +257,10 @@ void sls_engine::mk_inv(unsigned bv_sz, const mpz & old_value, mpz & inverted) {
 void sls_engine::mk_flip(sort * s, const mpz & old_value, unsigned bit, mpz & flipped) {
     m_mpz_manager.set(flipped, m_zero);
 
-    if (m_bv_util.is_bv_sort(s)) {
+    if (m_bv_util.is_bv_sort(s) && m_tracker.machine_words() && is_sls_word(m_bv_util.get_bv_size(s))) {
+        m_mpz_manager.set(flipped, m_mpz_manager.get_uint64(old_value) ^ (static_cast<uint64>(1) << bit));
+    }
+    else if (m_bv_util.is_bv_sort(s)) {
         mpz mask;
         m_mpz_manager.set(mask, m_powers(bit));
         m_mpz_manager.bitwise_xor(old_value, mask, flipped);
@@ -535,10 +558,10 @@ bailout:
     return res;
 }
 
-void sls_engine::operator()(goal_ref const & g, model_converter_ref & mc) {
+lbool sls_engine::operator()(goal_ref const & g, model_converter_ref & mc) {
     if (g->inconsistent()) {
         mc = 0;
-        return;
+        return l_false;
     }
 
     m_produce_models = g->models_enabled();
@@ -566,6 +589,7 @@ void sls_engine::operator()(goal_ref const & g, model_converter_ref & mc) {
     }
     else
         mc = 0;
+    return res;
 }
 
 lbool sls_engine::operator()() {    
@@ -582,7 +606,7 @@ lbool sls_engine::operator()() {
         report_tactic_progress("Searching... restarts left:", m_max_restarts - m_stats.m_restarts);
         res = search();
 
-        if (res == l_undef)
+        if (res == l_undef && !share())
         {
             if (m_restart_init)
                 m_tracker.randomize(m_assertions);
@@ -596,6 +620,55 @@ lbool sls_engine::operator()() {
     return res;
 }
 
+bool sls_engine::share() {
+    if (!m_shared || m_share_interval == 0 || (m_stats.m_restarts + 1) % m_share_interval != 0)
+        return false;
+
+    unsigned num_unsat = 0;
+    for (unsigned i = 0; i < m_assertions.size(); i++)
+        if (!m_mpz_manager.is_one(m_tracker.get_value(m_assertions[i])))
+            num_unsat++;
+
+    model_ref mdl = m_tracker.get_model();
+    if (m_shared->publish(m_id, *mdl, num_unsat))
+        m_stats.m_exports++;
+
+    model_ref best = m_shared->get_best(m_id, num_unsat, m_manager);
+    if (!best)
+        return false;
+    TRACE("sls", tout << "Importing model with fewer unsatisfied assertions than " << num_unsat << std::endl;);
+    m_tracker.set_model(best);
+    m_stats.m_imports++;
+    return true;
+}
+
+bool sls_shared::publish(unsigned id, model & mdl, unsigned num_unsat) {
+    bool is_best = false;
+    #pragma omp critical (sls_shared)
+    {
+        if (num_unsat < m_best_unsat) {
+            ast_translation tr(mdl.get_manager(), m);
+            m_best = mdl.translate(tr);
+            m_best_unsat = num_unsat;
+            m_owner = id;
+            is_best = true;
+        }
+    }
+    return is_best;
+}
+
+model_ref sls_shared::get_best(unsigned id, unsigned num_unsat, ast_manager & dst) {
+    model_ref result;
+    #pragma omp critical (sls_shared)
+    {
+        if (m_best && m_owner != id && m_best_unsat < num_unsat) {
+            ast_translation tr(m, dst);
+            result = m_best->translate(tr);
+        }
+    }
+    return result;
+}
+
 /* Andreas: Needed for Armin's restart scheme if we don't want to use loops.
 double sls_engine::get_restart_armin(unsigned cnt_restarts)
 {
@@ -28,6 +28,32 @@ Notes:
 #include "tactic/sls/sls_evaluator.h"
 #include "util/statistics.h"
 
+/**
+   \brief Best assignment found by a group of engines that run on
+   separate managers in parallel. The assignment is stored as a model
+   over the manager of the group. Access is serialized.
+*/
+class sls_shared {
+    ast_manager & m;
+    model_ref     m_best;
+    unsigned      m_best_unsat;   // number of unsatisfied assertions under m_best
+    unsigned      m_owner;        // engine that published m_best
+public:
+    sls_shared(ast_manager & m): m(m), m_best_unsat(UINT_MAX), m_owner(UINT_MAX) {}
+
+    /**
+       \brief publish the assignment mdl of engine id. Return true if it
+       is the new best assignment.
+    */
+    bool publish(unsigned id, model & mdl, unsigned num_unsat);
+
+    /**
+       \brief return the best assignment translated to dst, if it was found
+       by another engine and it violates fewer than num_unsat assertions.
+    */
+    model_ref get_best(unsigned id, unsigned num_unsat, ast_manager & dst);
+};
+
 class sls_engine {
 public:
     class stats {
@@ -37,6 +63,7 @@ public:
         unsigned        m_full_evals;
         unsigned        m_incr_evals;
         unsigned        m_moves, m_flips, m_incs, m_decs, m_invs;
+        unsigned        m_imports, m_exports;
 
         stats() :
             m_restarts(0),
@@ -46,7 +73,9 @@ public:
             m_flips(0),
             m_incs(0),
             m_decs(0),
-            m_invs(0) {
+            m_invs(0),
+            m_imports(0),
+            m_exports(0) {
             m_stopwatch.reset();
             m_stopwatch.start();
         }
@@ -83,6 +112,9 @@ protected:
     unsigned        m_early_prune;
     unsigned        m_random_offset;
     unsigned        m_rescore;
+    unsigned        m_share_interval;
+    sls_shared    * m_shared;
+    unsigned        m_id;
 
     typedef enum { MV_FLIP = 0, MV_INC, MV_DEC, MV_INV } move_type;
 
@@ -97,6 +129,12 @@ public:
 
     void assert_expr(expr * e) { m_assertions.push_back(e); }
 
+    /**
+       \brief exchange assignments through shared between restarts,
+       identifying this engine as id.
+    */
+    void set_shared(sls_shared * shared, unsigned id) { m_shared = shared; m_id = id; }
+
     // stats const & get_stats(void) { return m_stats; }
     void collect_statistics(statistics & st) const;
     void reset_statistics(void) { m_stats.reset(); }    
@@ -112,7 +150,7 @@ public:
     lbool search(void);    
 
     lbool operator()();
-    void operator()(goal_ref const & g, model_converter_ref & mc);
+    lbool operator()(goal_ref const & g, model_converter_ref & mc);
 
 protected:
     void checkpoint();
@@ -136,6 +174,8 @@ protected:
 
     //double get_restart_armin(unsigned cnt_restarts);    
     unsigned check_restart(unsigned curr_value);
+
+    bool share();
 };
 
 #endif
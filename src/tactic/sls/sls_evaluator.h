@@ -37,6 +37,7 @@ class sls_evaluator {
     expr_ref_buffer       m_temp_exprs;
     vector<ptr_vector<expr> > m_traversal_stack;
     vector<ptr_vector<expr> > m_traversal_stack_bool;
+    svector<uint64>       m_words;
 
 public:
     sls_evaluator(ast_manager & m, bv_util & bvu, sls_tracker & t, unsynch_mpz_manager & mm, powers & p) : 
@@ -70,6 +71,11 @@ public:
         }
 
         expr * const * args = n->get_args(); 
+
+        if (nfid == m_bv_fid && m_tracker.machine_words() && eval_word(n, result)) {
+            SASSERT(m_mpz_manager.is_nonneg(result));
+            return;
+        }
             
         m_mpz_manager.set(result, m_zero);
             
@@ -497,6 +503,173 @@ public:
         SASSERT(m_mpz_manager.is_nonneg(result));
     }
 
+    /**
+       \brief evaluate bit-vector operations whose arguments and result
+       have at most 64 bits on machine words. Returns false if n has to
+       be evaluated on bignums.
+    */
+    bool eval_word(app * n, mpz & result) {
+        unsigned n_args = n->get_num_args();
+        expr * const * args = n->get_args();
+        unsigned bv_sz = m_bv_util.is_bv(n) ? m_bv_util.get_bv_size(n) : 1;
+        if (!is_sls_word(bv_sz))
+            return false;
+        m_words.reset();
+        for (unsigned i = 0; i < n_args; i++) {
+            if (m_bv_util.is_bv(args[i]) && !is_sls_word(m_bv_util.get_bv_size(args[i])))
+                return false;
+            const mpz & v = m_tracker.get_value(args[i]);
+            SASSERT(m_mpz_manager.is_uint64(v));
+            m_words.push_back(m_mpz_manager.get_uint64(v));
+        }
+        uint64 mask = sls_word_mask(bv_sz);
+        uint64 r = 0;
+        switch (n->get_decl_kind()) {
+        case OP_CONCAT:
+            for (unsigned i = 0; i < n_args; i++) 
+                r = shift_left(r, m_bv_util.get_bv_size(args[i])) | m_words[i];
+            break;
+        case OP_EXTRACT: {
+            unsigned h = m_bv_util.get_extract_high(n);
+            unsigned l = m_bv_util.get_extract_low(n);
+            r = shift_right(m_words[0], l) & sls_word_mask(h - l + 1);
+            break;
+        }
+        case OP_BADD:
+            for (unsigned i = 0; i < n_args; i++) 
+                r += m_words[i];
+            r &= mask;
+            break;
+        case OP_BSUB:
+            r = (m_words[0] - m_words[1]) & mask;
+            break;
+        case OP_BMUL:
+            r = m_words[0];
+            for (unsigned i = 1; i < n_args; i++) 
+                r *= m_words[i];
+            r &= mask;
+            break;
+        case OP_BNEG:
+            r = (0 - m_words[0]) & mask;
+            break;
+        case OP_BUDIV:
+        case OP_BUDIV0:
+        case OP_BUDIV_I:
+            r = m_words[1] == 0 ? mask : m_words[0] / m_words[1];
+            break;
+        case OP_BUREM:
+        case OP_BUREM0:
+        case OP_BUREM_I:
+            r = m_words[1] == 0 ? m_words[0] : m_words[0] % m_words[1];
+            break;
+        case OP_BSDIV:
+        case OP_BSDIV0:
+        case OP_BSDIV_I: 
+        case OP_BSREM:
+        case OP_BSREM0:
+        case OP_BSREM_I: 
+        case OP_BSMOD:
+        case OP_BSMOD0:
+        case OP_BSMOD_I: {
+            // INT64_MIN / -1 overflows; 64 bit signed division is left to bignums.
+            if (bv_sz == 64)
+                return false;
+            int64 x = sls_word_to_signed(m_words[0], bv_sz);
+            int64 y = sls_word_to_signed(m_words[1], bv_sz);
+            int64 q;
+            switch (n->get_decl_kind()) {
+            case OP_BSDIV: case OP_BSDIV0: case OP_BSDIV_I:
+                q = (y != 0) ? x / y : (x < 0) ? 1 : -1;
+                break;
+            case OP_BSREM: case OP_BSREM0: case OP_BSREM_I:
+                q = (y != 0) ? x % y : x;
+                break;
+            default: 
+                if (y == 0) {
+                    q = x;
+                }
+                else {
+                    int64 abs_x = x < 0 ? -x : x;
+                    int64 abs_y = y < 0 ? -y : y;
+                    q = abs_x % abs_y;
+                    if (q != 0 && x < 0 && y >= 0)
+                        q = y - q;
+                    else if (q != 0 && x >= 0 && y < 0)
+                        q = q + y;
+                    else if (q != 0 && x < 0 && y < 0)
+                        q = -q;
+                }
+                break;
+            }
+            r = static_cast<uint64>(q) & mask;
+            break;
+        }
+        case OP_BAND:
+            r = m_words[0];
+            for (unsigned i = 1; i < n_args; i++) 
+                r &= m_words[i];
+            break;
+        case OP_BOR:
+            r = m_words[0];
+            for (unsigned i = 1; i < n_args; i++) 
+                r |= m_words[i];
+            break;
+        case OP_BXOR:
+            r = m_words[0];
+            for (unsigned i = 1; i < n_args; i++) 
+                r ^= m_words[i];
+            break;
+        case OP_BNAND:
+            r = m_words[0];
+            for (unsigned i = 1; i < n_args; i++) 
+                r = ~(r & m_words[i]) & mask;
+            break;
+        case OP_BNOR:
+            r = m_words[0];
+            for (unsigned i = 1; i < n_args; i++) 
+                r = ~(r | m_words[i]) & mask;
+            break;
+        case OP_BNOT:
+            r = ~m_words[0] & mask;
+            break;
+        case OP_ULT:  r = m_words[0] <  m_words[1]; break;
+        case OP_ULEQ: r = m_words[0] <= m_words[1]; break;
+        case OP_UGT:  r = m_words[0] >  m_words[1]; break;
+        case OP_UGEQ: r = m_words[0] >= m_words[1]; break;
+        case OP_SLT:
+        case OP_SLEQ: 
+        case OP_SGT:
+        case OP_SGEQ: {
+            unsigned arg_sz = m_bv_util.get_bv_size(args[0]);
+            int64 x = sls_word_to_signed(m_words[0], arg_sz);
+            int64 y = sls_word_to_signed(m_words[1], arg_sz);
+            switch (n->get_decl_kind()) {
+            case OP_SLT:  r = x <  y; break;
+            case OP_SLEQ: r = x <= y; break;
+            case OP_SGT:  r = x >  y; break;
+            default:      r = x >= y; break;
+            }
+            break;
+        }
+        case OP_BSHL:
+            r = shift_left(m_words[0], m_words[1]) & mask;
+            break;
+        case OP_BLSHR:
+            r = shift_right(m_words[0], m_words[1]);
+            break;
+        case OP_BASHR: 
+            if (m_words[1] >= bv_sz) 
+                r = sls_word_to_signed(m_words[0], bv_sz) < 0 ? mask : 0;
+            else
+                r = static_cast<uint64>(sls_word_to_signed(m_words[0], bv_sz) >> m_words[1]) & mask;
+            break;
+        default:
+            return false;
+        }
+        m_mpz_manager.set(result, r);
+        return true;
+    }
+
     void eval_checked(expr * n, mpz & result) {
         switch(n->get_kind()) {
         case AST_APP: {
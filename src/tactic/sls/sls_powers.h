@@ -46,4 +46,23 @@ public:
     }
 };  
 
+// Bit-vectors of at most 64 bits are also evaluated on machine words.
+inline bool is_sls_word(unsigned bv_sz) { return bv_sz <= 64; }
+
+inline uint64 sls_word_mask(unsigned bv_sz) {
+    return bv_sz >= 64 ? static_cast<uint64>(-1) : (static_cast<uint64>(1) << bv_sz) - 1;
+}
+
+// two's complement interpretation of a bv_sz bit word.
+inline int64 sls_word_to_signed(uint64 v, unsigned bv_sz) {
+    SASSERT(bv_sz > 0);
+    if (bv_sz < 64 && ((v >> (bv_sz - 1)) & 1))
+        v |= ~sls_word_mask(bv_sz);
+    return static_cast<int64>(v);
+}
+
+inline unsigned sls_word_num_1bits(uint64 v) {
+    return get_num_1bits(static_cast<unsigned>(v)) + get_num_1bits(static_cast<unsigned>(v >> 32));
+}
+
 #endif
@@ -29,11 +29,82 @@ Notes:
 #include "tactic/sls/sls_tactic.h"
 #include "tactic/sls/sls_params.hpp"
 #include "tactic/sls/sls_engine.h"
+#include "ast/ast_translation.h"
+#include "util/scoped_ptr_vector.h"
+#include "util/z3_omp.h"
 
 class sls_tactic : public tactic {    
     ast_manager    & m;
     params_ref       m_params;
     sls_engine     * m_engine;
+    statistics       m_par_stats;
+
+    /**
+       \brief run one engine per thread, each on its own manager and with
+       its own random seed. The engines exchange their best assignments
+       through a shared store; the first one to find a model cancels the
+       others.
+    */
+    void run_parallel(goal_ref const & g, model_converter_ref & mc, unsigned num_threads) {
+        sls_params p(m_params);
+        ast_manager shared_m(m, !m.proof_mode());
+        sls_shared shared(shared_m);
+        scoped_ptr_vector<ast_manager> managers;
+        goal_ref_vector                goals;
+        scoped_ptr_vector<sls_engine>  engines;
+        scoped_limits scl(m.limit());
+        for (unsigned i = 0; i < num_threads; i++) {
+            ast_manager * new_m = alloc(ast_manager, m, !m.proof_mode());
+            managers.push_back(new_m);
+            ast_translation translator(m, *new_m);
+            goals.push_back(g->translate(translator));
+            params_ref engine_p(m_params);
+            engine_p.set_uint("random_seed", p.random_seed() + i);
+            sls_engine * e = alloc(sls_engine, *new_m, engine_p);
+            e->set_shared(&shared, i);
+            engines.push_back(e);
+            scl.push_child(&new_m->limit());
+        }
+
+        unsigned finished_id = UINT_MAX;
+        #pragma omp parallel for
+        for (int i = 0; i < static_cast<int>(num_threads); i++) {
+            model_converter_ref _mc;
+            try {
+                if ((*engines[i])(goals[i], _mc) != l_true)
+                    continue;
+                bool first = false;
+                #pragma omp critical (sls_tactic)
+                {
+                    if (finished_id == UINT_MAX) {
+                        finished_id = i;
+                        first = true;
+                    }
+                }
+                if (first) {
+                    for (unsigned j = 0; j < num_threads; j++)
+                        if (static_cast<unsigned>(i) != j)
+                            managers[j]->limit().cancel();
+                    ast_translation translator(*(managers[i]), m, false);
+                    mc = _mc ? _mc->translate(translator) : 0;
+                }
+            }
+            catch (z3_exception &) {
+                // canceled by the winner or by the caller.
+            }
+        }
+
+        for (unsigned i = 0; i < num_threads; i++)
+            engines[i]->collect_statistics(m_par_stats);
+        if (finished_id != UINT_MAX) {
+            report_tactic_progress("Walker found model:", finished_id);
+            g->reset();
+            return;
+        }
+        mc = 0;
+        if (m.canceled())
+            throw tactic_exception(m.limit().get_cancel_msg());
+    }
 
 public:
     sls_tactic(ast_manager & _m, params_ref const & p):
@@ -70,7 +141,17 @@ public:
         TRACE("sls", g->display(tout););
         tactic_report report("sls", *g);
         
-        m_engine->operator()(g, mc);
+        unsigned num_threads = sls_params(m_params).threads();
+        bool use_seq = num_threads <= 1 || g->inconsistent();
+#ifdef _NO_OMP_
+        use_seq = true;
+#else
+        use_seq = use_seq || 0 != omp_in_parallel();
+#endif
+        if (use_seq)
+            m_engine->operator()(g, mc);
+        else
+            run_parallel(g, mc, num_threads);
 
         g->inc_depth();
         result.push_back(g.get());
@@ -86,10 +167,12 @@ public:
     
     virtual void collect_statistics(statistics & st) const {
         m_engine->collect_statistics(st);
+        st.copy(m_par_stats);
     }
 
     virtual void reset_statistics() {
         m_engine->reset_statistics();
+        m_par_stats.reset();
     }
 
 };
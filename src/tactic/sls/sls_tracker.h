@@ -88,6 +88,7 @@ private:
     obj_map<expr, unsigned>	m_where_false;
     expr**					m_list_false;
     unsigned              m_track_unsat;
+    bool                  m_machine_words;
     obj_map<expr, unsigned> m_weights;
     double				  m_top_sum;
     obj_hashtable<expr>   m_temp_seen;
@@ -99,6 +100,7 @@ public:
         m_bv_util(bvu),
         m_powers(p),
         m_random_bits_cnt(0),        
+        m_machine_words(true),
         m_zero(m_mpz_manager.mk_z(0)),
         m_one(m_mpz_manager.mk_z(1)),
         m_two(m_mpz_manager.mk_z(2)) {
@@ -123,8 +125,11 @@ public:
         // Andreas: track_unsat is currently disabled because I cannot guarantee that it is not buggy.
         // If you want to use it, you will also need to change comments in the assertion selection.
         m_track_unsat = 0;//p.track_unsat();
+        m_machine_words = p.machine_words();
     }
 
+    bool machine_words() const { return m_machine_words; }
+
     /* Andreas: Tried to give some measure for the formula size by the following two methods but both are not used currently.
     unsigned get_formula_size() {
         return m_scores.size();
@@ -701,6 +706,12 @@ public:
             NOT_IMPLEMENTED_YET();
     }
 
+    // 1 - diff / 2^bv_sz, clamped to [0, 1].
+    static double word_score(double diff, unsigned bv_sz) {
+        double dbl = ldexp(diff, -static_cast<int>(bv_sz));
+        return (dbl > 1.0) ? 0.0 : (dbl < 0.0) ? 1.0 : 1.0 - dbl;
+    }
+
     double score_bool(expr * n, bool negated = false) {
         TRACE("sls_score", tout << ((negated)?"NEG ":"") << "BOOL: " << mk_ismt2_pp(n, m_manager) << std::endl; );
 
@@ -767,6 +778,11 @@ public:
                 TRACE("sls_score", tout << "V0 = " << m_mpz_manager.to_string(v0) << " ; V1 = " << 
                                         m_mpz_manager.to_string(v1) << std::endl; );
             }
+            else if (m_bv_util.is_bv(arg0) && m_machine_words && is_sls_word(m_bv_util.get_bv_size(arg0))) {
+                unsigned bv_sz = m_bv_util.get_bv_size(arg0);
+                unsigned hamming_distance = sls_word_num_1bits(m_mpz_manager.get_uint64(v0) ^ m_mpz_manager.get_uint64(v1));
+                res = 1.0 - (hamming_distance / (double) bv_sz);
+            }
             else if (m_bv_util.is_bv(arg0)) {
                 mpz diff, diff_m1;
                 m_mpz_manager.bitwise_xor(v0, v1, diff);
@@ -796,7 +812,15 @@ public:
             const mpz & y = get_value(a->get_arg(1));
             int bv_sz = m_bv_util.get_bv_size(a->get_decl()->get_domain()[0]);
 
-            if (negated) {
+            if (m_machine_words && is_sls_word(bv_sz)) {
+                uint64 wx = m_mpz_manager.get_uint64(x);
+                uint64 wy = m_mpz_manager.get_uint64(y);
+                if (negated) 
+                    res = (wx > wy) ? 1.0 : word_score(static_cast<double>(wy - wx) + 1.0, bv_sz);
+                else
+                    res = (wx <= wy) ? 1.0 : word_score(static_cast<double>(wx - wy), bv_sz);
+            }
+            else if (negated) {
                 if (m_mpz_manager.gt(x, y))
                     res = 1.0; 
                 else {
@@ -827,6 +851,19 @@ public:
             TRACE("sls_score", tout << "x = " << m_mpz_manager.to_string(x) << " ; y = " << 
                                     m_mpz_manager.to_string(y) << " ; SZ = " << bv_sz << std::endl; );
         }
+        else if (m_bv_util.is_bv_sle(n) && m_machine_words && 
+                 is_sls_word(m_bv_util.get_bv_size(to_app(n)->get_decl()->get_domain()[0]))) { // x <= y
+            app * a = to_app(n);
+            SASSERT(a->get_num_args() == 2);
+            unsigned bv_sz = m_bv_util.get_bv_size(a->get_decl()->get_domain()[0]);
+            int64 x = sls_word_to_signed(m_mpz_manager.get_uint64(get_value(a->get_arg(0))), bv_sz);
+            int64 y = sls_word_to_signed(m_mpz_manager.get_uint64(get_value(a->get_arg(1))), bv_sz);
+            // the difference of two bv_sz bit signed numbers fits in bv_sz unsigned bits.
+            if (negated) 
+                res = (x > y) ? 1.0 : word_score(static_cast<double>(static_cast<uint64>(y) - static_cast<uint64>(x)) + 1.0, bv_sz);
+            else 
+                res = (x <= y) ? 1.0 : word_score(static_cast<double>(static_cast<uint64>(x) - static_cast<uint64>(y)), bv_sz);
+        }
         else if (m_bv_util.is_bv_sle(n)) { // x <= y
             app * a = to_app(n);
             SASSERT(a->get_num_args() == 2);
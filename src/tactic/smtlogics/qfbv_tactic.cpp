@@ -29,6 +29,8 @@ Notes:
 #include "tactic/aig/aig_tactic.h"
 #include "sat/tactic/sat_tactic.h"
 #include "ackermannization/ackermannize_bv_tactic.h"
+#include "tactic/sls/sls_tactic.h"
+#include "tactic/sls/sls_params.hpp"
 
 #define MEMLIMIT 300
 
@@ -132,6 +134,11 @@ tactic * mk_qfbv_tactic(ast_manager & m, params_ref const & p) {
                             and_then(mk_simplify_tactic(m), mk_smt_tactic()),
                             mk_sat_tactic(m));
 
-    return mk_qfbv_tactic(m, p, new_sat, mk_smt_tactic());
+    tactic * st = mk_qfbv_tactic(m, p, new_sat, mk_smt_tactic());
+    if (!sls_params(p).qfbv_race())
+        return st;
 
+    // SLS can only find models; it gives up on its copy of the goal
+    // instead of returning it undecided, so the bit-blaster decides the rest.
+    return par(st, and_then(mk_qfbv_sls_tactic(m, p), mk_fail_if_undecided_tactic()));
 }
@@ -0,0 +1,212 @@
+/*++
+Copyright (c) 2017 Microsoft Corporation
+
+Module Name:
+
+    aig.cpp
+
+Abstract:
+
+    Cut based rewriting and SAT sweeping (fraiging) in the aig tactic.
+    Random Boolean formulas have to be equivalent to their simplified
+    versions, and bit-blasted equivalence checking problems have to
+    keep their status while losing AIG nodes.
+
+--*/
+
+#include "tactic/aig/aig_tactic.h"
+#include "tactic/bv/bit_blaster_tactic.h"
+#include "tactic/tactical.h"
+#include "sat/tactic/sat_tactic.h"
+#include "smt/tactic/smt_tactic.h"
+#include "ast/reg_decl_plugins.h"
+#include "ast/bv_decl_plugin.h"
+#include "model/model.h"
+#include "util/stopwatch.h"
+#include "util/statistics.h"
+#include <sstream>
+
+static unsigned get_stat(statistics const& st, char const* key) {
+    unsigned r = 0;
+    for (unsigned i = 0; i < st.size(); ++i) {
+        if (st.is_uint(i) && strcmp(st.get_key(i), key) == 0) {
+            r += st.get_uint_value(i);
+        }
+    }
+    return r;
+}
+
+static params_ref mk_aig_params(bool rewrite, bool fraig) {
+    params_ref p;
+    p.set_bool("aig_per_assertion", false);
+    p.set_bool("aig_rewrite", rewrite);
+    p.set_bool("aig_fraig", fraig);
+    return p;
+}
+
+static lbool run(ast_manager& m, tactic* t, expr_ref_vector const& fmls, char const* name, bool check_model) {
+    tactic_ref tr = t;
+    goal_ref g = alloc(goal, m, true, false);
+    for (unsigned i = 0; i < fmls.size(); ++i) {
+        g->assert_expr(fmls[i]);
+    }
+    goal_ref_buffer result;
+    model_converter_ref mc;
+    proof_converter_ref pc;
+    expr_dependency_ref core(m);
+    stopwatch sw;
+    sw.start();
+    (*tr)(g, result, mc, pc, core);
+    sw.stop();
+    statistics st;
+    tr->collect_statistics(st);
+    lbool r = l_undef;
+    if (is_decided_sat(result)) r = l_true;
+    if (is_decided_unsat(result)) r = l_false;
+    std::cout << name << " " << r
+              << " nodes: " << get_stat(st, "aig nodes before") << " -> " << get_stat(st, "aig nodes after")
+              << " rewrites: " << get_stat(st, "aig rewrites")
+              << " merges: " << get_stat(st, "aig fraig merges")
+              << " sat calls: " << get_stat(st, "aig fraig sat calls")
+              << " time: " << sw.get_seconds() << std::endl;
+    ENSURE(get_stat(st, "aig nodes after") <= get_stat(st, "aig nodes before"));
+    if (r == l_true && check_model) {
+        ENSURE(mc);
+        model_ref mdl;
+        (*mc)(mdl, 0);
+        expr_ref val(m);
+        for (unsigned i = 0; i < fmls.size(); ++i) {
+            ENSURE(mdl->eval(fmls[i], val, true) && m.is_true(val));
+        }
+    }
+    return r;
+}
+
+static expr_ref mk_random_formula(ast_manager& m, random_gen& rand, expr_ref_vector const& vars, unsigned depth) {
+    if (depth == 0 || rand(5) == 0) {
+        expr_ref r(vars[rand(vars.size())], m);
+        if (rand(2) == 0) r = m.mk_not(r);
+        return r;
+    }
+    expr_ref a = mk_random_formula(m, rand, vars, depth - 1);
+    expr_ref b = mk_random_formula(m, rand, vars, depth - 1);
+    switch (rand(5)) {
+    case 0: return expr_ref(m.mk_and(a, b), m);
+    case 1: return expr_ref(m.mk_or(a, b), m);
+    case 2: return expr_ref(m.mk_xor(a, b), m);
+    case 3: return expr_ref(m.mk_not(m.mk_and(a, b)), m);
+    default: {
+        expr_ref c = mk_random_formula(m, rand, vars, depth - 1);
+        return expr_ref(m.mk_ite(a, b, c), m);
+    }
+    }
+}
+
+// the simplified version of f has to be equivalent to f.
+static void tst_random_equiv(unsigned num_vars, unsigned depth, unsigned num_tests, bool rewrite, bool fraig) {
+    ast_manager m;
+    reg_decl_plugins(m);
+    random_gen rand(num_vars + depth);
+    expr_ref_vector vars(m);
+    for (unsigned i = 0; i < num_vars; ++i) {
+        std::stringstream strm;
+        strm << "p" << i;
+        vars.push_back(m.mk_const(symbol(strm.str().c_str()), m.mk_bool_sort()));
+    }
+    tactic_ref t = mk_aig_tactic(mk_aig_params(rewrite, fraig));
+    for (unsigned k = 0; k < num_tests; ++k) {
+        expr_ref f = mk_random_formula(m, rand, vars, depth);
+        goal_ref g = alloc(goal, m, false, false);
+        g->assert_expr(f);
+        goal_ref_buffer result;
+        model_converter_ref mc;
+        proof_converter_ref pc;
+        expr_dependency_ref core(m);
+        (*t)(g, result, mc, pc, core);
+        ENSURE(result.size() == 1);
+        expr_ref_vector conj(m);
+        for (unsigned i = 0; i < result[0]->size(); ++i) {
+            conj.push_back(result[0]->form(i));
+        }
+        expr_ref f2(m.mk_and(conj.size(), conj.c_ptr()), m);
+        tactic_ref s = mk_smt_tactic();
+        goal_ref g2 = alloc(goal, m, false, false);
+        g2->assert_expr(m.mk_not(m.mk_eq(f, f2)));
+        result.reset();
+        (*s)(g2, result, mc, pc, core);
+        ENSURE(is_decided_unsat(result));
+    }
+    statistics st;
+    t->collect_statistics(st);
+    std::cout << "random vars: " << num_vars << " depth: " << depth << " rewrite: " << rewrite << " fraig: " << fraig
+              << " nodes: " << get_stat(st, "aig nodes before") << " -> " << get_stat(st, "aig nodes after")
+              << " rewrites: " << get_stat(st, "aig rewrites")
+              << " merges: " << get_stat(st, "aig fraig merges") << std::endl;
+    ENSURE(get_stat(st, "aig nodes after") <= get_stat(st, "aig nodes before"));
+}
+
+static void mk_bv_vars(ast_manager& m, unsigned num_bits, expr_ref& x, expr_ref& y) {
+    bv_util bv(m);
+    x = m.mk_const(symbol("x"), bv.mk_sort(num_bits));
+    y = m.mk_const(symbol("y"), bv.mk_sort(num_bits));
+}
+
+static void solve(ast_manager& m, expr_ref_vector const& fmls, lbool expected, bool check_model) {
+    lbool r1 = run(m, and_then(mk_bit_blaster_tactic(m), mk_aig_tactic(mk_aig_params(false, false)), mk_sat_tactic(m)), fmls, "aig        ", check_model);
+    lbool r2 = run(m, and_then(mk_bit_blaster_tactic(m), mk_aig_tactic(mk_aig_params(true, false)), mk_sat_tactic(m)), fmls, "rewrite    ", check_model);
+    lbool r3 = run(m, and_then(mk_bit_blaster_tactic(m), mk_aig_tactic(mk_aig_params(false, true)), mk_sat_tactic(m)), fmls, "fraig      ", check_model);
+    lbool r4 = run(m, and_then(mk_bit_blaster_tactic(m), mk_aig_tactic(mk_aig_params(true, true)), mk_sat_tactic(m)), fmls, "rewr+fraig ", check_model);
+    ENSURE(r1 == expected && r2 == expected && r3 == expected && r4 == expected);
+}
+
+// x * y != y * x
+static void tst_commute(unsigned num_bits) {
+    ast_manager m;
+    reg_decl_plugins(m);
+    bv_util bv(m);
+    expr_ref x(m), y(m);
+    mk_bv_vars(m, num_bits, x, y);
+    expr_ref_vector fmls(m);
+    fmls.push_back(m.mk_not(m.mk_eq(bv.mk_bv_mul(x, y), bv.mk_bv_mul(y, x))));
+    std::cout << "commute " << num_bits << " bits" << std::endl;
+    solve(m, fmls, l_false, false);
+}
+
+// x * (y + 1) != x * y + x
+static void tst_distrib(unsigned num_bits) {
+    ast_manager m;
+    reg_decl_plugins(m);
+    bv_util bv(m);
+    expr_ref x(m), y(m);
+    mk_bv_vars(m, num_bits, x, y);
+    expr_ref one(bv.mk_numeral(1, num_bits), m);
+    expr_ref_vector fmls(m);
+    fmls.push_back(m.mk_not(m.mk_eq(bv.mk_bv_mul(x, bv.mk_bv_add(y, one)), bv.mk_bv_add(bv.mk_bv_mul(x, y), x))));
+    std::cout << "distrib " << num_bits << " bits" << std::endl;
+    solve(m, fmls, l_false, false);
+}
+
+// x * y = c with 1 < x, y
+static void tst_factor(unsigned num_bits, unsigned c) {
+    ast_manager m;
+    reg_decl_plugins(m);
+    bv_util bv(m);
+    expr_ref x(m), y(m);
+    mk_bv_vars(m, num_bits, x, y);
+    expr_ref_vector fmls(m);
+    fmls.push_back(m.mk_eq(bv.mk_bv_mul(x, y), bv.mk_numeral(c, num_bits)));
+    fmls.push_back(m.mk_not(bv.mk_ule(x, bv.mk_numeral(1, num_bits))));
+    fmls.push_back(m.mk_not(bv.mk_ule(y, bv.mk_numeral(1, num_bits))));
+    std::cout << "factor " << num_bits << " bits" << std::endl;
+    solve(m, fmls, l_true, true);
+}
+
+void tst_aig() {
+    tst_random_equiv(4, 6, 50, true, false);
+    tst_random_equiv(4, 6, 50, false, true);
+    tst_random_equiv(8, 8, 50, true, true);
+    tst_commute(6);
+    tst_commute(7);
+    tst_distrib(6);
+    tst_factor(16, 4087);
+}
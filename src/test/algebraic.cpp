@@ -20,6 +20,9 @@ Notes:
 #include "math/polynomial/polynomial_var2value.h"
 #include "util/mpbq.h"
 #include "util/rlimit.h"
+#include "util/statistics.h"
+#include "util/stopwatch.h"
+#include "util/util.h"
 
 static void display_anums(std::ostream & out, scoped_anum_vector const & rs) {
     out << "numbers in decimal:\n";
@@ -248,6 +251,48 @@ static void tst_wilkinson() {
     }
 }
 
+static unsigned get_stat(statistics const & st, char const * key) {
+    for (unsigned i = 0; i < st.size(); i++) {
+        if (st.is_uint(i) && strcmp(st.get_key(i), key) == 0)
+            return st.get_uint_value(i);
+    }
+    return 0;
+}
+
+static void tst_root_cache() {
+    reslimit rl;
+    unsynch_mpq_manager nm;
+    polynomial::manager m(rl, nm);
+    polynomial_ref x(m), y(m);
+    x = m.mk_polynomial(m.mk_var());
+    y = m.mk_polynomial(m.mk_var());
+    polynomial_ref p(m), q(m);
+    p = (x^5) - 3*(x^3) + x - 1;
+    // q(x, 2) = p(x)
+    q = (x^5) - 3*(x^3) + (y - 1)*x - 1;
+
+    algebraic_numbers::manager am(rl, nm);
+    scoped_anum_vector rs1(am), rs2(am), rs3(am);
+    am.isolate_roots(p, rs1);
+    am.isolate_roots(p, rs2);
+    scoped_anum v(am);
+    am.set(v, 2);
+    polynomial::simple_var2value<algebraic_numbers::manager> x2v(am);
+    x2v.push_back(1, v);
+    am.isolate_roots(q, x2v, rs3);
+    display_anums(std::cout, rs1);
+    ENSURE(rs1.size() == rs2.size() && rs1.size() == rs3.size());
+    for (unsigned i = 0; i < rs1.size(); i++) {
+        ENSURE(am.eq(rs1[i], rs2[i]));
+        ENSURE(am.eq(rs1[i], rs3[i]));
+    }
+    statistics st;
+    am.collect_statistics(st);
+    st.display(std::cout);
+    ENSURE(get_stat(st, "algebraic root cache misses") == 1);
+    ENSURE(get_stat(st, "algebraic root cache hits") == 2);
+}
+
 static void tst_dejan() {
     reslimit rl;
     unsynch_mpq_manager qm;
@@ -385,6 +430,101 @@ static void tst_eval_sign() {
 
 }
 
+static void set_random_value(anum_manager & am, random_gen & rand, bool algebraic, anum & v) {
+    scoped_mpq q(am.qm());
+    am.qm().set(q, static_cast<int>(rand(41)) - 20, 1 + rand(8));
+    if (algebraic) {
+        am.qm().abs(q);
+        am.qm().add(q, mpq(1), q);
+        am.set(v, q);
+        am.root(v, 2, v);
+    }
+    else {
+        am.set(v, q);
+    }
+}
+
+// Throughput of eval_sign_at with and without the floating point interval filter.
+static void tst_eval_sign_hwf(unsigned seed, bool algebraic) {
+    reslimit rl;
+    unsynch_mpq_manager qm;
+    polynomial::manager pm(rl, qm);
+    params_ref p;
+    p.set_bool("hwf_eval", false);
+    anum_manager am1(rl, qm, p);
+    anum_manager am2(rl, qm);
+    random_gen rand(seed);
+    unsigned num_vars = 4;
+    polynomial_ref_vector xs(pm), ps(pm);
+    for (unsigned i = 0; i < num_vars; i++) {
+        xs.push_back(pm.mk_polynomial(pm.mk_var()));
+    }
+    polynomial_ref q(pm), m(pm);
+    for (unsigned i = 0; i < 40; i++) {
+        q = pm.mk_zero();
+        for (unsigned j = 0; j < 6; j++) {
+            m = pm.mk_const(rational(static_cast<int>(rand(21)) - 10));
+            m = m * (polynomial_ref(xs.get(rand(num_vars)), pm)^rand(4));
+            m = m * (polynomial_ref(xs.get(rand(num_vars)), pm)^rand(4));
+            q = q + m;
+        }
+        ps.push_back(q);
+    }
+    scoped_anum_vector vs1(am1), vs2(am2);
+    scoped_anum v1(am1), v2(am2);
+    svector<int> signs1, signs2;
+    stopwatch sw1, sw2;
+    for (unsigned k = 0; k < 200; k++) {
+        vs1.reset();
+        vs2.reset();
+        for (unsigned i = 0; i < num_vars; i++) {
+            unsigned s = rand();
+            random_gen r1(s), r2(s);
+            bool alg = algebraic && rand(2) == 0;
+            set_random_value(am1, r1, alg, v1);
+            set_random_value(am2, r2, alg, v2);
+            vs1.push_back(v1);
+            vs2.push_back(v2);
+        }
+        polynomial::simple_var2value<anum_manager> x2v1(am1), x2v2(am2);
+        for (unsigned i = 0; i < num_vars; i++) {
+            x2v1.push_back(i, vs1[i]);
+            x2v2.push_back(i, vs2[i]);
+        }
+        sw1.start();
+        for (unsigned i = 0; i < ps.size(); i++) {
+            signs1.push_back(am1.eval_sign_at(polynomial_ref(ps.get(i), pm), x2v1));
+        }
+        sw1.stop();
+        sw2.start();
+        for (unsigned i = 0; i < ps.size(); i++) {
+            signs2.push_back(am2.eval_sign_at(polynomial_ref(ps.get(i), pm), x2v2));
+        }
+        sw2.stop();
+    }
+    ENSURE(signs1.size() == signs2.size());
+    for (unsigned i = 0; i < signs1.size(); i++) {
+        // the precise evaluation of rational values returns the sign of the numerator.
+        ENSURE((signs1[i] > 0) == (signs2[i] > 0));
+        ENSURE((signs1[i] < 0) == (signs2[i] < 0));
+    }
+    statistics st;
+    am2.collect_statistics(st);
+    std::cout << (algebraic ? "algebraic" : "rational") << " seed: " << seed
+              << " evals: " << signs1.size()
+              << " precise evals/sec: " << signs1.size() / std::max(sw1.get_seconds(), 0.001)
+              << " hwf evals/sec: " << signs2.size() / std::max(sw2.get_seconds(), 0.001)
+              << " hwf hits: " << get_stat(st, "algebraic hwf eval hits")
+              << " misses: " << get_stat(st, "algebraic hwf eval misses") << "\n";
+}
+
+static void tst_eval_sign_hwf() {
+    for (unsigned seed = 0; seed < 3; seed++) {
+        tst_eval_sign_hwf(seed, false);
+        tst_eval_sign_hwf(seed, true);
+    }
+}
+
 static void tst_isolate_roots(polynomial_ref const & p, anum_manager & am,
                               polynomial::var x0, anum const & v0, polynomial::var x1, anum const & v1, polynomial::var x2, anum const & v2) {
     polynomial::simple_var2value<anum_manager> x2v(am);
@@ -570,9 +710,11 @@ void tst_algebraic() {
     // enable_trace("mpz_mul2k");
     // enable_trace("mpz_gcd");
     tst_root();
+    tst_root_cache();
     tst_isolate_roots();
     ex1();
     tst_eval_sign();
+    tst_eval_sign_hwf();
     tst_select_small();
     tst_dejan();
     tst_wilkinson();
@@ -0,0 +1,199 @@
+/*++
+Copyright (c) 2017 Microsoft Corporation
+
+Module Name:
+
+    ast_translation.cpp
+
+Abstract:
+
+    Bulk translation of expressions between managers, and the
+    declaration caches shared by translations between the same managers.
+
+--*/
+
+#include "ast/ast_translation.h"
+#include "ast/reg_decl_plugins.h"
+#include "ast/arith_decl_plugin.h"
+#include "ast/ast_pp.h"
+#include "util/stopwatch.h"
+#include <sstream>
+
+static expr_ref mk_int_const(ast_manager& m, char const* prefix, unsigned i) {
+    arith_util a(m);
+    std::stringstream strm;
+    strm << prefix << i;
+    return expr_ref(m.mk_const(symbol(strm.str().c_str()), a.mk_int()), m);
+}
+
+// A random DAG over integer constants, an uninterpreted function and a quantifier.
+static void mk_terms(ast_manager& m, unsigned num_vars, unsigned num_terms, unsigned seed, expr_ref_vector& fmls) {
+    arith_util a(m);
+    random_gen rand(seed);
+    sort* i = a.mk_int();
+    sort* dom[2] = { i, i };
+    func_decl_ref f(m.mk_func_decl(symbol("f"), 2, dom, i), m);
+    expr_ref_vector terms(m);
+    for (unsigned j = 0; j < num_vars; ++j) {
+        terms.push_back(mk_int_const(m, "x", j));
+    }
+    for (unsigned j = 0; j < num_terms; ++j) {
+        expr* t1 = terms.get(rand(terms.size()));
+        expr* t2 = terms.get(rand(terms.size()));
+        switch (rand(3)) {
+        case 0: terms.push_back(a.mk_add(t1, t2)); break;
+        case 1: terms.push_back(m.mk_app(f, t1, t2)); break;
+        default: terms.push_back(m.mk_ite(a.mk_le(t1, t2), t1, a.mk_mul(a.mk_int(j), t2))); break;
+        }
+        if (rand(4) == 0) {
+            fmls.push_back(a.mk_ge(terms.get(terms.size() - 1), a.mk_int(rand(100))));
+        }
+    }
+    symbol name("y");
+    expr_ref body(m.mk_eq(m.mk_app(f, m.mk_var(0, i), terms.get(terms.size() - 1)), m.mk_var(0, i)), m);
+    fmls.push_back(m.mk_forall(1, &i, &name, body));
+}
+
+// The bulk translation builds the same terms as translating one term at a time.
+static void tst_bulk(unsigned num_vars, unsigned num_terms, unsigned seed) {
+    ast_manager m1;
+    reg_decl_plugins(m1);
+    expr_ref_vector fmls(m1);
+    mk_terms(m1, num_vars, num_terms, seed, fmls);
+
+    ast_manager m2;
+    reg_decl_plugins(m2);
+    expr_ref_vector bulk(m2), single(m2);
+    {
+        ast_translation tr(m1, m2);
+        tr(fmls.size(), fmls.c_ptr(), bulk);
+    }
+    {
+        ast_translation tr(m1, m2);
+        for (unsigned j = 0; j < fmls.size(); ++j) {
+            single.push_back(tr(fmls.get(j)));
+        }
+    }
+    ENSURE(bulk.size() == fmls.size());
+    for (unsigned j = 0; j < fmls.size(); ++j) {
+        ENSURE(bulk.get(j) == single.get(j));
+    }
+
+    // translating back gives the original terms.
+    ast_translation back(m2, m1);
+    expr_ref_vector fmls2(m1);
+    back(bulk.size(), bulk.c_ptr(), fmls2);
+    for (unsigned j = 0; j < fmls.size(); ++j) {
+        ENSURE(fmls.get(j) == fmls2.get(j));
+    }
+}
+
+// Ids of deleted terms are reused, so a term may have a smaller id than its arguments.
+static void tst_recycled_ids() {
+    ast_manager m1;
+    reg_decl_plugins(m1);
+    arith_util a(m1);
+    expr_ref x(mk_int_const(m1, "x", 0), m1);
+    expr_ref y(mk_int_const(m1, "y", 0), m1);
+    expr_ref t(m1), u(m1);
+    {
+        expr_ref_vector tmp(m1);
+        for (unsigned j = 0; j < 100; ++j) {
+            tmp.push_back(a.mk_add(x, a.mk_int(j)));
+        }
+        t = a.mk_mul(x, y);
+        u = a.mk_sub(t, y);
+    }
+    // the terms in tmp are deleted, and their ids are used by the following terms.
+    expr_ref_vector fmls(m1);
+    fmls.push_back(a.mk_le(a.mk_add(u, t), a.mk_int(3)));
+    fmls.push_back(m1.mk_eq(a.mk_mul(u, u), x));
+    ENSURE(fmls.get(0)->get_id() < u->get_id());
+
+    ast_manager m2;
+    reg_decl_plugins(m2);
+    ast_translation tr(m1, m2);
+    expr_ref_vector res(m2);
+    tr(fmls.size(), fmls.c_ptr(), res);
+    ast_translation tr2(m1, m2);
+    for (unsigned j = 0; j < fmls.size(); ++j) {
+        ENSURE(res.get(j) == tr2(fmls.get(j)));
+    }
+    std::cout << mk_pp(res.get(0), m2) << std::endl;
+}
+
+// Translations between the same managers share the translated declarations.
+static void tst_shared_decls(bool delete_source_first) {
+    ast_manager* m1 = alloc(ast_manager);
+    ast_manager* m2 = alloc(ast_manager);
+    reg_decl_plugins(*m1);
+    reg_decl_plugins(*m2);
+    {
+        expr_ref_vector fmls(*m1);
+        mk_terms(*m1, 10, 100, 0, fmls);
+        expr_ref_vector res(*m2);
+        ast_translation tr1(*m1, *m2);
+        tr1(fmls.size(), fmls.c_ptr(), res);
+        decl_translation_cache* c = decl_translation_cache::get(*m1, *m2);
+        unsigned sz = c->size();
+        ENSURE(sz > 0);
+        ast_translation tr2(*m1, *m2);
+        ENSURE(tr2(fmls.get(0)) == res.get(0));
+        ENSURE(c->size() == sz);
+        ENSURE(decl_translation_cache::get(*m2, *m1) != c);
+    }
+    if (delete_source_first) {
+        dealloc(m1);
+        dealloc(m2);
+    }
+    else {
+        dealloc(m2);
+        dealloc(m1);
+    }
+}
+
+static void tst_bench(unsigned num_vars, unsigned num_terms, unsigned num_copies) {
+    ast_manager m1;
+    reg_decl_plugins(m1);
+    expr_ref_vector fmls(m1);
+    mk_terms(m1, num_vars, num_terms, 1, fmls);
+    double single_time = 0, bulk_time = 0;
+    for (unsigned k = 0; k < num_copies; ++k) {
+        stopwatch sw;
+        {
+            ast_manager m2;
+            reg_decl_plugins(m2);
+            expr_ref_vector res(m2);
+            sw.start();
+            ast_translation tr(m1, m2);
+            for (unsigned j = 0; j < fmls.size(); ++j) {
+                res.push_back(tr(fmls.get(j)));
+            }
+            sw.stop();
+            single_time += sw.get_seconds();
+        }
+        sw.reset();
+        {
+            ast_manager m2;
+            reg_decl_plugins(m2);
+            expr_ref_vector res(m2);
+            sw.start();
+            ast_translation tr(m1, m2);
+            tr(fmls.size(), fmls.c_ptr(), res);
+            sw.stop();
+            bulk_time += sw.get_seconds();
+        }
+    }
+    std::cout << "terms: " << m1.get_num_asts() << " formulas: " << fmls.size()
+              << " single: " << single_time << " bulk: " << bulk_time << std::endl;
+}
+
+void tst_ast_translation() {
+    tst_bulk(5, 50, 0);
+    tst_bulk(20, 2000, 1);
+    tst_bulk(100, 20000, 2);
+    tst_recycled_ids();
+    tst_shared_decls(true);
+    tst_shared_decls(false);
+    tst_bench(200, 200000, 3);
+}
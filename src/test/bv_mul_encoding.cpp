@@ -0,0 +1,208 @@
+/*++
+Copyright (c) 2017 Microsoft Corporation
+
+Module Name:
+
+    bv_mul_encoding.cpp
+
+Abstract:
+
+    Multiplier encodings of the bit-blaster: array, Wallace tree,
+    Dadda tree and canonical signed digit constant multipliers.
+    The encodings are checked exhaustively on small widths, and
+    the CNF size and SAT solving time of each encoding is reported
+    on factoring and commutativity problems.
+
+--*/
+
+#include "ast/rewriter/bit_blaster/bit_blaster.h"
+#include "ast/rewriter/expr_safe_replace.h"
+#include "ast/rewriter/th_rewriter.h"
+#include "ast/reg_decl_plugins.h"
+#include "ast/bv_decl_plugin.h"
+#include "tactic/tactical.h"
+#include "tactic/bv/bit_blaster_tactic.h"
+#include "sat/tactic/sat_tactic.h"
+#include "util/stopwatch.h"
+#include "util/statistics.h"
+#include <sstream>
+
+enum mul_encoding { ENC_ARRAY, ENC_WALLACE, ENC_DADDA };
+
+static char const* encoding_names[3] = { "array", "wallace", "dadda" };
+
+static void mk_bool_vars(ast_manager& m, char const* prefix, unsigned sz, expr_ref_vector& r) {
+    for (unsigned i = 0; i < sz; ++i) {
+        std::stringstream strm;
+        strm << prefix << i;
+        r.push_back(m.mk_const(symbol(strm.str().c_str()), m.mk_bool_sort()));
+    }
+}
+
+static void bind_bits(ast_manager& m, expr_ref_vector const& vars, unsigned val, expr_safe_replace& sub) {
+    for (unsigned i = 0; i < vars.size(); ++i) {
+        sub.insert(vars[i], (val & (1u << i)) ? m.mk_true() : m.mk_false());
+    }
+}
+
+static unsigned eval_bits(ast_manager& m, expr_ref_vector const& bits, expr_safe_replace& sub) {
+    th_rewriter rw(m);
+    unsigned r = 0;
+    expr_ref tmp(m);
+    for (unsigned i = 0; i < bits.size(); ++i) {
+        sub(bits[i], tmp);
+        rw(tmp);
+        ENSURE(m.is_true(tmp) || m.is_false(tmp));
+        if (m.is_true(tmp)) r |= (1u << i);
+    }
+    return r;
+}
+
+static void tst_equiv(ast_manager& m, mul_encoding enc, unsigned sz) {
+    bit_blaster_params params;
+    bit_blaster blaster(m, params);
+    blaster.set_use_wtm(enc == ENC_WALLACE);
+    blaster.set_use_dtm(enc == ENC_DADDA);
+    expr_ref_vector a(m), b(m), out(m);
+    mk_bool_vars(m, "a", sz, a);
+    mk_bool_vars(m, "b", sz, b);
+    blaster.mk_multiplier(sz, a.c_ptr(), b.c_ptr(), out);
+    ENSURE(out.size() == sz);
+    unsigned mask = (1u << sz) - 1;
+    for (unsigned va = 0; va <= mask; ++va) {
+        for (unsigned vb = 0; vb <= mask; ++vb) {
+            expr_safe_replace sub(m);
+            bind_bits(m, a, va, sub);
+            bind_bits(m, b, vb, sub);
+            ENSURE(eval_bits(m, out, sub) == ((va * vb) & mask));
+        }
+    }
+}
+
+static void tst_const_equiv(ast_manager& m, unsigned sz) {
+    bit_blaster_params params;
+    bit_blaster blaster(m, params);
+    blaster.set_use_bcm(true);
+    expr_ref_vector b(m);
+    mk_bool_vars(m, "b", sz, b);
+    unsigned mask = (1u << sz) - 1;
+    for (unsigned c = 0; c <= mask; ++c) {
+        expr_ref_vector a(m), out(m);
+        for (unsigned i = 0; i < sz; ++i) {
+            a.push_back((c & (1u << i)) ? m.mk_true() : m.mk_false());
+        }
+        blaster.mk_multiplier(sz, a.c_ptr(), b.c_ptr(), out);
+        ENSURE(out.size() == sz);
+        for (unsigned vb = 0; vb <= mask; ++vb) {
+            expr_safe_replace sub(m);
+            bind_bits(m, b, vb, sub);
+            ENSURE(eval_bits(m, out, sub) == ((c * vb) & mask));
+        }
+    }
+}
+
+static unsigned get_stat(statistics const& st, char const* key) {
+    for (unsigned i = 0; i < st.size(); ++i) {
+        if (st.is_uint(i) && strcmp(st.get_key(i), key) == 0) {
+            return st.get_uint_value(i);
+        }
+    }
+    return 0;
+}
+
+static lbool bit_blast_and_solve(ast_manager& m, expr_ref_vector const& fmls, params_ref const& p, char const* name) {
+    goal_ref g = alloc(goal, m, true, false);
+    for (unsigned i = 0; i < fmls.size(); ++i) {
+        g->assert_expr(fmls[i]);
+    }
+    tactic_ref t = and_then(mk_bit_blaster_tactic(m, p), mk_sat_tactic(m));
+    goal_ref_buffer result;
+    model_converter_ref mc;
+    proof_converter_ref pc;
+    expr_dependency_ref core(m);
+    stopwatch sw;
+    sw.start();
+    (*t)(g, result, mc, pc, core);
+    sw.stop();
+    statistics st;
+    t->collect_statistics(st);
+    lbool r = l_undef;
+    if (is_decided_sat(result)) r = l_true;
+    if (is_decided_unsat(result)) r = l_false;
+    unsigned clauses = get_stat(st, "mk binary clause") + get_stat(st, "mk ternary clause") + get_stat(st, "mk clause");
+    std::cout << name << " " << r
+              << " vars: " << get_stat(st, "mk bool var")
+              << " clauses: " << clauses
+              << " time: " << sw.get_seconds() << std::endl;
+    return r;
+}
+
+static lbool solve_with_encodings(ast_manager& m, expr_ref_vector const& fmls) {
+    lbool r = l_undef;
+    for (unsigned enc = ENC_ARRAY; enc <= ENC_DADDA; ++enc) {
+        params_ref p;
+        p.set_sym("blast_mul_encoding", symbol(encoding_names[enc]));
+        lbool r1 = bit_blast_and_solve(m, fmls, p, encoding_names[enc]);
+        ENSURE(enc == ENC_ARRAY || r1 == r);
+        r = r1;
+    }
+    return r;
+}
+
+// x * y = p * q with 1 < x <= y < 2^(num_bits/2).
+static void tst_factor(ast_manager& m, unsigned num_bits, unsigned p, unsigned q) {
+    bv_util bv(m);
+    sort* s = bv.mk_sort(num_bits);
+    expr_ref_vector fmls(m);
+    expr* x = m.mk_const(symbol("x"), s);
+    expr* y = m.mk_const(symbol("y"), s);
+    fmls.push_back(m.mk_eq(bv.mk_bv_mul(x, y), bv.mk_numeral(rational(p) * rational(q), num_bits)));
+    fmls.push_back(m.mk_not(bv.mk_ule(x, bv.mk_numeral(1, num_bits))));
+    fmls.push_back(bv.mk_ule(x, y));
+    fmls.push_back(bv.mk_ule(y, bv.mk_numeral((1u << (num_bits / 2)) - 1, num_bits)));
+    std::cout << "factor " << num_bits << " bits: " << p << " * " << q << std::endl;
+    ENSURE(solve_with_encodings(m, fmls) == l_true);
+}
+
+// x * y != y * x
+static void tst_commute(ast_manager& m, unsigned num_bits) {
+    bv_util bv(m);
+    sort* s = bv.mk_sort(num_bits);
+    expr_ref_vector fmls(m);
+    expr* x = m.mk_const(symbol("x"), s);
+    expr* y = m.mk_const(symbol("y"), s);
+    fmls.push_back(m.mk_not(m.mk_eq(bv.mk_bv_mul(x, y), bv.mk_bv_mul(y, x))));
+    std::cout << "commute " << num_bits << " bits" << std::endl;
+    ENSURE(solve_with_encodings(m, fmls) == l_false);
+}
+
+// x * c = d with the constant multiplier enabled and disabled.
+static void tst_const(ast_manager& m, unsigned num_bits, unsigned c, unsigned d) {
+    bv_util bv(m);
+    sort* s = bv.mk_sort(num_bits);
+    expr_ref_vector fmls(m);
+    expr* x = m.mk_const(symbol("x"), s);
+    fmls.push_back(m.mk_eq(bv.mk_bv_mul(bv.mk_numeral(c, num_bits), x), bv.mk_numeral(d, num_bits)));
+    std::cout << "const " << num_bits << " bits: x * " << c << " = " << d << std::endl;
+    params_ref p;
+    lbool r1 = bit_blast_and_solve(m, fmls, p, "shift-add");
+    p.set_bool("blast_mul_const", true);
+    lbool r2 = bit_blast_and_solve(m, fmls, p, "csd      ");
+    ENSURE(r1 == r2);
+}
+
+void tst_bv_mul_encoding() {
+    ast_manager m;
+    reg_decl_plugins(m);
+    for (unsigned sz = 1; sz <= 5; ++sz) {
+        tst_equiv(m, ENC_ARRAY, sz);
+        tst_equiv(m, ENC_WALLACE, sz);
+        tst_equiv(m, ENC_DADDA, sz);
+        tst_const_equiv(m, sz);
+    }
+    tst_factor(m, 24, 4093, 4091);
+    tst_factor(m, 28, 16381, 16369);
+    tst_commute(m, 7);
+    tst_const(m, 32, 0x7ffffff1, 0x12345678);
+    tst_const(m, 32, 0xf0f0f0f1, 0xdeadbeef);
+}
@@ -0,0 +1,215 @@
+/*++
+Copyright (c) 2017 Microsoft Corporation
+
+Module Name:
+
+    grobner.cpp
+
+Abstract:
+
+    Compare pairwise superposition with F4-style batched reduction
+    in the grobner basis module on the cyclic-n and katsura-n systems
+    and on random quadratic systems.
+
+    When both engines finish within the threshold, the minimal
+    leading monomials of the two bases have to coincide.
+
+--*/
+
+#include "math/grobner/grobner.h"
+#include "ast/reg_decl_plugins.h"
+#include "util/stopwatch.h"
+#include <sstream>
+#include <algorithm>
+#include <vector>
+
+typedef vector<ptr_vector<expr> > monomials_t;
+
+struct grobner_system {
+    ast_manager&         m;
+    expr_ref_vector      m_vars;
+    vector<monomials_t>  m_monomials;
+    vector<vector<rational> > m_coeffs;
+
+    grobner_system(ast_manager& m, unsigned num_vars): m(m), m_vars(m) {
+        arith_util a(m);
+        for (unsigned i = 0; i < num_vars; ++i) {
+            std::stringstream strm;
+            strm << "x" << i;
+            m_vars.push_back(m.mk_const(symbol(strm.str().c_str()), a.mk_real()));
+        }
+    }
+
+    void new_poly() {
+        m_monomials.push_back(monomials_t());
+        m_coeffs.push_back(vector<rational>());
+    }
+
+    void add(rational const& c, unsigned num_vars, unsigned const* vars) {
+        ptr_vector<expr> vs;
+        for (unsigned i = 0; i < num_vars; ++i) {
+            vs.push_back(m_vars.get(vars[i]));
+        }
+        m_monomials.back().push_back(vs);
+        m_coeffs.back().push_back(c);
+    }
+
+    void assert_to(grobner& gb) {
+        for (unsigned i = 0; i < m_monomials.size(); ++i) {
+            ptr_buffer<grobner::monomial> ms;
+            for (unsigned j = 0; j < m_monomials[i].size(); ++j) {
+                ptr_vector<expr> const& vs = m_monomials[i][j];
+                ms.push_back(gb.mk_monomial(m_coeffs[i][j], vs.size(), vs.c_ptr()));
+            }
+            gb.assert_eq_0(ms.size(), ms.c_ptr());
+        }
+    }
+};
+
+static void mk_cyclic(grobner_system& s, unsigned n) {
+    unsigned_vector vs;
+    for (unsigned k = 1; k < n; ++k) {
+        s.new_poly();
+        for (unsigned i = 0; i < n; ++i) {
+            vs.reset();
+            for (unsigned j = 0; j < k; ++j) {
+                vs.push_back((i + j) % n);
+            }
+            s.add(rational(1), vs.size(), vs.c_ptr());
+        }
+    }
+    s.new_poly();
+    vs.reset();
+    for (unsigned i = 0; i < n; ++i) {
+        vs.push_back(i);
+    }
+    s.add(rational(1), vs.size(), vs.c_ptr());
+    s.add(rational(-1), 0, 0);
+}
+
+// variables u_0, .., u_n with u_{-i} = u_i and u_i = 0 for i > n.
+static void mk_katsura(grobner_system& s, unsigned n) {
+    int N = n;
+    for (int k = 0; k < N; ++k) {
+        s.new_poly();
+        for (int l = -N; l <= N; ++l) {
+            int i = l < 0 ? -l : l;
+            int j = k - l < 0 ? l - k : k - l;
+            if (j > N) continue;
+            unsigned vs[2] = { static_cast<unsigned>(i), static_cast<unsigned>(j) };
+            s.add(rational(1), 2, vs);
+        }
+        unsigned v = k;
+        s.add(rational(-1), 1, &v);
+    }
+    s.new_poly();
+    for (int l = -N; l <= N; ++l) {
+        unsigned v = l < 0 ? -l : l;
+        s.add(rational(1), 1, &v);
+    }
+    s.add(rational(-1), 0, 0);
+}
+
+static void mk_random(grobner_system& s, unsigned seed, unsigned num_vars, unsigned num_polys) {
+    random_gen rand(seed);
+    for (unsigned i = 0; i < num_polys; ++i) {
+        s.new_poly();
+        for (unsigned j = 0; j < 4; ++j) {
+            unsigned vs[2] = { rand(num_vars), rand(num_vars) };
+            int c = static_cast<int>(rand(7)) - 3;
+            s.add(rational(c == 0 ? 1 : c), rand(3), vs);
+        }
+    }
+}
+
+// leading monomials as sorted lists of variable ids.
+typedef std::vector<std::vector<unsigned> > leading_monomials_t;
+
+// leading monomials of gb that are not divisible by other leading monomials.
+static void min_leading_monomials(grobner& gb, leading_monomials_t& result) {
+    ptr_vector<grobner::equation> eqs;
+    gb.get_equations(eqs);
+    leading_monomials_t lts;
+    for (unsigned i = 0; i < eqs.size(); ++i) {
+        if (eqs[i]->get_num_monomials() == 0) continue;
+        grobner::monomial const* lt = eqs[i]->get_monomial(0);
+        std::vector<unsigned> vs;
+        for (unsigned j = 0; j < lt->get_degree(); ++j) {
+            vs.push_back(lt->get_var(j)->get_id());
+        }
+        std::sort(vs.begin(), vs.end());
+        lts.push_back(vs);
+    }
+    for (unsigned i = 0; i < lts.size(); ++i) {
+        bool is_min = true;
+        for (unsigned j = 0; is_min && j < lts.size(); ++j) {
+            if (i == j) continue;
+            bool divides = std::includes(lts[i].begin(), lts[i].end(), lts[j].begin(), lts[j].end());
+            // of two equal leading monomials keep the first.
+            is_min = !divides || (lts[i] == lts[j] && i < j);
+        }
+        if (is_min) {
+            result.push_back(lts[i]);
+        }
+    }
+    std::sort(result.begin(), result.end());
+}
+
+static bool run_grobner(grobner_system& s, char const* name, bool f4, unsigned threshold, leading_monomials_t& lts, bool& unsat) {
+    v_dependency_manager dm;
+    grobner gb(s.m, dm);
+    gb.set_f4(f4);
+    s.assert_to(gb);
+    stopwatch sw;
+    sw.start();
+    bool done = gb.compute_basis(threshold);
+    sw.stop();
+    min_leading_monomials(gb, lts);
+    unsat = gb.inconsistent();
+    std::cout << name << (f4 ? " f4       " : " pairwise ") << "done: " << done
+              << " inconsistent: " << unsat
+              << " basis: " << lts.size()
+              << " superpose: " << gb.m_stats.m_superpose
+              << " simplify: " << gb.m_stats.m_simplify
+              << " rows: " << gb.m_stats.m_f4_rows
+              << " reductions: " << gb.m_stats.m_f4_reductions
+              << " time: " << sw.get_seconds() << "\n";
+    return done;
+}
+
+static void tst_grobner(grobner_system& s, char const* name) {
+    leading_monomials_t lts1, lts2;
+    bool unsat1, unsat2;
+    bool done1 = run_grobner(s, name, false, 5000, lts1, unsat1);
+    bool done2 = run_grobner(s, name, true, 5000, lts2, unsat2);
+    if (done1 && done2) {
+        ENSURE(unsat1 == unsat2);
+        ENSURE(unsat1 || lts1 == lts2);
+    }
+}
+
+void tst_grobner() {
+    ast_manager m;
+    reg_decl_plugins(m);
+    for (unsigned n = 3; n <= 5; ++n) {
+        grobner_system s(m, n);
+        mk_cyclic(s, n);
+        std::stringstream strm;
+        strm << "cyclic-" << n;
+        tst_grobner(s, strm.str().c_str());
+    }
+    for (unsigned n = 2; n <= 4; ++n) {
+        grobner_system s(m, n + 1);
+        mk_katsura(s, n);
+        std::stringstream strm;
+        strm << "katsura-" << n;
+        tst_grobner(s, strm.str().c_str());
+    }
+    for (unsigned seed = 0; seed < 5; ++seed) {
+        grobner_system s(m, 5);
+        mk_random(s, seed, 5, 4);
+        std::stringstream strm;
+        strm << "random-" << seed;
+        tst_grobner(s, strm.str().c_str());
+    }
+}
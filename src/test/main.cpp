@@ -168,6 +168,7 @@ int main(int argc, char ** argv) {
     TST(simplifier);
     TST(bv_simplifier_plugin);
     TST(bit_blaster);
+    TST(bv_mul_encoding);
     TST(var_subst);
     TST(simple_parser);
     TST(api);
@@ -243,6 +244,17 @@ int main(int argc, char ** argv) {
     TST(get_consequences);
     TST(pb2bv);
     TST_ARGV(cnf_backbones);
+    TST(maxres);
+    TST(sls);
+    TST(sat_local_search);
+    TST(grobner);
+    TST(tactic2solver);
+    TST(solve_components);
+    TST(simplify_cache);
+    TST(aig);
+    TST(model_eval_program);
+    TST(solver_cube);
+    TST(ast_translation);
     //TST_ARGV(hs);
 }
 
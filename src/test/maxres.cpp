@@ -0,0 +1,117 @@
+/*++
+Copyright (c) 2017 Microsoft Corporation
+
+Module Name:
+
+    maxres.cpp
+
+Abstract:
+
+    Benchmark weight stratification and hardening in maxres
+    on random weighted MaxSAT instances in the style of the
+    MaxSAT evaluations: random 3-CNF hard clauses and unit soft
+    clauses whose weights span 1 to 10^9.
+
+--*/
+
+#include "opt/opt_context.h"
+#include "ast/reg_decl_plugins.h"
+#include "ast/ast_util.h"
+#include "util/stopwatch.h"
+#include "util/statistics.h"
+#include "util/util.h"
+#include <sstream>
+
+struct maxres_instance {
+    ast_manager&     m;
+    expr_ref_vector  m_vars;
+    expr_ref_vector  m_hard;
+    expr_ref_vector  m_soft;
+    vector<rational> m_weights;
+
+    maxres_instance(ast_manager& m, unsigned seed, unsigned num_vars, unsigned num_hard, unsigned num_soft):
+        m(m), m_vars(m), m_hard(m), m_soft(m) {
+        random_gen rand(seed);
+        for (unsigned i = 0; i < num_vars; ++i) {
+            std::stringstream strm;
+            strm << "x" << i;
+            m_vars.push_back(m.mk_const(symbol(strm.str().c_str()), m.mk_bool_sort()));
+        }
+        for (unsigned i = 0; i < num_hard; ++i) {
+            expr_ref_vector cls(m);
+            for (unsigned j = 0; j < 3; ++j) {
+                cls.push_back(lit(rand));
+            }
+            m_hard.push_back(mk_or(cls));
+        }
+        for (unsigned i = 0; i < num_soft; ++i) {
+            rational w = rational(1 + rand(9)) * power(rational(10), rand(9));
+            m_soft.push_back(lit(rand));
+            m_weights.push_back(w);
+        }
+    }
+
+    expr* lit(random_gen& rand) {
+        expr* v = m_vars[rand(m_vars.size())].get();
+        return rand(2) == 0 ? m.mk_not(v) : v;
+    }
+
+    rational cost(model* mdl) {
+        rational r(0);
+        expr_ref tmp(m);
+        for (unsigned i = 0; i < m_soft.size(); ++i) {
+            if (!mdl->eval(m_soft[i].get(), tmp, true) || !m.is_true(tmp)) {
+                r += m_weights[i];
+            }
+        }
+        return r;
+    }
+};
+
+static rational run_maxres(maxres_instance& inst, char const* name, bool stratify, bool hardening) {
+    ast_manager& m = inst.m;
+    params_ref p;
+    p.set_bool("maxres.stratify", stratify);
+    p.set_bool("maxres.hardening", hardening);
+    opt::context ctx(m);
+    ctx.updt_params(p);
+    for (unsigned i = 0; i < inst.m_hard.size(); ++i) {
+        ctx.add_hard_constraint(inst.m_hard[i].get());
+    }
+    for (unsigned i = 0; i < inst.m_soft.size(); ++i) {
+        ctx.add_soft_constraint(inst.m_soft[i].get(), inst.m_weights[i], symbol("soft"));
+    }
+    stopwatch sw;
+    sw.start();
+    lbool r = ctx.optimize();
+    sw.stop();
+    ENSURE(r == l_true);
+    model_ref mdl;
+    ctx.get_model(mdl);
+    rational c = inst.cost(mdl.get());
+    statistics st;
+    ctx.collect_statistics(st);
+    std::cout << name << " cost: " << c << " time: " << sw.get_seconds() << "\n";
+    st.display(std::cout);
+    return c;
+}
+
+static void tst_maxres(unsigned seed, unsigned num_vars, unsigned num_hard, unsigned num_soft) {
+    ast_manager m;
+    reg_decl_plugins(m);
+    maxres_instance inst(m, seed, num_vars, num_hard, num_soft);
+    rational c1 = run_maxres(inst, "baseline", false, false);
+    rational c2 = run_maxres(inst, "hardening", false, true);
+    rational c3 = run_maxres(inst, "stratify", true, false);
+    rational c4 = run_maxres(inst, "stratify+hardening", true, true);
+    ENSURE(c1 == c2);
+    ENSURE(c1 == c3);
+    ENSURE(c1 == c4);
+}
+
+void tst_maxres() {
+    for (unsigned seed = 0; seed < 4; ++seed) {
+        tst_maxres(seed, 40, 120, 60);
+    }
+    tst_maxres(11, 200, 700, 400);
+}
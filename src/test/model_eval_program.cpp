@@ -0,0 +1,357 @@
+/*++
+Copyright (c) 2017 Microsoft Corporation
+
+Module Name:
+
+    model_eval_program.cpp
+
+Abstract:
+
+    Compiled evaluation of a fixed set of expressions in many models.
+    The values computed by model_eval_program and Z3_model_eval_vector
+    have to coincide with the ones of model_evaluator, on complete and
+    partial models. The time of the compiled program is reported
+    against repeated model_evaluator calls.
+
+--*/
+
+#include "model/model_eval_program.h"
+#include "model/model_evaluator.h"
+#include "model/model.h"
+#include "ast/reg_decl_plugins.h"
+#include "ast/arith_decl_plugin.h"
+#include "ast/bv_decl_plugin.h"
+#include "ast/ast_pp.h"
+#include "api/z3.h"
+#include "util/stopwatch.h"
+#include "util/statistics.h"
+#include <sstream>
+
+static unsigned get_stat(statistics const& st, char const* key) {
+    for (unsigned i = 0; i < st.size(); ++i) {
+        if (st.is_uint(i) && strcmp(st.get_key(i), key) == 0) {
+            return st.get_uint_value(i);
+        }
+    }
+    return 0;
+}
+
+struct eval_problem {
+    ast_manager&     m;
+    arith_util       a;
+    bv_util          bv;
+    random_gen       rand;
+    expr_ref_vector  bvs, ints, bools;
+    func_decl_ref    f;
+    app_ref_vector   consts;
+    bool             div0;     // allow integer division by zero
+
+    eval_problem(ast_manager& m, unsigned seed, bool div0):
+        m(m), a(m), bv(m), rand(seed), bvs(m), ints(m), bools(m), f(m), consts(m), div0(div0) {
+        sort* s = bv.mk_sort(32);
+        for (unsigned i = 0; i < 8; ++i) {
+            consts.push_back(mk_const("x", i, s));
+            bvs.push_back(consts.back());
+        }
+        for (unsigned i = 0; i < 4; ++i) {
+            consts.push_back(mk_const("i", i, a.mk_int()));
+            ints.push_back(consts.back());
+        }
+        for (unsigned i = 0; i < 4; ++i) {
+            consts.push_back(mk_const("p", i, m.mk_bool_sort()));
+            bools.push_back(consts.back());
+        }
+        f = m.mk_func_decl(symbol("f"), s, s);
+    }
+
+    app* mk_const(char const* prefix, unsigned i, sort* s) {
+        std::stringstream strm;
+        strm << prefix << i;
+        return m.mk_const(symbol(strm.str().c_str()), s);
+    }
+
+    expr* pick(expr_ref_vector const& v) {
+        // prefer recent terms to get deep shared terms.
+        unsigned n = v.size();
+        unsigned k = rand(2) == 0 ? rand(n) : n - 1 - rand(std::min(n, 16u));
+        return v.get(k);
+    }
+
+    expr* bv_num() {
+        switch (rand(3)) {
+        case 0: return bv.mk_numeral(rand(40), 32);
+        case 1: return bv.mk_numeral(rational(rand()) * rational(rand()), 32);
+        default: return bv.mk_numeral(rational::power_of_two(32) - rational(1 + rand(4)), 32);
+        }
+    }
+
+    void mk_bv() {
+        expr* x = pick(bvs);
+        expr* y = rand(4) == 0 ? bv_num() : pick(bvs);
+        family_id fid = bv.get_fid();
+        expr* args[2] = { x, y };
+        parameter p(3);
+        expr_ref r(m);
+        switch (rand(20)) {
+        case 0:  r = bv.mk_bv_add(x, y); break;
+        case 1:  r = bv.mk_bv_sub(x, y); break;
+        case 2:  r = bv.mk_bv_mul(x, y); break;
+        case 3:  r = bv.mk_bv_neg(x); break;
+        case 4:  r = m.mk_app(fid, OP_BAND, x, y); break;
+        case 5:  r = bv.mk_bv_or(2, args); break;
+        case 6:  r = bv.mk_bv_xor(2, args); break;
+        case 7:  r = bv.mk_bv_not(x); break;
+        case 8:  r = m.mk_app(fid, OP_BUDIV, x, y); break;
+        case 9:  r = bv.mk_bv_urem(x, y); break;
+        case 10: r = bv.mk_bv_shl(x, m.mk_app(fid, OP_BAND, y, bv.mk_numeral(63, 32))); break;
+        case 11: r = bv.mk_bv_lshr(x, m.mk_app(fid, OP_BAND, y, bv.mk_numeral(63, 32))); break;
+        case 12: r = bv.mk_bv_ashr(x, m.mk_app(fid, OP_BAND, y, bv.mk_numeral(63, 32))); break;
+        case 13: r = bv.mk_extract(47, 16, bv.mk_concat(x, y)); break;
+        case 14: r = bv.mk_zero_extend(16, bv.mk_extract(15, 0, x)); break;
+        case 15: r = bv.mk_sign_extend(16, bv.mk_extract(23, 8, x)); break;
+        case 16: r = m.mk_ite(pick(bools), x, y); break;
+        case 17: r = m.mk_app(fid, OP_BSDIV, x, y); break;
+        case 18: r = m.mk_app(f, x); break;
+        default: r = m.mk_app(fid, OP_ROTATE_LEFT, 1, &p, 1, &x); break;
+        }
+        bvs.push_back(r);
+    }
+
+    void mk_int() {
+        expr* x = pick(ints);
+        expr* y = rand(4) == 0 ? a.mk_int(rand(7)) : pick(ints);
+        // integer division by zero is uninterpreted, it leaves the terms above it without value.
+        expr* d = div0 ? y : a.mk_add(m.mk_app(a.get_family_id(), OP_ABS, y), a.mk_int(1));
+        expr_ref r(m);
+        switch (rand(8)) {
+        case 0: r = a.mk_add(x, y); break;
+        case 1: r = a.mk_sub(x, y); break;
+        case 2: r = a.mk_mod(a.mk_mul(x, y), a.mk_int(1000003)); break;
+        case 3: r = a.mk_idiv(x, d); break;
+        case 4: r = a.mk_mod(x, d); break;
+        case 5: r = m.mk_app(a.get_family_id(), OP_ABS, x); break;
+        case 6: r = a.mk_to_int(a.mk_div(a.mk_to_real(x), a.mk_real(3))); break;
+        default: r = bv.mk_bv2int(pick(bvs)); break;
+        }
+        ints.push_back(r);
+    }
+
+    void mk_bool() {
+        expr* x = pick(bvs);
+        expr* y = pick(bvs);
+        expr* p = pick(bools);
+        expr* q = pick(bools);
+        family_id fid = bv.get_fid();
+        expr_ref r(m);
+        switch (rand(14)) {
+        case 0:  r = bv.mk_ule(x, y); break;
+        case 1:  r = bv.mk_sle(x, y); break;
+        case 2:  r = m.mk_app(fid, OP_ULT, x, y); break;
+        case 3:  r = m.mk_app(fid, OP_SGT, x, y); break;
+        case 4:  r = m.mk_eq(x, y); break;
+        case 5:  r = m.mk_not(p); break;
+        case 6:  r = m.mk_and(p, q, pick(bools)); break;
+        case 7:  r = m.mk_or(p, q); break;
+        case 8:  r = m.mk_xor(p, q); break;
+        case 9:  r = m.mk_implies(p, q); break;
+        case 10: r = m.mk_ite(p, q, pick(bools)); break;
+        case 11: { expr* args[3] = { x, y, pick(bvs) }; r = m.mk_distinct(3, args); break; }
+        case 12: r = a.mk_le(pick(ints), pick(ints)); break;
+        default: r = a.mk_gt(pick(ints), a.mk_int(rand(100))); break;
+        }
+        bools.push_back(r);
+    }
+
+    void mk_terms(unsigned n) {
+        for (unsigned i = 0; i < n; ++i) {
+            switch (rand(3)) {
+            case 0: mk_bv(); break;
+            case 1: mk_int(); break;
+            default: mk_bool(); break;
+            }
+        }
+    }
+
+    void get_terms(expr_ref_vector& r) {
+        r.append(bvs);
+        r.append(ints);
+        r.append(bools);
+    }
+
+    // assign each constant with probability 1/(1 + missing)
+    model* mk_model(unsigned missing) {
+        model* md = alloc(model, m);
+        for (app* c : consts) {
+            if (rand(1 + missing) != 0) continue;
+            expr_ref v(m);
+            if (bv.is_bv(c)) v = bv_num();
+            else if (a.is_int(c)) v = a.mk_int(static_cast<int>(rand(41)) - 20);
+            else v = rand(2) == 0 ? m.mk_true() : m.mk_false();
+            md->register_decl(c->get_decl(), v);
+        }
+        if (rand(1 + missing) == 0) {
+            func_interp* fi = alloc(func_interp, m, 1);
+            for (unsigned i = 0; i < 4; ++i) {
+                expr* arg = bv.mk_numeral(i, 32);
+                fi->insert_entry(&arg, bv_num());
+            }
+            fi->set_else(bv_num());
+            md->register_decl(f, fi);
+        }
+        return md;
+    }
+};
+
+static void check_equal(expr_ref_vector const& terms, model& md, bool completion, expr_ref_vector const& vals) {
+    ast_manager& m = terms.get_manager();
+    model_evaluator ev(md);
+    ev.set_model_completion(completion);
+    ENSURE(vals.size() == terms.size());
+    expr_ref v(m);
+    for (unsigned i = 0; i < terms.size(); ++i) {
+        ev(terms[i], v);
+        if (v != vals[i]) {
+            std::cout << mk_pp(terms[i], m) << "\n" << v << "\n" << mk_pp(vals[i], m) << std::endl;
+        }
+        ENSURE(v == vals[i]);
+    }
+}
+
+static void tst_equiv(unsigned seed, unsigned num_terms, unsigned num_models, unsigned missing, bool completion) {
+    ast_manager m;
+    reg_decl_plugins(m);
+    eval_problem p(m, seed, true);
+    p.mk_terms(num_terms);
+    expr_ref_vector terms(m), vals(m);
+    p.get_terms(terms);
+    model_eval_program prog(m, terms.size(), terms.c_ptr());
+    prog.set_model_completion(completion);
+    for (unsigned k = 0; k < num_models; ++k) {
+        model_ref md = p.mk_model(missing);
+        prog(*md, vals);
+        check_equal(terms, *md, completion, vals);
+    }
+    // batch evaluation
+    ptr_vector<model_core> mds;
+    vector<model_ref> refs;
+    for (unsigned k = 0; k < 4; ++k) {
+        refs.push_back(model_ref(p.mk_model(missing)));
+        mds.push_back(refs.back().get());
+    }
+    prog(mds.size(), mds.c_ptr(), vals);
+    ENSURE(vals.size() == 4 * terms.size());
+    for (unsigned k = 0; k < 4; ++k) {
+        expr_ref_vector vk(m);
+        vk.append(terms.size(), vals.c_ptr() + k * terms.size());
+        check_equal(terms, *refs[k], completion, vk);
+    }
+    statistics st;
+    prog.collect_statistics(st);
+    std::cout << "terms: " << terms.size() << " missing: " << missing << " completion: " << completion
+              << " instructions: " << get_stat(st, "eval program instructions")
+              << " native: " << get_stat(st, "eval program native")
+              << " evaluator calls: " << get_stat(st, "eval program evaluator calls") << std::endl;
+}
+
+static void tst_bench(unsigned num_terms, unsigned num_models) {
+    ast_manager m;
+    reg_decl_plugins(m);
+    eval_problem p(m, 17, false);
+    p.mk_terms(num_terms);
+    expr_ref_vector terms(m), vals(m);
+    p.get_terms(terms);
+    vector<model_ref> mds;
+    for (unsigned k = 0; k < num_models; ++k) {
+        mds.push_back(model_ref(p.mk_model(0)));
+    }
+    expr_ref v(m);
+    stopwatch sw;
+
+    // one model::eval per expression, as Z3_model_eval does, on a few models.
+    unsigned num_eval_models = std::min(num_models, 10u);
+    sw.start();
+    for (unsigned k = 0; k < num_eval_models; ++k) {
+        for (unsigned i = 0; i < terms.size(); ++i) {
+            mds[k]->eval(terms.get(i), v, true);
+        }
+    }
+    sw.stop();
+    double t1 = sw.get_seconds() / num_eval_models;
+
+    // one model_evaluator per model.
+    sw.reset();
+    sw.start();
+    for (unsigned k = 0; k < num_models; ++k) {
+        model_evaluator ev(*mds[k]);
+        ev.set_model_completion(true);
+        for (unsigned i = 0; i < terms.size(); ++i) {
+            ev(terms.get(i), v);
+        }
+    }
+    sw.stop();
+    double t2 = sw.get_seconds() / num_models;
+
+    sw.reset();
+    sw.start();
+    model_eval_program prog(m, terms.size(), terms.c_ptr());
+    prog.set_model_completion(true);
+    for (unsigned k = 0; k < num_models; ++k) {
+        prog(*mds[k], vals);
+    }
+    sw.stop();
+    double t3 = sw.get_seconds() / num_models;
+    statistics st;
+    prog.collect_statistics(st);
+    std::cout << "terms: " << terms.size() << " models: " << num_models
+              << " time per model, model::eval: " << t1 << " model_evaluator: " << t2 << " program: " << t3
+              << " evaluator calls: " << get_stat(st, "eval program evaluator calls") << std::endl;
+}
+
+static void tst_api() {
+    Z3_config cfg = Z3_mk_config();
+    Z3_context ctx = Z3_mk_context(cfg);
+    Z3_del_config(cfg);
+    Z3_sort bv = Z3_mk_bv_sort(ctx, 8);
+    Z3_ast x = Z3_mk_const(ctx, Z3_mk_string_symbol(ctx, "x"), bv);
+    Z3_ast y = Z3_mk_const(ctx, Z3_mk_string_symbol(ctx, "y"), bv);
+    Z3_ast_vector es = Z3_mk_ast_vector(ctx);
+    Z3_ast_vector_inc_ref(ctx, es);
+    Z3_ast_vector_push(ctx, es, Z3_mk_bvmul(ctx, x, Z3_mk_bvadd(ctx, x, y)));
+    Z3_ast_vector_push(ctx, es, Z3_mk_bvult(ctx, x, y));
+    Z3_ast_vector_push(ctx, es, Z3_mk_bvudiv(ctx, y, x));
+    for (unsigned k = 0; k < 20; ++k) {
+        Z3_model mdl = Z3_mk_model(ctx);
+        Z3_model_inc_ref(ctx, mdl);
+        Z3_add_const_interp(ctx, mdl, Z3_get_app_decl(ctx, Z3_to_app(ctx, x)), Z3_mk_unsigned_int(ctx, 13 * k, bv));
+        if (k % 2 == 0) {
+            Z3_add_const_interp(ctx, mdl, Z3_get_app_decl(ctx, Z3_to_app(ctx, y)), Z3_mk_unsigned_int(ctx, 7 * k + 1, bv));
+        }
+        if (k == 10) {
+            // the program is compiled again for the new contents.
+            Z3_ast_vector_set(ctx, es, 0, Z3_mk_bvsub(ctx, x, y));
+        }
+        for (unsigned c = 0; c < 2; ++c) {
+            Z3_ast_vector vals = Z3_model_eval_vector(ctx, mdl, es, c == 1);
+            Z3_ast_vector_inc_ref(ctx, vals);
+            ENSURE(Z3_ast_vector_size(ctx, vals) == Z3_ast_vector_size(ctx, es));
+            for (unsigned i = 0; i < Z3_ast_vector_size(ctx, es); ++i) {
+                Z3_ast v = 0;
+                ENSURE(Z3_model_eval(ctx, mdl, Z3_ast_vector_get(ctx, es, i), c == 1, &v));
+                ENSURE(Z3_is_eq_ast(ctx, v, Z3_ast_vector_get(ctx, vals, i)));
+            }
+            Z3_ast_vector_dec_ref(ctx, vals);
+        }
+        Z3_model_dec_ref(ctx, mdl);
+    }
+    Z3_ast_vector_dec_ref(ctx, es);
+    Z3_del_context(ctx);
+}
+
+void tst_model_eval_program() {
+    tst_equiv(1, 300, 50, 0, true);
+    tst_equiv(2, 300, 50, 2, true);
+    tst_equiv(3, 300, 50, 2, false);
+    tst_equiv(4, 2000, 20, 1, false);
+    tst_api();
+    tst_bench(2000, 200);
+}
@@ -387,6 +387,72 @@ static void tst6() {
     
 }
 
+static void project_threads(nlsat::solver& s, nlsat::explain& ex, nlsat::var x, unsigned num, nlsat::literal const* lits) {
+    nlsat::scoped_literal_vector r1(s), r4(s);
+    ex.set_num_threads(1);
+    ex.project(x, num, lits, r1);
+    ex.set_num_threads(4);
+    ex.project(x, num, lits, r4);
+    ex.set_num_threads(1);
+    s.display(std::cout << "threads: 1 ==> ", r1.size(), r1.c_ptr());
+    s.display(std::cout << "\nthreads: 4 ==> ", r4.size(), r4.c_ptr());
+    std::cout << "\n";
+    ENSURE(r1.size() == r4.size());
+    for (unsigned i = 0; i < r1.size(); ++i) {
+        ENSURE(r1[i] == r4[i]);
+    }
+}
+
+static void tst_project_threads() {
+    params_ref      ps;
+    reslimit        rlim;
+    nlsat::solver s(rlim, ps);
+    anum_manager & am     = s.am();
+    nlsat::pmanager & pm  = s.pm();
+    nlsat::assignment as(am);
+    nlsat::explain& ex    = s.get_explain();
+    nlsat::var x0, x1, x2, a, b, c, d;
+    a  = s.mk_var(false);
+    b  = s.mk_var(false);
+    c  = s.mk_var(false);
+    d  = s.mk_var(false);
+    x0 = s.mk_var(false);
+    x1 = s.mk_var(false);
+    x2 = s.mk_var(false);
+
+    polynomial_ref _x0(pm), _x1(pm), _x2(pm);
+    polynomial_ref _a(pm), _b(pm), _c(pm), _d(pm);
+    _x0 = pm.mk_polynomial(x0);
+    _x1 = pm.mk_polynomial(x1);
+    _x2 = pm.mk_polynomial(x2);
+    _a  = pm.mk_polynomial(a);
+    _b  = pm.mk_polynomial(b);
+    _c  = pm.mk_polynomial(c);
+    _d  = pm.mk_polynomial(d);
+
+    nlsat::scoped_literal_vector lits(s);
+    lits.push_back(mk_gt(s, (_a*(_x0^2)) + _x2 + 2));
+    lits.push_back(mk_gt(s, (_b*_x1) - (2*_x2) - _x0 + 8));
+    lits.push_back(mk_gt(s, (_c*_x0) + _x2 + 1));
+    lits.push_back(mk_gt(s, (_d*_x0) - _x1 + 5*_x2));
+
+    scoped_anum one(am), two(am);
+    am.set(one, 1);
+    am.set(two, 2);
+    as.set(a,  one);
+    as.set(b,  one);
+    as.set(c,  two);
+    as.set(d,  two);
+    as.set(x0, two);
+    as.set(x1, one);
+    as.set(x2, one);
+    s.set_rvalues(as);
+
+    project_threads(s, ex, x2, 4, lits.c_ptr());
+    project_threads(s, ex, x2, 3, lits.c_ptr()+1);
+    project_threads(s, ex, x1, 3, lits.c_ptr());
+}
+
 static void tst7() {
     params_ref      ps;
     reslimit        rlim;
@@ -696,6 +762,8 @@ static void tst10() {
 }
 
 void tst_nlsat() {
+    tst_project_threads();
+    std::cout << "------------------\n"; exit(0);
     tst10();
     std::cout << "------------------\n";
     exit(0);
@@ -22,6 +22,7 @@ Notes:
 #include "math/polynomial/polynomial_cache.h"
 #include "math/polynomial/linear_eq_solver.h"
 #include "util/rlimit.h"
+#include "util/stopwatch.h"
 
 static void tst1() {
     std::cout << "\n----- Basic testing -------\n";
@@ -834,6 +835,70 @@ static void tst_psc() {
 #endif
 }
 
+static polynomial_ref mk_random_poly(polynomial::manager & m, random_gen & r, polynomial_ref_vector const & xs,
+                                     unsigned deg, unsigned num_monomials, unsigned coeff_bits) {
+    polynomial_ref p(m), mon(m);
+    p = m.mk_zero();
+    for (unsigned i = 0; i < num_monomials; i++) {
+        rational c(0);
+        for (unsigned b = 0; b < coeff_bits; b += 15)
+            c = c * rational(32768) + rational(r());
+        if (r(2) == 0)
+            c.neg();
+        mon = m.mk_const(c);
+        for (unsigned j = 0; j < xs.size(); j++) {
+            unsigned k = r(deg + 1);
+            for (unsigned l = 0; l < k; l++)
+                mon = mon * polynomial_ref(xs.get(j), m);
+        }
+        p = p + mon;
+    }
+    return p;
+}
+
+static void tst_modular_psc(unsigned seed, unsigned deg, unsigned coeff_bits) {
+    reslimit rl;
+    polynomial::numeral_manager nm;
+    polynomial::manager m(rl, nm);
+    random_gen r(seed);
+    polynomial_ref_vector xs(m);
+    for (unsigned i = 0; i < 3; i++)
+        xs.push_back(m.mk_polynomial(m.mk_var()));
+    polynomial_ref p(m), q(m), r1(m), r2(m);
+    p = mk_random_poly(m, r, xs, deg, 6, coeff_bits);
+    q = mk_random_poly(m, r, xs, deg, 6, coeff_bits);
+    polynomial::var x = 2;
+    if (degree(p, x) == 0 || degree(q, x) == 0)
+        return;
+    polynomial_ref_vector S1(m), S2(m);
+    stopwatch sw1, sw2;
+    sw1.start();
+    m.set_modular_psc(false);
+    m.psc_chain(p, q, x, S1);
+    r1 = resultant(p, q, x);
+    sw1.stop();
+    sw2.start();
+    m.set_modular_psc(true);
+    m.psc_chain(p, q, x, S2);
+    r2 = resultant(p, q, x);
+    sw2.stop();
+    std::cout << "deg: " << deg << " coeff bits: " << coeff_bits << " psc: " << S1.size()
+              << " prs: " << sw1.get_seconds() << " modular: " << sw2.get_seconds() << std::endl;
+    ENSURE(m.eq(r1, r2));
+    ENSURE(S1.size() == S2.size());
+    for (unsigned i = 0; i < S1.size(); i++) {
+        ENSURE(m.eq(S1.get(i), S2.get(i)));
+    }
+}
+
+static void tst_modular_psc() {
+    for (unsigned seed = 0; seed < 10; seed++) {
+        tst_modular_psc(seed, 2, 15);
+        tst_modular_psc(seed, 3, 60);
+        tst_modular_psc(seed, 4, 120);
+    }
+}
+
 static void tst_vars(polynomial_ref const & p, unsigned sz, polynomial::var * xs) {
     polynomial::var_vector r;
     p.m().vars(p, r);
@@ -1822,6 +1887,7 @@ void tst_polynomial() {
     // enable_trace("eval_bug");
     // enable_trace("mgcd");
     tst_psc();
+    tst_modular_psc();
     return;
     tst_eval();
     tst_divides();
@@ -454,6 +454,68 @@ static void tst11(bool use_ints) {
 }
 
 
+static rational random_small_rational(bool use_ints) {
+    static int const edges[6] = { INT_MAX, INT_MIN, INT_MAX - 1, INT_MIN + 1, 1 << 30, 46341 };
+    int r1 = rand() % 8 == 0 ? edges[rand() % 6] : rand() % MAGNITUDE;
+    int r2 = use_ints ? 1 : (rand() % 8 == 0 ? INT_MAX - rand() % 3 : rand() % MAGNITUDE);
+    if (r2 == 0) r2 = 1;
+    if (rand() % 2 == 0 && r1 != INT_MIN) r1 = -r1;
+    return rational(r1, r2);
+}
+
+// Operations on rationals whose numerators and denominators fit in
+// machine integers, against the same operations on scaled operands
+// that are too large for machine integers.
+static void tst12(bool use_ints) {
+    rational K = power(rational(2), 40);
+    for (unsigned i = 0; i < 100000; ++i) {
+        rational a = random_small_rational(use_ints);
+        rational b = random_small_rational(use_ints);
+        rational aK = a * K, bK = b * K;
+        ENSURE(a + b == (aK + bK) / K);
+        ENSURE(a - b == (aK - bK) / K);
+        ENSURE(a * b == (aK * bK) / (K * K));
+        ENSURE((a < b) == (aK < bK));
+        ENSURE((a == b) == (aK == bK));
+        rational c(a);
+        c.addmul(b, a);
+        ENSURE(c == (aK + bK * a) / K);
+    }
+    std::cout << "Testing performance of small " << (use_ints ? "ints\n" : "rationals\n");
+    vector<rational> vals;
+    vector<rational> vals2;
+    vals.resize(NUM_RATIONALS);
+    vals2.resize(NUM_RATIONALS);
+    for (unsigned i = 0; i < NUM_RATIONALS; i++) {
+        int r1 = rand() % MAGNITUDE;
+        int r2 = use_ints ? 1 : rand() % MAGNITUDE;
+        if (r2 == 0) r2 = 1;
+        if (rand() % 2 == 0) r1 = -r1;
+        vals[i] = rational(r1, r2);
+    }
+    {
+        timeit t(true, "addition");
+        for (unsigned i = 0; i < NUM_RATIONALS - 1; i++) {
+            vals2[i] = vals[i] + vals[i+1];
+        }
+    }
+    {
+        timeit t(true, "multiplication");
+        for (unsigned i = 0; i < NUM_RATIONALS - 1; i++) {
+            vals2[i] = vals[i] * vals[i+1];
+        }
+    }
+    {
+        timeit t(true, "comparison");
+        unsigned num_lt = 0;
+        for (unsigned i = 0; i < NUM_RATIONALS - 1; i++) {
+            if (vals[i] < vals[i+1]) num_lt++;
+        }
+        std::cout << num_lt << " ";
+    }
+    std::cout << "\n";
+}
+
 void tst_rational() {
     TRACE("rational", tout << "starting rational test...\n";);
     std::cout << "sizeof(rational): " << sizeof(rational) << "\n";
@@ -478,4 +540,6 @@ void tst_rational() {
     tst11(true);
     tst10(true);
     tst10(false);
+    tst12(true);
+    tst12(false);
 }
@@ -0,0 +1,80 @@
+/*++
+Copyright (c) 2017 Microsoft Corporation
+
+Module Name:
+
+    sat_local_search.cpp
+
+Abstract:
+
+    Solve random 3-SAT instances near the threshold with and without
+    local search seeding the saved phases, check that both agree,
+    and report how often local search finds the model.
+
+--*/
+
+#include "sat/sat_solver.h"
+#include "util/util.h"
+#include "util/stopwatch.h"
+#include "util/statistics.h"
+
+typedef vector<sat::literal_vector> clauses_t;
+
+static void mk_random_3sat(random_gen& r, unsigned num_vars, unsigned num_clauses, clauses_t& clauses) {
+    for (unsigned i = 0; i < num_clauses; ++i) {
+        sat::literal_vector cls;
+        while (cls.size() < 3) {
+            sat::literal l(r(num_vars), r(2) == 0);
+            if (!cls.contains(l) && !cls.contains(~l)) {
+                cls.push_back(l);
+            }
+        }
+        clauses.push_back(cls);
+    }
+}
+
+static lbool run_sat(unsigned num_vars, clauses_t const& clauses, bool local_search) {
+    params_ref p;
+    p.set_bool("local_search", local_search);
+    p.set_uint("burst_search", 10);
+    reslimit rlim;
+    sat::solver s(p, rlim, 0);
+    for (unsigned i = 0; i < num_vars; ++i) {
+        s.mk_var();
+    }
+    for (unsigned i = 0; i < clauses.size(); ++i) {
+        s.mk_clause(clauses[i].size(), clauses[i].c_ptr());
+    }
+    stopwatch sw;
+    sw.start();
+    lbool r = s.check();
+    sw.stop();
+    if (r == l_true) {
+        sat::model const& mdl = s.get_model();
+        for (unsigned i = 0; i < clauses.size(); ++i) {
+            bool sat = false;
+            for (unsigned j = 0; j < clauses[i].size(); ++j) {
+                sat |= value_at(clauses[i][j], mdl) == l_true;
+            }
+            ENSURE(sat);
+        }
+    }
+    statistics st;
+    s.collect_statistics(st);
+    std::cout << (local_search ? "local search " : "cdcl         ") << r
+              << " time: " << sw.get_seconds() << "\n";
+    st.display(std::cout);
+    return r;
+}
+
+void tst_sat_local_search() {
+    random_gen r(0);
+    unsigned num_vars = 400;
+    for (unsigned i = 0; i < 6; ++i) {
+        clauses_t clauses;
+        mk_random_3sat(r, num_vars, num_vars * 42 / 10, clauses);
+        lbool r1 = run_sat(num_vars, clauses, false);
+        lbool r2 = run_sat(num_vars, clauses, true);
+        ENSURE(r1 == r2);
+    }
+}
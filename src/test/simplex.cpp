@@ -12,6 +12,8 @@ Copyright (c) 2015 Microsoft Corporation
 #include "util/vector.h"
 #include "util/rational.h"
 #include "util/rlimit.h"
+#include "util/stopwatch.h"
+#include "util/statistics.h"
 
 #define R rational
 typedef simplex::simplex<simplex::mpz_ext> Simplex;
@@ -132,6 +134,82 @@ static void test4() {
     feas(S);
 }
 
+static unsigned get_stat(statistics const& st, char const* key) {
+    for (unsigned i = 0; i < st.size(); ++i) {
+        if (st.is_uint(i) && strcmp(st.get_key(i), key) == 0) {
+            return st.get_uint_value(i);
+        }
+    }
+    return 0;
+}
+
+// Pivot throughput on random sparse rows with small coefficients.
+// Each row defines a base variable as a combination of row_size
+// of num_vars non-basic variables; all variables are bounded.
+static void tst_pivots(unsigned seed, unsigned num_rows, unsigned num_vars, unsigned row_size) {
+    reslimit rl; Simplex S(rl);
+    unsynch_mpz_manager m;
+    unsynch_mpq_inf_manager em;
+    random_gen rand(seed);
+    vector<unsigned_vector> row_vars;
+    vector<svector<int> > row_coeffs;
+    for (unsigned v = 0; v < num_vars + num_rows; ++v) {
+        S.ensure_var(v);
+        int bound = v < num_vars ? 20 : 1 + static_cast<int>(rand(4));
+        int lo = v < num_vars ? -10 : static_cast<int>(rand(41)) - 20;
+        _scoped_numeral<unsynch_mpq_inf_manager> b(em);
+        em.set(b, mpq(lo), mpq(0));
+        S.set_lower(v, b);
+        em.set(b, mpq(lo + bound), mpq(0));
+        S.set_upper(v, b);
+    }
+    for (unsigned i = 0; i < num_rows; ++i) {
+        unsigned base = num_vars + i;
+        unsigned_vector vars;
+        svector<int> coeffs;
+        scoped_mpz_vector mcoeffs(m);
+        for (unsigned j = 0; j < row_size; ++j) {
+            unsigned v = rand(num_vars);
+            if (vars.contains(v)) continue;
+            int c = static_cast<int>(rand(7)) - 3;
+            vars.push_back(v);
+            coeffs.push_back(c == 0 ? 1 : c);
+            mcoeffs.push_back(mpz(coeffs.back()));
+        }
+        vars.push_back(base);
+        coeffs.push_back(-1);
+        mcoeffs.push_back(mpz(-1));
+        S.add_row(base, vars.size(), vars.c_ptr(), mcoeffs.c_ptr());
+        row_vars.push_back(vars);
+        row_coeffs.push_back(coeffs);
+    }
+    stopwatch sw;
+    sw.start();
+    lbool is_sat = S.make_feasible();
+    sw.stop();
+    statistics st;
+    S.collect_statistics(st);
+    unsigned pivots = get_stat(st, "simplex num pivots");
+    std::cout << "rows: " << num_rows << " vars: " << num_vars << " feasible: " << is_sat
+              << " pivots: " << pivots << " time: " << sw.get_seconds()
+              << " pivots/sec: " << (pivots / std::max(sw.get_seconds(), 0.001)) << "\n";
+    if (is_sat != l_true) {
+        return;
+    }
+    // the original rows hold at the solution, and all bounds are respected.
+    for (unsigned i = 0; i < row_vars.size(); ++i) {
+        _scoped_numeral<unsynch_mpq_inf_manager> sum(em), t(em);
+        for (unsigned j = 0; j < row_vars[i].size(); ++j) {
+            em.mul(S.get_value(row_vars[i][j]), mpz(row_coeffs[i][j]), t);
+            em.add(sum, t, sum);
+        }
+        ENSURE(em.is_zero(sum));
+    }
+    for (unsigned v = 0; v < num_vars + num_rows; ++v) {
+        ENSURE(!S.below_lower(v) && !S.above_upper(v));
+    }
+}
+
 void tst_simplex() {
     reslimit rl; Simplex S(rl);
 
@@ -167,4 +245,9 @@ void tst_simplex() {
     test2();
     test3();
     test4();
+
+    for (unsigned seed = 0; seed < 3; ++seed) {
+        tst_pivots(seed, 30, 45, 4);
+    }
+    tst_pivots(3, 60, 90, 4);
 }
@@ -0,0 +1,116 @@
+/*++
+Copyright (c) 2017 Microsoft Corporation
+
+Module Name:
+
+    simplify_cache.cpp
+
+Abstract:
+
+    Z3_simplify on formulas that share a large bit-vector term,
+    with and without the persistent simplifier cache. The results
+    have to coincide, and the cache has to be hit across calls and
+    flushed when it grows beyond rewriter.persistent_cache_max_size.
+
+--*/
+
+#include "api/z3.h"
+#include "util/util.h"
+#include "util/stopwatch.h"
+#include <iostream>
+#include <cstring>
+
+static unsigned get_stat(Z3_context ctx, Z3_stats st, char const* key) {
+    for (unsigned i = 0; i < Z3_stats_size(ctx, st); ++i) {
+        if (Z3_stats_is_uint(ctx, st, i) && strcmp(Z3_stats_get_key(ctx, st, i), key) == 0) {
+            return Z3_stats_get_uint_value(ctx, st, i);
+        }
+    }
+    return 0;
+}
+
+static Z3_ast mk_shared_term(Z3_context ctx, Z3_sort bv, unsigned depth) {
+    Z3_ast x = Z3_mk_const(ctx, Z3_mk_string_symbol(ctx, "x"), bv);
+    Z3_ast y = Z3_mk_const(ctx, Z3_mk_string_symbol(ctx, "y"), bv);
+    Z3_ast t = x;
+    for (unsigned i = 0; i < depth; ++i) {
+        Z3_ast c = Z3_mk_unsigned_int(ctx, 2 * i + 1, bv);
+        Z3_ast z = Z3_mk_unsigned_int(ctx, 0, bv);
+        // (t | 0) and (t & t) are simplified away, the rest is kept.
+        Z3_ast u = Z3_mk_bvand(ctx, Z3_mk_bvor(ctx, t, z), t);
+        t = Z3_mk_bvxor(ctx, Z3_mk_bvadd(ctx, u, c), Z3_mk_bvand(ctx, u, y));
+    }
+    return t;
+}
+
+static void simplify_all(Z3_context ctx, Z3_ast t, Z3_sort bv, unsigned n, Z3_params p, Z3_ast* results) {
+    Z3_ast z = Z3_mk_const(ctx, Z3_mk_string_symbol(ctx, "z"), bv);
+    for (unsigned k = 0; k < n; ++k) {
+        Z3_ast f = Z3_mk_eq(ctx, Z3_mk_bvadd(ctx, t, Z3_mk_unsigned_int(ctx, k, bv)), z);
+        results[k] = Z3_simplify_ex(ctx, f, p);
+    }
+}
+
+static void tst_simplify_cache(unsigned depth, unsigned n) {
+    Z3_config cfg = Z3_mk_config();
+    Z3_context ctx = Z3_mk_context(cfg);
+    Z3_del_config(cfg);
+    Z3_sort bv = Z3_mk_bv_sort(ctx, 32);
+    Z3_ast t = mk_shared_term(ctx, bv, depth);
+    Z3_ast* r1 = new Z3_ast[n];
+    Z3_ast* r2 = new Z3_ast[n];
+
+    Z3_params p1 = Z3_mk_params(ctx);
+    Z3_params_inc_ref(ctx, p1);
+    stopwatch sw;
+    sw.start();
+    simplify_all(ctx, t, bv, n, p1, r1);
+    sw.stop();
+    double t1 = sw.get_seconds();
+
+    Z3_params p2 = Z3_mk_params(ctx);
+    Z3_params_inc_ref(ctx, p2);
+    Z3_params_set_bool(ctx, p2, Z3_mk_string_symbol(ctx, "persistent_cache"), true);
+    sw.reset();
+    sw.start();
+    simplify_all(ctx, t, bv, n, p2, r2);
+    sw.stop();
+    double t2 = sw.get_seconds();
+    Z3_stats st = Z3_simplify_get_statistics(ctx);
+    Z3_stats_inc_ref(ctx, st);
+    unsigned hits = get_stat(ctx, st, "simplify cache hits");
+    unsigned misses = get_stat(ctx, st, "simplify cache misses");
+    std::cout << "depth: " << depth << " calls: " << n
+              << " time: " << t1 << " persistent: " << t2
+              << " hits: " << hits << " misses: " << misses << std::endl;
+    for (unsigned k = 0; k < n; ++k) {
+        ENSURE(r1[k] == r2[k]);
+    }
+    ENSURE(n <= 1 || hits > 0);
+    Z3_stats_dec_ref(ctx, st);
+
+    // a small bound flushes the cache after every call.
+    Z3_params_set_uint(ctx, p2, Z3_mk_string_symbol(ctx, "persistent_cache_max_size"), 10);
+    simplify_all(ctx, t, bv, n, p2, r2);
+    st = Z3_simplify_get_statistics(ctx);
+    Z3_stats_inc_ref(ctx, st);
+    unsigned flushes = get_stat(ctx, st, "simplify cache flushes");
+    std::cout << "flushes: " << flushes << "\n";
+    ENSURE(flushes >= n);
+    for (unsigned k = 0; k < n; ++k) {
+        ENSURE(r1[k] == r2[k]);
+    }
+    Z3_stats_dec_ref(ctx, st);
+
+    Z3_params_dec_ref(ctx, p1);
+    Z3_params_dec_ref(ctx, p2);
+    delete[] r1;
+    delete[] r2;
+    Z3_del_context(ctx);
+}
+
+void tst_simplify_cache() {
+    tst_simplify_cache(10, 1);
+    tst_simplify_cache(20, 10);
+    tst_simplify_cache(200, 100);
+}
@@ -0,0 +1,120 @@
+/*++
+Copyright (c) 2017 Microsoft Corporation
+
+Module Name:
+
+    solve_components.cpp
+
+Abstract:
+
+    Goals made of independent bit-vector factoring problems are
+    solved by the smt tactic directly and by splitting them into
+    components that are solved in parallel. The combined model has
+    to satisfy every formula, and one unsatisfiable component makes
+    the goal unsatisfiable.
+
+--*/
+
+#include "tactic/core/solve_components_tactic.h"
+#include "smt/tactic/smt_tactic.h"
+#include "tactic/tactic.h"
+#include "ast/reg_decl_plugins.h"
+#include "ast/bv_decl_plugin.h"
+#include "model/model.h"
+#include "util/stopwatch.h"
+#include "util/statistics.h"
+#include <sstream>
+
+static unsigned get_stat(statistics const& st, char const* key) {
+    for (unsigned i = 0; i < st.size(); ++i) {
+        if (st.is_uint(i) && strcmp(st.get_key(i), key) == 0) {
+            return st.get_uint_value(i);
+        }
+    }
+    return 0;
+}
+
+static expr* mk_var(ast_manager& m, char const* prefix, unsigned i, sort* s) {
+    std::stringstream strm;
+    strm << prefix << i;
+    return m.mk_const(symbol(strm.str().c_str()), s);
+}
+
+// x_i * y_i = p * q over num_bits bit-vectors with 1 < x_i <= y_i.
+static void mk_factor(ast_manager& m, unsigned i, unsigned num_bits, unsigned p, unsigned q, expr_ref_vector& fmls) {
+    bv_util bv(m);
+    sort* s = bv.mk_sort(num_bits);
+    expr* x = mk_var(m, "x", i, s);
+    expr* y = mk_var(m, "y", i, s);
+    fmls.push_back(m.mk_eq(bv.mk_bv_mul(x, y), bv.mk_numeral(rational(p) * rational(q), num_bits)));
+    fmls.push_back(m.mk_not(bv.mk_ule(x, bv.mk_numeral(1, num_bits))));
+    fmls.push_back(bv.mk_ule(x, y));
+    // no overflow
+    fmls.push_back(bv.mk_ule(x, bv.mk_numeral(1u << (num_bits / 2), num_bits)));
+}
+
+static lbool run_tactic(ast_manager& m, tactic* t, expr_ref_vector const& fmls, char const* name) {
+    tactic_ref tr = t;
+    goal_ref g = alloc(goal, m, true, false);
+    for (unsigned i = 0; i < fmls.size(); ++i) {
+        g->assert_expr(fmls[i]);
+    }
+    goal_ref_buffer result;
+    model_converter_ref mc;
+    proof_converter_ref pc;
+    expr_dependency_ref core(m);
+    stopwatch sw;
+    sw.start();
+    (*tr)(g, result, mc, pc, core);
+    sw.stop();
+    statistics st;
+    tr->collect_statistics(st);
+    lbool r = l_undef;
+    if (is_decided_sat(result)) r = l_true;
+    if (is_decided_unsat(result)) r = l_false;
+    std::cout << name << " " << r
+              << " components: " << get_stat(st, "components")
+              << " max size: " << get_stat(st, "components max size")
+              << " time: " << sw.get_seconds() << "\n";
+    if (r == l_true) {
+        ENSURE(mc);
+        model_ref mdl;
+        (*mc)(mdl, 0);
+        expr_ref val(m);
+        for (unsigned i = 0; i < fmls.size(); ++i) {
+            ENSURE(mdl->eval(fmls[i], val, true) && m.is_true(val));
+        }
+    }
+    return r;
+}
+
+static void tst_components(unsigned num_comps, unsigned num_bits, bool with_unsat) {
+    ast_manager m;
+    reg_decl_plugins(m);
+    bv_util bv(m);
+    expr_ref_vector fmls(m);
+    unsigned primes[8] = { 65521, 65519, 65497, 65479, 65449, 65447, 65437, 65423 };
+    for (unsigned i = 0; i < num_comps; ++i) {
+        mk_factor(m, i, num_bits, primes[i % 8], primes[(i + 3) % 8], fmls);
+    }
+    if (with_unsat) {
+        expr* z = mk_var(m, "z", 0, bv.mk_sort(num_bits));
+        fmls.push_back(bv.mk_ule(bv.mk_numeral(3, num_bits), z));
+        fmls.push_back(bv.mk_ule(z, bv.mk_numeral(2, num_bits)));
+    }
+    std::cout << "components: " << num_comps << " bits: " << num_bits << " unsat: " << with_unsat << "\n";
+    lbool r1 = run_tactic(m, mk_smt_tactic(), fmls, "smt           ");
+    lbool r2 = run_tactic(m, mk_smt_components_tactic(m), fmls, "smt-components");
+    params_ref p;
+    p.set_uint("max_groups", 2);
+    lbool r3 = run_tactic(m, mk_solve_components_tactic(m, mk_smt_tactic(), p), fmls, "2 groups      ");
+    ENSURE(r1 == (with_unsat ? l_false : l_true));
+    ENSURE(r1 == r2 && r1 == r3);
+}
+
+void tst_solve_components() {
+    tst_components(1, 32, false);
+    tst_components(4, 32, false);
+    tst_components(8, 32, false);
+    tst_components(4, 32, true);
+}
@@ -0,0 +1,258 @@
+/*++
+Copyright (c) 2017 Microsoft Corporation
+
+Module Name:
+
+    solver_cube.cpp
+
+Abstract:
+
+    Cube generation by lookahead in the SAT core and the SMT context.
+    The cubes have to cover the search space, and checking every cube
+    as an assumption has to agree with checking the assertions.
+
+--*/
+
+#include "sat/sat_solver/inc_sat_solver.h"
+#include "smt/smt_solver.h"
+#include "ast/reg_decl_plugins.h"
+#include "ast/bv_decl_plugin.h"
+#include "ast/arith_decl_plugin.h"
+#include "ast/ast_util.h"
+#include "util/stopwatch.h"
+#include "util/statistics.h"
+#include "api/z3.h"
+#include <sstream>
+
+static unsigned get_stat(statistics const& st, char const* key) {
+    unsigned r = 0;
+    for (unsigned i = 0; i < st.size(); ++i) {
+        if (st.is_uint(i) && strcmp(st.get_key(i), key) == 0) {
+            r += st.get_uint_value(i);
+        }
+    }
+    return r;
+}
+
+static expr_ref mk_bool(ast_manager& m, char const* prefix, unsigned i) {
+    std::stringstream strm;
+    strm << prefix << i;
+    return expr_ref(m.mk_const(symbol(strm.str().c_str()), m.mk_bool_sort()), m);
+}
+
+static ref<solver> mk_solver(ast_manager& m, bool use_sat) {
+    params_ref p;
+    if (use_sat) {
+        return ref<solver>(mk_inc_sat_solver(m, p));
+    }
+    return ref<solver>(mk_smt_solver(m, p, symbol::null));
+}
+
+static lbool check(ast_manager& m, bool use_sat, expr_ref_vector const& fmls, expr* cube, double& time) {
+    ref<solver> s = mk_solver(m, use_sat);
+    for (unsigned i = 0; i < fmls.size(); ++i) {
+        s->assert_expr(fmls[i]);
+    }
+    stopwatch sw;
+    sw.start();
+    lbool r;
+    if (cube) {
+        // track the cube by a Boolean constant, as assumptions of the SMT context are propositional.
+        expr_ref a(m.mk_const(symbol("cube!track"), m.mk_bool_sort()), m);
+        s->assert_expr(m.mk_implies(a, cube));
+        expr* asms[1] = { a };
+        r = s->check_sat(1, asms);
+    }
+    else {
+        r = s->check_sat(0, 0);
+    }
+    sw.stop();
+    time = sw.get_seconds();
+    return r;
+}
+
+// The cubes of fmls at the given depth have to cover all models of fmls,
+// and fmls is satisfiable if and only if one of the cubes is.
+static void tst_cubes(ast_manager& m, bool use_sat, expr_ref_vector const& fmls, unsigned depth, char const* name, lbool expected) {
+    ref<solver> s = mk_solver(m, use_sat);
+    for (unsigned i = 0; i < fmls.size(); ++i) {
+        s->assert_expr(fmls[i]);
+    }
+    vector<expr_ref_vector> cubes;
+    stopwatch sw;
+    sw.start();
+    lbool r = s->cube(depth, cubes);
+    sw.stop();
+    statistics st;
+    s->collect_statistics(st);
+    ENSURE(cubes.size() <= (1u << depth));
+    ENSURE((r == l_false) == cubes.empty());
+
+    // the cubes are exhaustive.
+    expr_ref_vector disj(m);
+    for (unsigned i = 0; i < cubes.size(); ++i) {
+        disj.push_back(mk_and(cubes[i]));
+    }
+    expr_ref_vector fmls2(fmls);
+    fmls2.push_back(m.mk_not(mk_or(disj)));
+    double time = 0;
+    ENSURE(check(m, use_sat, fmls2, 0, time) == l_false);
+
+    // solving the cubes independently gives the status of the assertions.
+    lbool r0 = check(m, use_sat, fmls, 0, time);
+    ENSURE(expected == l_undef || r0 == expected);
+    double total = 0, max_time = 0;
+    unsigned num_sat = 0;
+    for (unsigned i = 0; i < disj.size(); ++i) {
+        double t = 0;
+        lbool ri = check(m, use_sat, fmls, disj.get(i), t);
+        ENSURE(ri != l_undef);
+        if (ri == l_true) ++num_sat;
+        total += t;
+        max_time = std::max(max_time, t);
+    }
+    ENSURE((r0 == l_true) == (num_sat > 0));
+    ENSURE(r != l_false || r0 == l_false);
+    std::cout << name << (use_sat ? " sat" : " smt") << " depth: " << depth << " " << r0
+              << " cubes: " << cubes.size() << " sat cubes: " << num_sat
+              << " failed literals: " << get_stat(st, "lookahead failed literals")
+              << " cube time: " << sw.get_seconds()
+              << " solve time: " << time << " cubes total: " << total << " max: " << max_time << std::endl;
+}
+
+static void mk_random_3sat(ast_manager& m, unsigned num_vars, unsigned num_clauses, unsigned seed, expr_ref_vector& fmls) {
+    random_gen rand(seed);
+    expr_ref_vector vars(m);
+    for (unsigned i = 0; i < num_vars; ++i) {
+        vars.push_back(mk_bool(m, "p", i));
+    }
+    for (unsigned i = 0; i < num_clauses; ++i) {
+        expr_ref_vector lits(m);
+        for (unsigned j = 0; j < 3; ++j) {
+            expr* v = vars.get(rand(num_vars));
+            lits.push_back(rand(2) ? v : m.mk_not(v));
+        }
+        fmls.push_back(mk_or(lits));
+    }
+}
+
+// n + 1 pigeons in n holes.
+static void mk_php(ast_manager& m, unsigned n, expr_ref_vector& fmls) {
+    vector<expr_ref_vector> p;
+    for (unsigned i = 0; i <= n; ++i) {
+        p.push_back(expr_ref_vector(m));
+        for (unsigned j = 0; j < n; ++j) {
+            p[i].push_back(mk_bool(m, "h", i * n + j));
+        }
+        fmls.push_back(mk_or(p[i]));
+    }
+    for (unsigned j = 0; j < n; ++j) {
+        for (unsigned i = 0; i <= n; ++i) {
+            for (unsigned k = i + 1; k <= n; ++k) {
+                fmls.push_back(m.mk_not(m.mk_and(p[i].get(j), p[k].get(j))));
+            }
+        }
+    }
+}
+
+static void tst_random_3sat(unsigned num_vars, unsigned depth) {
+    for (unsigned seed = 0; seed < 4; ++seed) {
+        ast_manager m;
+        reg_decl_plugins(m);
+        expr_ref_vector fmls(m);
+        mk_random_3sat(m, num_vars, (num_vars * 426) / 100, seed, fmls);
+        tst_cubes(m, true, fmls, depth, "3sat", l_undef);
+        tst_cubes(m, false, fmls, depth, "3sat", l_undef);
+    }
+}
+
+static void tst_php(unsigned n, unsigned depth) {
+    ast_manager m;
+    reg_decl_plugins(m);
+    expr_ref_vector fmls(m);
+    mk_php(m, n, fmls);
+    tst_cubes(m, true, fmls, depth, "php", l_false);
+    tst_cubes(m, false, fmls, depth, "php", l_false);
+}
+
+// x * y = c with 1 < x <= y; cubes are over the bits of x and y.
+static void tst_factor(unsigned num_bits, unsigned c, unsigned depth) {
+    ast_manager m;
+    reg_decl_plugins(m);
+    bv_util bv(m);
+    sort* s = bv.mk_sort(num_bits);
+    expr_ref x(m.mk_const(symbol("x"), s), m), y(m.mk_const(symbol("y"), s), m);
+    expr_ref_vector fmls(m);
+    fmls.push_back(m.mk_eq(bv.mk_bv_mul(x, y), bv.mk_numeral(c, num_bits)));
+    fmls.push_back(m.mk_not(bv.mk_ule(x, bv.mk_numeral(1, num_bits))));
+    fmls.push_back(bv.mk_ule(x, y));
+    fmls.push_back(bv.mk_ule(y, bv.mk_numeral((1u << (num_bits / 2)) - 1, num_bits)));
+    tst_cubes(m, true, fmls, depth, "factor", l_undef);
+}
+
+// a job shop like disjunctive scheduling problem over integers.
+static void tst_schedule(unsigned num_jobs, unsigned horizon, unsigned depth) {
+    ast_manager m;
+    reg_decl_plugins(m);
+    arith_util a(m);
+    expr_ref_vector fmls(m), start(m);
+    unsigned dur = 3;
+    for (unsigned i = 0; i < num_jobs; ++i) {
+        std::stringstream strm;
+        strm << "s" << i;
+        start.push_back(m.mk_const(symbol(strm.str().c_str()), a.mk_int()));
+        fmls.push_back(a.mk_ge(start.get(i), a.mk_int(0)));
+        fmls.push_back(a.mk_le(a.mk_add(start.get(i), a.mk_int(dur)), a.mk_int(horizon)));
+    }
+    for (unsigned i = 0; i < num_jobs; ++i) {
+        for (unsigned j = i + 1; j < num_jobs; ++j) {
+            fmls.push_back(m.mk_or(a.mk_le(a.mk_add(start.get(i), a.mk_int(dur)), start.get(j)),
+                                   a.mk_le(a.mk_add(start.get(j), a.mk_int(dur)), start.get(i))));
+        }
+    }
+    tst_cubes(m, false, fmls, depth, "schedule", num_jobs * dur <= horizon ? l_true : l_false);
+}
+
+static void tst_api() {
+    Z3_config cfg = Z3_mk_config();
+    Z3_context ctx = Z3_mk_context(cfg);
+    Z3_del_config(cfg);
+    Z3_solver s = Z3_mk_solver(ctx);
+    Z3_solver_inc_ref(ctx, s);
+    Z3_sort bs = Z3_mk_bool_sort(ctx);
+    Z3_ast p = Z3_mk_const(ctx, Z3_mk_string_symbol(ctx, "p"), bs);
+    Z3_ast q = Z3_mk_const(ctx, Z3_mk_string_symbol(ctx, "q"), bs);
+    Z3_ast pq[2] = { p, q };
+    Z3_solver_assert(ctx, s, Z3_mk_or(ctx, 2, pq));
+    Z3_ast_vector cubes = Z3_solver_cube(ctx, s, 2);
+    Z3_ast_vector_inc_ref(ctx, cubes);
+    unsigned sz = Z3_ast_vector_size(ctx, cubes);
+    std::cout << "api cubes: " << sz << std::endl;
+    ENSURE(sz >= 1);
+    for (unsigned i = 0; i < sz; ++i) {
+        Z3_solver_push(ctx, s);
+        Z3_solver_assert(ctx, s, Z3_ast_vector_get(ctx, cubes, i));
+        ENSURE(Z3_solver_check(ctx, s) == Z3_L_TRUE);
+        Z3_solver_pop(ctx, s, 1);
+    }
+    Z3_ast_vector_dec_ref(ctx, cubes);
+    Z3_solver_assert(ctx, s, Z3_mk_not(ctx, p));
+    Z3_solver_assert(ctx, s, Z3_mk_not(ctx, q));
+    cubes = Z3_solver_cube(ctx, s, 2);
+    Z3_ast_vector_inc_ref(ctx, cubes);
+    ENSURE(Z3_ast_vector_size(ctx, cubes) == 0);
+    Z3_ast_vector_dec_ref(ctx, cubes);
+    Z3_solver_dec_ref(ctx, s);
+    Z3_del_context(ctx);
+}
+
+void tst_solver_cube() {
+    tst_api();
+    tst_php(4, 12);
+    tst_php(7, 3);
+    tst_random_3sat(40, 3);
+    tst_random_3sat(120, 5);
+    tst_factor(20, 1009 * 997, 4);
+    tst_schedule(6, 18, 4);
+    tst_schedule(6, 17, 4);
+}
@@ -10,6 +10,7 @@ Copyright (c) 2015 Microsoft Corporation
 #include "ast/ast_pp.h"
 #include "ast/reg_decl_plugins.h"
 #include "util/sorting_network.h"
+#include "util/totalizer.h"
 #include "smt/smt_kernel.h"
 #include "model/model_smt2_pp.h"
 #include "smt/params/smt_params.h"
@@ -422,7 +423,50 @@ static void test_at_most1() {
     std::cout << ext.m_clauses << "\n";
 }
 
+static void test_totalizer(unsigned n, unsigned k) {
+    ast_manager m;
+    reg_decl_plugins(m);
+    ast_ext2 ext(m);
+    expr_ref_vector in(m);
+    for (unsigned i = 0; i < n; ++i) {
+        in.push_back(m.mk_fresh_const("a",m.mk_bool_sort()));
+    }
+    smt_params fp;
+    smt::kernel solver(m, fp);
+    totalizer<ast_ext2> tot(ext);
+    // add the inputs in two batches to exercise merging.
+    tot.add(n / 2, in.c_ptr());
+    tot.add(n - n / 2, in.c_ptr() + n / 2);
+    ENSURE(tot.size() == n);
+    for (unsigned b = k; b > 0; --b) {
+        // tighten the bound on the same counter.
+        expr_ref bound(tot.at_most(b - 1), m);
+        for (unsigned i = 0; i < ext.m_clauses.size(); ++i) {
+            solver.assert_expr(ext.m_clauses[i].get());
+        }
+        ext.m_clauses.reset();
+        solver.assert_expr(bound);
+        solver.push();
+        for (unsigned i = 0; i + 1 < b; ++i) {
+            solver.assert_expr(in[i].get());
+        }
+        ENSURE(l_true == solver.check());
+        solver.assert_expr(in[b - 1].get());
+        ENSURE(l_false == solver.check());
+        solver.pop(1);
+    }
+    // extending the bound adds outputs to the existing counter.
+    unsigned num_clauses = tot.num_clauses();
+    tot.at_least(n);
+    ENSURE(n <= k || tot.num_clauses() > num_clauses);
+}
+
 void tst_sorting_network() {
+    for (unsigned n = 1; n < 12; ++n) {
+        for (unsigned k = 1; k <= n; ++k) {
+            test_totalizer(n, k);
+        }
+    }
     for (unsigned i = 1; i < 17; ++i) {
         test_at_most_1(i, true);
         test_at_most_1(i, false);
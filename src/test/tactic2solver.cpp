@@ -0,0 +1,112 @@
+/*++
+Copyright (c) 2017 Microsoft Corporation
+
+Module Name:
+
+    tactic2solver.cpp
+
+Abstract:
+
+    Incremental preprocessing in tactic2solver on a bounded model 
+    checking loop: each step is asserted once and each depth is 
+    checked under a push/pop scope. Results are compared against 
+    tactic2solver, which re-runs the tactic on every check.
+
+--*/
+
+#include "solver/tactic2solver.h"
+#include "solver/solver.h"
+#include "sat/sat_solver/inc_sat_solver.h"
+#include "tactic/smtlogics/qfbv_tactic.h"
+#include "tactic/tactical.h"
+#include "tactic/core/simplify_tactic.h"
+#include "tactic/core/propagate_values_tactic.h"
+#include "ast/reg_decl_plugins.h"
+#include "ast/bv_decl_plugin.h"
+#include "model/model.h"
+#include "util/stopwatch.h"
+#include <sstream>
+
+static expr* mk_var(ast_manager& m, char const* prefix, unsigned i, sort* s) {
+    std::stringstream strm;
+    strm << prefix << i;
+    return m.mk_const(symbol(strm.str().c_str()), s);
+}
+
+// 16-bit counter x that moves by +3 or -1 in each step.
+static void bmc(ast_manager& m, solver& s, unsigned depth, svector<lbool>& results, char const* name) {
+    bv_util bv(m);
+    sort* bv_s = bv.mk_sort(16);
+    expr_ref_vector xs(m), fmls(m);
+    xs.push_back(mk_var(m, "x", 0, bv_s));
+    fmls.push_back(m.mk_eq(xs.back(), bv.mk_numeral(0, 16)));
+    s.assert_expr(fmls.back());
+    stopwatch sw;
+    sw.start();
+    for (unsigned i = 0; i < depth; ++i) {
+        expr* x = xs.get(i);
+        expr* b = mk_var(m, "b", i, m.mk_bool_sort());
+        xs.push_back(mk_var(m, "x", i + 1, bv_s));
+        // terms that cancel out, so that preprocessing does some work.
+        expr_ref_vector zs(m);
+        for (unsigned j = 0; j < 20; ++j) {
+            expr* y = mk_var(m, "y", j, bv_s);
+            expr* c = bv.mk_numeral(j + 1, 16);
+            zs.push_back(bv.mk_bv_sub(bv.mk_bv_mul(c, y), bv.mk_bv_mul(y, c)));
+        }
+        expr_ref step(m);
+        step = m.mk_eq(xs.back(), bv.mk_bv_add(m.mk_ite(b, bv.mk_bv_add(x, bv.mk_numeral(3, 16)), bv.mk_bv_sub(x, bv.mk_numeral(1, 16))), 
+                                              m.mk_app(bv.get_fid(), OP_BADD, zs.size(), zs.c_ptr())));
+        fmls.push_back(step);
+        s.assert_expr(step);
+        s.push();
+        // x_{i+1} can be 3*(i+1) - 4, but not exceed 3*(i+1).
+        int n = static_cast<int>(i + 1) * 3;
+        expr_ref goal(m);
+        if (i % 2 == 0) 
+            goal = m.mk_eq(xs.back(), bv.mk_numeral(rational(n - 4), 16));
+        else 
+            goal = m.mk_not(bv.mk_sle(xs.back(), bv.mk_numeral(rational(n), 16)));
+        s.assert_expr(goal);
+        lbool r = s.check_sat(0, 0);
+        results.push_back(r);
+        if (r == l_true) {
+            model_ref mdl;
+            s.get_model(mdl);
+            expr_ref val(m);
+            ENSURE(mdl->eval(goal, val, true) && m.is_true(val));
+            for (unsigned j = 0; j < fmls.size(); ++j) {
+                ENSURE(mdl->eval(fmls.get(j), val, true) && m.is_true(val));
+            }
+        }
+        s.pop(1);
+    }
+    sw.stop();
+    std::cout << name << " depth: " << depth << " time: " << sw.get_seconds() << "\n";
+}
+
+void tst_tactic2solver() {
+    ast_manager m;
+    reg_decl_plugins(m);
+    params_ref p;
+    unsigned depth = 60;
+    svector<lbool> r1, r2;
+    {
+        tactic_ref pre = and_then(mk_simplify_tactic(m, p), mk_propagate_values_tactic(m, p));
+        ref<solver> s = mk_incremental_tactic2solver(m, pre.get(), mk_inc_sat_solver(m, p), p);
+        bmc(m, *s, depth, r1, "incremental  ");
+        statistics st;
+        s->collect_statistics(st);
+        st.display(std::cout);
+    }
+    {
+        tactic_ref t = mk_qfbv_tactic(m, p);
+        ref<solver> s = mk_tactic2solver(m, t.get(), p);
+        bmc(m, *s, depth, r2, "tactic2solver");
+    }
+    ENSURE(r1.size() == r2.size());
+    for (unsigned i = 0; i < r1.size(); ++i) {
+        ENSURE(r1[i] == r2[i]);
+        ENSURE(r1[i] == (i % 2 == 0 ? l_true : l_false));
+    }
+}
@@ -156,8 +156,12 @@ protected:
     
     void expand_table() {
         unsigned curr_cellar  = (m_capacity - m_slots);
-        unsigned new_slots    = m_slots * 2;
-        unsigned new_cellar   = curr_cellar * 2;
+        expand_table(m_slots * 2, curr_cellar * 2);
+    }
+
+    void expand_table(unsigned new_slots, unsigned new_cellar) {
+        SASSERT(is_power_of_two(new_slots));
+        SASSERT(new_slots >= m_slots);
         while (true) {
             unsigned new_capacity = new_slots + new_cellar;
             cell * new_table      = alloc_table(new_capacity);
@@ -269,6 +273,22 @@ public:
     unsigned used_slots() const {
         return m_used_slots;
     }
+
+    /**
+       \brief Grow the table in one step to the size it would reach by
+       repeated expansion when n elements are inserted.
+    */
+    void reserve(unsigned n) {
+        if (n <= m_slots)
+            return;
+        unsigned new_slots  = m_slots;
+        unsigned new_cellar = m_capacity - m_slots;
+        while (new_slots < n) {
+            new_slots  *= 2;
+            new_cellar *= 2;
+        }
+        expand_table(new_slots, new_cellar);
+    }
     
     void insert(T const & d) {
         if (!has_free_cells())
@@ -49,6 +49,48 @@ class mpq_manager : public mpz_manager<SYNCH> {
     mpq m_lt_tmp1;
     mpq m_lt_tmp2;
 
+    static int64 i64(mpz const & a) { return static_cast<int64>(a.m_val); }
+
+    static unsigned abs32(int64 v) { return static_cast<unsigned>(v < 0 ? -v : v); }
+
+    /**
+       \brief c <- an/ad + bn/bd for normalized operands whose numerators 
+       and denominators fit in 32 bits. As in Knuth 4.5.1 only gcds of
+       32-bit values are needed to produce a normalized result, and 
+       the intermediate products fit in 64 bits.
+    */
+    void small_add(int64 an, int64 ad, int64 bn, int64 bd, mpq & c) {
+        int64 g = u_gcd(static_cast<unsigned>(ad), static_cast<unsigned>(bd));
+        int64 n = an * (bd / g) + bn * (ad / g);
+        int64 d = (ad / g) * bd;
+        if (n == 0) {
+            reset(c);
+            return;
+        }
+        if (g != 1) {
+            int64 g2 = u_gcd(static_cast<unsigned>((n < 0 ? -n : n) % g), static_cast<unsigned>(g));
+            n /= g2;
+            d /= g2;
+        }
+        set(c.m_num, n);
+        set(c.m_den, d);
+    }
+
+    /**
+       \brief c <- an/ad * bn/bd for normalized small operands.
+       Common factors are removed before multiplying.
+    */
+    void small_mul(int64 an, int64 ad, int64 bn, int64 bd, mpq & c) {
+        if (an == 0 || bn == 0) {
+            reset(c);
+            return;
+        }
+        int64 g1 = u_gcd(abs32(an), static_cast<unsigned>(bd));
+        int64 g2 = u_gcd(abs32(bn), static_cast<unsigned>(ad));
+        set(c.m_num, (an / g1) * (bn / g2));
+        set(c.m_den, (ad / g2) * (bd / g1));
+    }
+
     void reset_denominator(mpq & a) {
         del(a.m_den);
         a.m_den.m_val = 1;
@@ -77,7 +119,10 @@ class mpq_manager : public mpz_manager<SYNCH> {
 
     void rat_add(mpq const & a, mpq const & b, mpq & c) {
         STRACE("rat_mpq", tout << "[mpq] " << to_string(a) << " + " << to_string(b) << " == ";); 
-        if (SYNCH) {
+        if (is_small(a) && is_small(b)) {
+            small_add(i64(a.m_num), i64(a.m_den), i64(b.m_num), i64(b.m_den), c);
+        }
+        else if (SYNCH) {
             mpz tmp1, tmp2;
             mul(a.m_num, b.m_den, tmp1);
             mul(b.m_num, a.m_den, tmp2);
@@ -99,7 +144,13 @@ class mpq_manager : public mpz_manager<SYNCH> {
 
     void rat_add(mpq const & a, mpz const & b, mpq & c) {
         STRACE("rat_mpq", tout << "[mpq] " << to_string(a) << " + " << to_string(b) << " == ";); 
-        if (SYNCH) {
+        if (is_small(a) && is_small(b)) {
+            // a is normalized, so a + b is too.
+            int64 d = i64(a.m_den);
+            set(c.m_num, i64(a.m_num) + i64(b) * d);
+            set(c.m_den, d);
+        }
+        else if (SYNCH) {
             mpz tmp1;
             mul(b, a.m_den, tmp1);
             set(c.m_den, a.m_den);
@@ -118,7 +169,10 @@ class mpq_manager : public mpz_manager<SYNCH> {
 
     void rat_sub(mpq const & a, mpq const & b, mpq & c) {
         STRACE("rat_mpq", tout << "[mpq] " << to_string(a) << " - " << to_string(b) << " == ";); 
-        if (SYNCH) {
+        if (is_small(a) && is_small(b)) {
+            small_add(i64(a.m_num), i64(a.m_den), -i64(b.m_num), i64(b.m_den), c);
+        }
+        else if (SYNCH) {
             mpz tmp1, tmp2;
             mul(a.m_num, b.m_den, tmp1);
             mul(b.m_num, a.m_den, tmp2);
@@ -140,17 +194,27 @@ class mpq_manager : public mpz_manager<SYNCH> {
 
     void rat_mul(mpq const & a, mpq const & b, mpq & c) {
         STRACE("rat_mpq", tout << "[mpq] " << to_string(a) << " * " << to_string(b) << " == ";); 
-        mul(a.m_num, b.m_num, c.m_num);
-        mul(a.m_den, b.m_den, c.m_den);
-        normalize(c);
+        if (is_small(a) && is_small(b)) {
+            small_mul(i64(a.m_num), i64(a.m_den), i64(b.m_num), i64(b.m_den), c);
+        }
+        else {
+            mul(a.m_num, b.m_num, c.m_num);
+            mul(a.m_den, b.m_den, c.m_den);
+            normalize(c);
+        }
         STRACE("rat_mpq", tout << to_string(c) << "\n";);
     }
 
     void rat_mul(mpz const & a, mpq const & b, mpq & c) {
         STRACE("rat_mpq", tout << "[mpq] " << to_string(a) << " * " << to_string(b) << " == ";); 
-        mul(a, b.m_num, c.m_num);
-        set(c.m_den, b.m_den);
-        normalize(c);
+        if (is_small(a) && is_small(b)) {
+            small_mul(i64(a), 1, i64(b.m_num), i64(b.m_den), c);
+        }
+        else {
+            mul(a, b.m_num, c.m_num);
+            set(c.m_den, b.m_den);
+            normalize(c);
+        }
         STRACE("rat_mpq", tout << to_string(c) << "\n";);
     }
 
@@ -573,6 +637,8 @@ public:
     bool lt(mpq const & a, mpq const & b) {
         if (is_int(a) && is_int(b))
             return lt(a.m_num, b.m_num);
+        else if (is_small(a) && is_small(b))
+            return i64(a.m_num) * i64(b.m_den) < i64(b.m_num) * i64(a.m_den);
         else
             return rat_lt(a, b);
     }
@@ -47,37 +47,14 @@ Revision History:
 
 template<typename T>
 static T gcd_core(T u, T v) {
-    if (u == 0) 
-        return v;
-    if (v == 0)
-        return u;
-
-    int k;
-    
-    for (k = 0; ((u | v) & 1) == 0; ++k) {
-        u >>= 1;
-        v >>= 1;
-    }
- 
-    while ((u & 1) == 0)
-        u >>= 1;
- 
-    do {
-        while ((v & 1) == 0) 
-            v >>= 1;
- 
-        if (u < v) {
-            v -= u;
-        } 
-        else {
-            T diff = u - v;
-            u = v;
-            v = diff;
-        }
-        v >>= 1;
-    } while (v != 0);
- 
-    return u << k;
+    // Euclid's algorithm is faster than the binary method
+    // on processors with hardware division.
+    while (v != 0) {
+        T r = u % v;
+        u = v;
+        v = r;
+    }
+    return u;
 }
 
 unsigned u_gcd(unsigned u, unsigned v) { return gcd_core(u, v); }
@@ -388,7 +388,10 @@ public:
 
     // d <- a + b*c
     void addmul(mpz const & a, mpz const & b, mpz const & c, mpz & d) {
-        if (is_one(b)) {
+        if (is_small(a) && is_small(b) && is_small(c)) {
+            set_i64(d, i64(a) + i64(b) * i64(c));
+        }
+        else if (is_one(b)) {
             add(a, c, d);
         }
         else if (is_minus_one(b)) {
@@ -405,7 +408,10 @@ public:
 
     // d <- a - b*c
     void submul(mpz const & a, mpz const & b, mpz const & c, mpz & d) {
-        if (is_one(b)) {
+        if (is_small(a) && is_small(b) && is_small(c)) {
+            set_i64(d, i64(a) - i64(b) * i64(c));
+        }
+        else if (is_one(b)) {
             sub(a, c, d);
         }
         else if (is_minus_one(b)) {
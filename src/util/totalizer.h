@@ -0,0 +1,150 @@
+/*++
+Copyright (c) 2017 Microsoft Corporation
+
+Module Name:
+
+    totalizer.h
+
+Abstract:
+
+    Incremental totalizer encoding of cardinality constraints.
+
+    The inputs are arranged in a balanced binary tree. Every node
+    has outputs o_1, .., o_k where o_j is implied by at least j of
+    the inputs below the node being true. Outputs are only created
+    up to the largest bound requested so far, and requesting a larger
+    bound extends the existing counters instead of re-encoding them.
+    Inputs can be added after the fact; they are merged with the
+    existing tree under a new root.
+
+    The encoding is one-sided: it suffices for at-most constraints
+    (and for detecting that at least j inputs are true), which is
+    what upper bounds in MaxSAT require.
+
+    The interface for literals is the same as for psort_nw in
+    sorting_network.h.
+
+Notes:
+
+--*/
+
+#ifndef TOTALIZER_H_
+#define TOTALIZER_H_
+
+#include "util/vector.h"
+#include "util/memory_manager.h"
+
+template<class psort_expr>
+class totalizer {
+    typedef typename psort_expr::literal literal;
+    typedef typename psort_expr::literal_vector literal_vector;
+
+    struct node {
+        unsigned       m_size;     // number of inputs below the node
+        node*          m_left;
+        node*          m_right;
+        literal_vector m_outputs;  // m_outputs[j] is implied by j+1 true inputs
+        node(literal lit): m_size(1), m_left(0), m_right(0) { m_outputs.push_back(lit); }
+        node(node* l, node* r): m_size(l->m_size + r->m_size), m_left(l), m_right(r) {}
+        bool is_leaf() const { return m_left == 0; }
+    };
+
+    psort_expr&      ctx;
+    ptr_vector<node> m_nodes;
+    node*            m_root;
+    unsigned         m_bound;
+    unsigned         m_num_clauses;
+
+    node* mk_node(node* n) {
+        m_nodes.push_back(n);
+        return n;
+    }
+
+    node* mk_tree(unsigned n, literal const* xs) {
+        SASSERT(n > 0);
+        if (n == 1) {
+            return mk_node(alloc(node, xs[0]));
+        }
+        unsigned h = n / 2;
+        return mk_node(alloc(node, mk_tree(h, xs), mk_tree(n - h, xs + h)));
+    }
+
+    // outputs of n with the convention o_0 = true, o_j = false for j > size.
+    literal output(node* n, unsigned j) {
+        if (j == 0) return ctx.mk_true();
+        if (j > n->m_size) return ctx.mk_false();
+        SASSERT(j <= n->m_outputs.size());
+        return n->m_outputs[j-1];
+    }
+
+    void encode(node* n, unsigned k) {
+        k = std::min(k, n->m_size);
+        if (n->is_leaf() || n->m_outputs.size() >= k) {
+            return;
+        }
+        node* l = n->m_left;
+        node* r = n->m_right;
+        encode(l, k);
+        encode(r, k);
+        // (l_a & r_b) => o_{a+b} for a + b = j
+        for (unsigned j = n->m_outputs.size() + 1; j <= k; ++j) {
+            literal o = ctx.fresh();
+            n->m_outputs.push_back(o);
+            for (unsigned a = 0; a <= j && a <= l->m_size; ++a) {
+                unsigned b = j - a;
+                if (b > r->m_size) continue;
+                literal_vector lits;
+                if (a > 0) lits.push_back(ctx.mk_not(output(l, a)));
+                if (b > 0) lits.push_back(ctx.mk_not(output(r, b)));
+                lits.push_back(o);
+                ctx.mk_clause(lits.size(), lits.c_ptr());
+                ++m_num_clauses;
+            }
+        }
+    }
+
+public:
+    totalizer(psort_expr& c): ctx(c), m_root(0), m_bound(0), m_num_clauses(0) {}
+
+    ~totalizer() {
+        for (unsigned i = 0; i < m_nodes.size(); ++i) {
+            dealloc(m_nodes[i]);
+        }
+    }
+
+    /**
+       \brief add inputs to the counter. The existing encoding is retained.
+    */
+    void add(unsigned n, literal const* xs) {
+        if (n == 0) return;
+        node* t = mk_tree(n, xs);
+        m_root = m_root ? mk_node(alloc(node, m_root, t)) : t;
+        encode(m_root, m_bound);
+    }
+
+    /**
+       \brief literal that is implied by at least k of the inputs being true.
+       Extends the encoding if k exceeds the bounds requested so far.
+    */
+    literal at_least(unsigned k) {
+        if (k == 0) return ctx.mk_true();
+        if (!m_root || k > m_root->m_size) return ctx.mk_false();
+        if (k > m_bound) {
+            m_bound = k;
+            encode(m_root, m_bound);
+        }
+        return output(m_root, k);
+    }
+
+    /**
+       \brief literal that implies that at most k of the inputs are true.
+    */
+    literal at_most(unsigned k) {
+        return ctx.mk_not(at_least(k + 1));
+    }
+
+    unsigned size() const { return m_root ? m_root->m_size : 0; }
+    unsigned num_clauses() const { return m_num_clauses; }
+};
+
+#endif